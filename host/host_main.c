@@ -0,0 +1,176 @@
+/*
+ * host_main.c - Headless native runner for RPMegaFighter
+ *
+ * Runs the unmodified game loop against the emulated RIA in ria_host.c,
+ * feeding gamepad 0 from a scripted input timeline, and reports how long
+ * each frame of game logic took on the host CPU. Useful for quickly
+ * comparing algorithmic changes and for catching crashes or hangs with
+ * sanitizers, without hardware.
+ *
+ * Usage: rpmegafighter_host [-n frames] [-w warmup] [-s script] [-m music] [-q]
+ *
+ *   -n frames  Exit after this many frames (default 3600)
+ *   -w warmup  Frames excluded from the timing report (default 90)
+ *   -s script  Input timeline file, one line per change:
+ *                  FRAME DPAD STICKS BTN0 BTN1      (hex, except FRAME)
+ *              Each line holds until the next. '#' starts a comment.
+ *   -m music   PSG register log streamed as the title music
+ *              (default ROM:title.psg, which only exists on the device)
+ *   -q         Discard the game's printf output
+ */
+
+#define _POSIX_C_SOURCE 199309L   // clock_gettime under strict C11
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <rp6502.h>
+
+#include "ria_host.h"
+#include "input_script.h"
+#include "constants.h"
+#include "music.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define DEFAULT_FRAMES  3600
+#define DEFAULT_WARMUP  90
+
+// ============================================================================
+// EXTERNAL DEPENDENCIES
+// ============================================================================
+
+extern int rpmegafighter_main(void);
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static uint32_t frame_limit = DEFAULT_FRAMES;
+static uint32_t warmup = DEFAULT_WARMUP;
+static uint32_t frames_run = 0;
+
+static uint32_t *frame_us = NULL;
+static struct timespec last_ts;
+static struct timespec start_ts;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+static uint32_t elapsed_us(const struct timespec *a, const struct timespec *b)
+{
+    int64_t ns = (int64_t)(b->tv_sec - a->tv_sec) * 1000000000LL
+               + (b->tv_nsec - a->tv_nsec);
+    return (uint32_t)(ns / 1000);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void report(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    uint32_t n = frames_run > warmup ? frames_run - warmup : 0;
+    fprintf(stderr, "\n=== rpmegafighter_host ===\n");
+    fprintf(stderr, "frames run:      %u (warmup %u)\n", frames_run, warmup);
+    fprintf(stderr, "wall time:       %.3f s\n", elapsed_us(&start_ts, &now) / 1e6);
+    if (n == 0) {
+        return;
+    }
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        total += frame_us[warmup + i];
+    }
+    qsort(&frame_us[warmup], n, sizeof(uint32_t), cmp_u32);
+
+    fprintf(stderr, "measured frames: %u\n", n);
+    fprintf(stderr, "frame avg:       %.2f us\n", (double)total / n);
+    fprintf(stderr, "frame min:       %u us\n", frame_us[warmup]);
+    fprintf(stderr, "frame p50:       %u us\n", frame_us[warmup + n / 2]);
+    fprintf(stderr, "frame p99:       %u us\n", frame_us[warmup + (n * 99) / 100]);
+    fprintf(stderr, "frame max:       %u us\n", frame_us[warmup + n - 1]);
+    fprintf(stderr, "frames/sec:      %.1f\n", total ? n * 1e6 / total : 0.0);
+}
+
+/**
+ * Runs at every emulated vsync: time the frame that just ended, then
+ * latch the next gamepad state into XRAM where handle_input() reads it.
+ */
+static void on_frame(uint8_t frame)
+{
+    (void)frame;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    frame_us[frames_run] = elapsed_us(&last_ts, &now);
+    last_ts = now;
+
+    if (++frames_run >= frame_limit) {
+        exit(0);
+    }
+
+    input_script_pad(frames_run, &xram[GAMEPAD_INPUT]);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-n frames] [-w warmup] [-s script] [-m music] [-q]\n", prog);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *script_path = NULL;
+    int quiet = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            frame_limit = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+            warmup = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            script_path = argv[++i];
+        } else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+            title_music_stream = argv[++i];
+        } else if (!strcmp(argv[i], "-q")) {
+            quiet = 1;
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    if (frame_limit == 0) {
+        usage(argv[0]);
+    }
+    if (script_path && !input_script_load(script_path)) {
+        fprintf(stderr, "cannot read script %s\n", script_path);
+        return 1;
+    }
+    if (quiet && !freopen("/dev/null", "w", stdout)) {
+        return 1;
+    }
+
+    frame_us = calloc(frame_limit, sizeof(uint32_t));
+    if (!frame_us) {
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start_ts);
+    last_ts = start_ts;
+    ria_host_frame_hook = on_frame;
+    atexit(report);
+
+    return rpmegafighter_main();
+}
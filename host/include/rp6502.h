@@ -0,0 +1,172 @@
+/*
+ * rp6502.h - Host stand-in for the llvm-mos RP6502 platform header
+ *
+ * Lets the game sources build natively on Linux for the headless
+ * runner (see host/CMakeLists.txt). Only the parts of the RIA the game
+ * actually touches are emulated:
+ *
+ *   RIA.addr0/step0/rw0, RIA.addr1/step1/rw1  - XRAM portals over a 64 KB array
+ *   RIA.vsync                                 - advances one frame per wait loop
+ *   RIA.irq                                   - bit 0 calls ria_host_irq_vector each vsync
+ *   xregn(), read_xram(), xram0_struct_set()  - as on the real hardware
+ *   VIA timer 1                               - 8 MHz down-counter from the host clock
+ *
+ * The rw/vsync registers have side effects on access, which plain C
+ * struct members cannot express, so those member names are macros that
+ * expand to a portal index / function call inside the RIA struct.
+ */
+
+#ifndef RP6502_H
+#define RP6502_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <unistd.h>     // The SDK header declares close()/read()/write() itself
+
+// ============================================================================
+// RIA REGISTERS
+// ============================================================================
+
+#define XRAM_SIZE 0x10000
+
+struct __RIA {
+    uint8_t *xram;              // Backing store for rw0/rw1
+    int8_t step0;               // Signed 8-bit like the hardware register
+    uint16_t addr0;
+    int8_t step1;
+    uint16_t addr1;
+    uint8_t irq;                // Bit 0: vsync interrupt enabled
+    uint8_t (*vsync_read)(void);
+};
+
+extern struct __RIA RIA;
+extern uint8_t xram[XRAM_SIZE];
+
+// Host-only: the IRQ handler, which the hardware fetches from RAM at $FFFE
+extern void (*ria_host_irq_vector)(void);
+
+// Portal access: returns the current address then applies the step
+uint16_t ria_host_port0(void);
+uint16_t ria_host_port1(void);
+
+#define rw0   xram[ria_host_port0()]
+#define rw1   xram[ria_host_port1()]
+#define vsync vsync_read()
+
+// ============================================================================
+// VIA REGISTERS
+// ============================================================================
+
+struct __6522 {
+    uint8_t prb;
+    uint8_t pra;
+    uint8_t ddrb;
+    uint8_t ddra;
+    uint8_t *t1;                // Live counter, see t1_lo/t1_hi
+    uint8_t t1l_lo;
+    uint8_t t1l_hi;
+    uint8_t t2_lo;
+    uint8_t t2_hi;
+    uint8_t sr;
+    uint8_t acr;
+    uint8_t pcr;
+    uint8_t ifr;
+    uint8_t ier;
+};
+
+extern struct __6522 VIA;
+
+// Refreshes the timer 1 counter bytes and returns the index of one of them
+uint8_t ria_host_via_t1(uint8_t hi);
+
+#define t1_lo t1[ria_host_via_t1(0)]
+#define t1_hi t1[ria_host_via_t1(1)]
+
+// ============================================================================
+// OS CALLS
+// ============================================================================
+
+int xregn(char device, char channel, unsigned char address, unsigned count, ...);
+int read_xram(unsigned buf, unsigned count, int fildes);
+int write_xram(unsigned buf, unsigned count, int fildes);
+
+// ============================================================================
+// VGA CONFIG STRUCTURES
+// ============================================================================
+
+typedef struct {
+    bool x_wrap;
+    bool y_wrap;
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    int16_t width_chars;
+    int16_t height_chars;
+    uint16_t xram_data_ptr;
+    uint16_t xram_palette_ptr;
+    uint16_t xram_font_ptr;
+} vga_mode1_config_t;
+
+typedef struct {
+    bool x_wrap;
+    bool y_wrap;
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    int16_t width_tiles;
+    int16_t height_tiles;
+    uint16_t xram_data_ptr;
+    uint16_t xram_palette_ptr;
+    uint16_t xram_tile_ptr;
+} vga_mode2_config_t;
+
+typedef struct {
+    bool x_wrap;
+    bool y_wrap;
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    int16_t width_px;
+    int16_t height_px;
+    uint16_t xram_data_ptr;
+    uint16_t xram_palette_ptr;
+} vga_mode3_config_t;
+
+typedef struct {
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    uint16_t xram_sprite_ptr;
+    uint8_t log_size;
+    bool has_opacity_metadata;
+} vga_mode4_sprite_t;
+
+typedef struct {
+    int16_t transform[6];
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    uint16_t xram_sprite_ptr;
+    uint8_t log_size;
+    bool has_opacity_metadata;
+} vga_mode4_asprite_t;
+
+// Same expansion as the SDK macro (including the missing do/while)
+#define xram0_struct_set(addr, type, member, val)                   \
+    RIA.addr0 = (unsigned)offsetof(type, member) + (unsigned)(addr); \
+    switch (sizeof(((type *)0)->member))                            \
+    {                                                               \
+    case 1:                                                         \
+        RIA.rw0 = (uint8_t)(val);                                   \
+        break;                                                      \
+    case 2:                                                         \
+        RIA.step0 = 1;                                              \
+        RIA.rw0 = (val) & 0xff;                                     \
+        RIA.rw0 = ((val) >> 8) & 0xff;                              \
+        break;                                                      \
+    case 4:                                                         \
+        RIA.step0 = 1;                                              \
+        RIA.rw0 = (unsigned long)(val) & 0xff;                      \
+        RIA.rw0 = ((unsigned long)(val) >> 8) & 0xff;               \
+        RIA.rw0 = ((unsigned long)(val) >> 16) & 0xff;              \
+        RIA.rw0 = ((unsigned long)(val) >> 24) & 0xff;              \
+        break;                                                      \
+    }
+
+#endif // RP6502_H
@@ -0,0 +1,116 @@
+/*
+ * input_script.c - Scripted gamepad input shared by the host tools
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "input_script.h"
+#include "constants.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define MAX_SCRIPT 1024
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct {
+    uint32_t frame;
+    uint8_t dpad;
+    uint8_t sticks;
+    uint8_t btn0;
+    uint8_t btn1;
+} script_step_t;
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static script_step_t script[MAX_SCRIPT];
+static int script_len = 0;
+static int script_pos = 0;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+/**
+ * Built-in timeline: wait on the title screen, press START, then keep
+ * rotating and thrusting while firing so every subsystem gets exercised.
+ */
+static void default_pad(uint32_t frame, script_step_t *pad)
+{
+    memset(pad, 0, sizeof(*pad));
+
+    if (frame >= 60 && frame < 64) {
+        pad->btn1 = GP_BTN_START;
+    } else if (frame >= 90) {
+        pad->sticks = GP_LSTICK_LEFT;
+        if (((frame / 120) & 3) != 3) {
+            pad->sticks |= GP_LSTICK_UP;
+        }
+        if ((frame & 4) == 0) {
+            pad->btn0 = GP_BTN_A | GP_BTN_X;
+        }
+    }
+}
+
+static void scripted_pad(uint32_t frame, script_step_t *pad)
+{
+    while (script_pos + 1 < script_len && script[script_pos + 1].frame <= frame) {
+        script_pos++;
+    }
+    if (script[script_pos].frame > frame) {
+        memset(pad, 0, sizeof(*pad));
+    } else {
+        *pad = script[script_pos];
+    }
+}
+
+int input_script_load(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        return 0;
+    }
+
+    char line[128];
+    while (fgets(line, sizeof(line), fp) && script_len < MAX_SCRIPT) {
+        unsigned long f;
+        unsigned d, s, b0, b1;
+        char *hash = strchr(line, '#');
+        if (hash) {
+            *hash = '\0';
+        }
+        if (sscanf(line, "%lu %x %x %x %x", &f, &d, &s, &b0, &b1) == 5) {
+            script[script_len].frame = (uint32_t)f;
+            script[script_len].dpad = (uint8_t)d;
+            script[script_len].sticks = (uint8_t)s;
+            script[script_len].btn0 = (uint8_t)b0;
+            script[script_len].btn1 = (uint8_t)b1;
+            script_len++;
+        }
+    }
+    fclose(fp);
+    return 1;
+}
+
+void input_script_pad(uint32_t frame, uint8_t *gamepad_data)
+{
+    script_step_t pad;
+    if (script_len > 0) {
+        scripted_pad(frame, &pad);
+    } else {
+        default_pad(frame, &pad);
+    }
+
+    memset(gamepad_data, 0, GAMEPAD_COUNT * GAMEPAD_DATA_SIZE);
+    gamepad_data[0] = pad.dpad | GP_CONNECTED;
+    gamepad_data[1] = pad.sticks;
+    gamepad_data[2] = pad.btn0;
+    gamepad_data[3] = pad.btn1;
+}
@@ -0,0 +1,21 @@
+#ifndef INPUT_SCRIPT_H
+#define INPUT_SCRIPT_H
+
+#include <stdint.h>
+
+/**
+ * Load an input timeline: one "FRAME DPAD STICKS BTN0 BTN1" line per
+ * change (hex bytes, decimal frame), '#' starts a comment. Without a
+ * loaded script the built-in play pattern is used.
+ * @return 0 if the file could not be read
+ */
+int input_script_load(const char *path);
+
+/**
+ * Write gamepad 0's state for the given frame into a GAMEPAD_INPUT-style
+ * buffer of GAMEPAD_COUNT * GAMEPAD_DATA_SIZE bytes; other pads read as
+ * disconnected.
+ */
+void input_script_pad(uint32_t frame, uint8_t *gamepad_data);
+
+#endif // INPUT_SCRIPT_H
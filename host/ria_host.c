@@ -0,0 +1,122 @@
+/*
+ * ria_host.c - Host emulation of the RIA registers used by the game
+ *
+ * XRAM is a flat 64 KB array. VGA and PSG register writes made through
+ * xregn() are accepted and ignored: the host build only measures game
+ * logic, nothing is displayed or played.
+ *
+ * VIA timer 1 counts down at 8 MHz off the host monotonic clock so the
+ * ENABLE_PROFILER code path can run here too; it is not cycle accurate.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <rp6502.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ria_host.h"
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+uint8_t xram[XRAM_SIZE];
+
+static uint8_t vsync_counter = 0;
+static uint8_t vsync_reads = 0;     // Reads of the current vsync value
+
+static uint8_t ria_host_vsync(void);
+
+struct __RIA RIA = {
+    .xram = xram,
+    .step0 = 1,
+    .step1 = 1,
+    .vsync_read = ria_host_vsync,
+};
+
+static uint8_t via_t1[2];
+
+struct __6522 VIA = {
+    .t1 = via_t1,
+};
+
+void (*ria_host_frame_hook)(uint8_t frame) = 0;
+void (*ria_host_irq_vector)(void) = 0;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+uint16_t ria_host_port0(void)
+{
+    uint16_t a = RIA.addr0;
+    RIA.addr0 = (uint16_t)(a + RIA.step0);
+    return a;
+}
+
+uint16_t ria_host_port1(void)
+{
+    uint16_t a = RIA.addr1;
+    RIA.addr1 = (uint16_t)(a + RIA.step1);
+    return a;
+}
+
+uint8_t ria_host_via_t1(uint8_t hi)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ticks = (uint64_t)ts.tv_sec * 8000000u + (uint64_t)ts.tv_nsec / 125u;
+    uint16_t count = (uint16_t)~ticks;
+    via_t1[0] = (uint8_t)count;
+    via_t1[1] = (uint8_t)(count >> 8);
+    return hi;
+}
+
+/**
+ * Every wait loop in the game reads vsync at least twice per frame
+ * (compare, then latch or re-test), so a value that has already been
+ * read twice is treated as stale and the next frame begins. The vsync
+ * interrupt, if enabled, runs at that point.
+ */
+static uint8_t ria_host_vsync(void)
+{
+    if (vsync_reads >= 2) {
+        vsync_counter++;
+        vsync_reads = 0;
+        if ((RIA.irq & 1) && ria_host_irq_vector) {
+            ria_host_irq_vector();
+        }
+        if (ria_host_frame_hook) {
+            ria_host_frame_hook(vsync_counter);
+        }
+    }
+    vsync_reads++;
+    return vsync_counter;
+}
+
+int xregn(char device, char channel, unsigned char address, unsigned count, ...)
+{
+    (void)device;
+    (void)channel;
+    (void)address;
+    (void)count;
+    return 0;
+}
+
+int read_xram(unsigned buf, unsigned count, int fildes)
+{
+    if (buf + count > XRAM_SIZE) {
+        count = XRAM_SIZE - buf;
+    }
+    return (int)read(fildes, &xram[buf], count);
+}
+
+int write_xram(unsigned buf, unsigned count, int fildes)
+{
+    if (buf + count > XRAM_SIZE) {
+        count = XRAM_SIZE - buf;
+    }
+    return (int)write(fildes, &xram[buf], count);
+}
@@ -0,0 +1,12 @@
+#ifndef RIA_HOST_H
+#define RIA_HOST_H
+
+#include <stdint.h>
+
+/**
+ * Called once each time the emulated vsync counter advances, before
+ * the new value is returned to the game.
+ */
+extern void (*ria_host_frame_hook)(uint8_t frame);
+
+#endif // RIA_HOST_H
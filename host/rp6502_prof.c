@@ -0,0 +1,900 @@
+/*
+ * rp6502_prof.c - Cycle-counting profiler for packaged RP6502 ROMs
+ *
+ * Loads the .rp6502 ROM written by rp6502_executable() into a W65C02
+ * core with a stubbed RIA, runs it for a fixed number of vsyncs with
+ * scripted gamepad input, and attributes every cycle to a function using
+ * the symbols in the llvm-mos ELF that was linked alongside the ROM.
+ *
+ * Usage: rp6502_prof [options] rpmegafighter.rp6502 rpmegafighter.elf
+ *
+ *   -n frames  Vsyncs to profile after warmup (default 600)
+ *   -w warmup  Vsyncs to run before profiling (default 90)
+ *   -s script  Input timeline, same format as rpmegafighter_host -s
+ *   -p khz     PHI2 clock in kHz (default 8000)
+ *   -t top     Rows in the flat profile (default 40, 0 = all)
+ *   -c file    Also write the flat profile as CSV
+ *   -v         Echo the program's console output to stderr
+ *
+ * Cycles the game spends polling RIA.vsync are split out as
+ * "<vsync wait>", so the per-frame numbers are work, not wall time.
+ * The RIA is answered instantly: OS calls cost only the cycles of the
+ * 6502 side of the call.
+ */
+
+#define _POSIX_C_SOURCE 200809L   // getopt under strict C11
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "w65c02.h"
+#include "input_script.h"
+#include "constants.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define DEFAULT_FRAMES  600
+#define DEFAULT_WARMUP  90
+#define DEFAULT_PHI2    8000
+#define DEFAULT_TOP     40
+
+#define XSTACK_SIZE     512
+#define MAX_ASSETS      64
+#define MAX_FILES       8
+#define MAX_DEPTH       256
+
+// Reads of RIA.vsync closer together than this are a wait loop
+#define POLL_GAP        64
+
+// RIA register window
+#define RIA_READY   0xFFE0
+#define RIA_TX      0xFFE1
+#define RIA_RX      0xFFE2
+#define RIA_VSYNC   0xFFE3
+#define RIA_RW0     0xFFE4
+#define RIA_STEP0   0xFFE5
+#define RIA_ADDR0   0xFFE6
+#define RIA_RW1     0xFFE8
+#define RIA_STEP1   0xFFE9
+#define RIA_ADDR1   0xFFEA
+#define RIA_XSTACK  0xFFEC
+#define RIA_ERRNO   0xFFED
+#define RIA_OP      0xFFEF
+#define RIA_IRQ     0xFFF0
+#define RIA_SPIN    0xFFF1
+#define RIA_A       0xFFF4
+#define RIA_X       0xFFF6
+#define RIA_SREG    0xFFF8
+#define RIA_END     0xFFFA
+
+// RIA OS operations
+#define RIA_OP_ZXSTACK      0x00
+#define RIA_OP_XREG         0x01
+#define RIA_OP_PHI2         0x02
+#define RIA_OP_CODEPAGE     0x03
+#define RIA_OP_LRAND        0x04
+#define RIA_OP_STDIN_OPT    0x05
+#define RIA_OP_CLOCK        0x0F
+#define RIA_OP_OPEN         0x14
+#define RIA_OP_CLOSE        0x15
+#define RIA_OP_READ_XSTACK  0x16
+#define RIA_OP_READ_XRAM    0x17
+#define RIA_OP_WRITE_XSTACK 0x18
+#define RIA_OP_WRITE_XRAM   0x19
+#define RIA_OP_EXIT         0xFF
+
+#define RIA_ENOENT          2
+#define RIA_EBADF           9
+#define RIA_EINVAL          22
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct {
+    char name[64];
+    uint8_t *data;
+    uint32_t len;
+} rom_asset_t;
+
+typedef struct {
+    rom_asset_t *asset;         // NULL when the slot is free
+    uint32_t pos;
+} open_file_t;
+
+typedef struct {
+    char *name;
+    uint16_t addr;
+    uint16_t size;
+} symbol_t;
+
+typedef struct {
+    int sym;
+    uint64_t entry;
+} call_frame_t;
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static uint8_t ram[0x10000];
+static uint8_t xram[0x10000];
+static w65c02_t cpu;
+
+// RIA
+static uint8_t xstack[XSTACK_SIZE + 1];
+static unsigned xstack_ptr = XSTACK_SIZE;
+static int8_t step0 = 1, step1 = 1;
+static uint16_t addr0, addr1;
+static uint8_t reg_a, reg_x, reg_errno;
+static uint16_t reg_sreg;
+static uint8_t vsync;
+static uint8_t irq_enable;
+static uint32_t lrand_state = 0x12345678;
+static int gamepad_addr = -1;
+static bool echo_console = false;
+static bool program_exited = false;
+static uint8_t unknown_ops[256];
+
+static rom_asset_t assets[MAX_ASSETS];
+static int asset_count = 0;
+static open_file_t files[MAX_FILES];
+
+// Symbols; two pseudo entries follow the real ones
+static symbol_t *syms = NULL;
+static int sym_count = 0;
+static int sym_unknown, sym_ria;
+static int16_t sym_of[0x10000];
+
+// Profile
+static unsigned phi2_khz = DEFAULT_PHI2;
+static int64_t *self_cycles, *incl_cycles, *frame_cycles, *max_frame;
+static uint64_t *calls;
+static uint16_t *active;
+static call_frame_t shadow[MAX_DEPTH];
+static int depth = 0;
+static int cur_sym = 0;
+
+static uint64_t idle_cycles = 0;
+static uint64_t last_vsync_read = 0;
+static uint8_t last_vsync_value = 0;
+static uint64_t iter_start = 0;
+static uint64_t iter_start_idle = 0;
+static uint32_t *iter_work = NULL;
+static uint32_t iter_count = 0, iter_cap = 0;
+static bool profiling = false;
+static bool iter_open = false;           // An iteration started while profiling
+
+// ============================================================================
+// ROM LOADING
+// ============================================================================
+
+static uint32_t parse_hex(const char *s)
+{
+    if (*s == '$') s++;
+    return (uint32_t)strtoul(s, NULL, 16);
+}
+
+static bool load_chunks(const uint8_t *data, uint32_t len)
+{
+    uint32_t i = 0;
+    while (i < len) {
+        const uint8_t *nl = memchr(data + i, '\n', len - i);
+        if (!nl) return false;
+        char header[64] = {0};
+        size_t hlen = (size_t)(nl - (data + i));
+        if (hlen >= sizeof(header)) return false;
+        memcpy(header, data + i, hlen);
+        i += (uint32_t)hlen + 1;
+
+        char a[24], l[24], c[24];
+        if (sscanf(header, "%23s %23s %23s", a, l, c) != 3) return false;
+        uint32_t addr = parse_hex(a);
+        uint32_t n = parse_hex(l);
+        if (i + n > len || addr + n > 0x20000) return false;
+        for (uint32_t k = 0; k < n; k++) {
+            uint32_t dst = addr + k;
+            if (dst < 0x10000) ram[dst] = data[i + k];
+            else xram[dst - 0x10000] = data[i + k];
+        }
+        i += n;
+    }
+    return true;
+}
+
+static bool load_rom(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return false;
+
+    char line[256];
+    if (!fgets(line, sizeof(line), fp) || strncmp(line, "#!RP6502", 8) != 0) {
+        fclose(fp);
+        return false;
+    }
+    while (fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') break;
+        if (strncmp(line, "#>", 2) != 0) break;
+
+        char len_s[24], crc_s[24], name[64] = {0};
+        int fields = sscanf(line + 2, "%23s %23s %63s", len_s, crc_s, name);
+        if (fields < 2) break;
+        uint32_t len = parse_hex(len_s);
+        uint8_t *data = malloc(len ? len : 1);
+        if (!data || fread(data, 1, len, fp) != len) {
+            free(data);
+            fclose(fp);
+            return false;
+        }
+        if (fields == 2) {
+            bool ok = load_chunks(data, len);
+            free(data);
+            if (!ok) {
+                fclose(fp);
+                return false;
+            }
+        } else if (asset_count < MAX_ASSETS) {
+            snprintf(assets[asset_count].name, sizeof(assets[0].name), "%s", name);
+            assets[asset_count].data = data;
+            assets[asset_count].len = len;
+            asset_count++;
+        } else {
+            free(data);
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+// ============================================================================
+// ELF SYMBOLS
+// ============================================================================
+
+static uint16_t le16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t le32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static int cmp_sym_addr(const void *a, const void *b)
+{
+    const symbol_t *x = a, *y = b;
+    return (x->addr > y->addr) - (x->addr < y->addr);
+}
+
+static bool load_symbols(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return false;
+    fseek(fp, 0, SEEK_END);
+    long fsize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    uint8_t *elf = malloc((size_t)fsize);
+    if (!elf || fread(elf, 1, (size_t)fsize, fp) != (size_t)fsize) {
+        fclose(fp);
+        free(elf);
+        return false;
+    }
+    fclose(fp);
+
+    if (fsize < 52 || memcmp(elf, "\x7f" "ELF", 4) != 0 || elf[4] != 1 || elf[5] != 1) {
+        free(elf);
+        return false;
+    }
+    uint32_t shoff = le32(elf + 0x20);
+    uint16_t shentsize = le16(elf + 0x2E);
+    uint16_t shnum = le16(elf + 0x30);
+
+    syms = calloc(1, sizeof(symbol_t));
+    for (uint16_t s = 0; s < shnum; s++) {
+        const uint8_t *sh = elf + shoff + (uint32_t)s * shentsize;
+        if (le32(sh + 4) != 2) continue;                // SHT_SYMTAB
+        const uint8_t *strsh = elf + shoff + le32(sh + 24) * shentsize;
+        const char *strtab = (const char *)elf + le32(strsh + 16);
+        uint32_t off = le32(sh + 16);
+        uint32_t count = le32(sh + 20) / 16;
+
+        syms = realloc(syms, (count + 2) * sizeof(symbol_t));
+        for (uint32_t i = 0; i < count; i++) {
+            const uint8_t *st = elf + off + i * 16;
+            uint8_t type = st[12] & 0x0F;
+            uint16_t shndx = le16(st + 14);
+            const char *name = strtab + le32(st);
+            if (!*name || shndx == 0 || shndx >= 0xFF00) continue;
+            if (type != 2) {                            // STT_FUNC
+                const uint8_t *owner = elf + shoff + (uint32_t)shndx * shentsize;
+                if (type != 0 || !(le32(owner + 8) & 0x4)) continue; // NOTYPE in SHF_EXECINSTR
+                if (name[0] == '.' || name[0] == '$') continue;
+            }
+            syms[sym_count].name = strdup(name);
+            syms[sym_count].addr = (uint16_t)le32(st + 4);
+            syms[sym_count].size = (uint16_t)le32(st + 8);
+            sym_count++;
+        }
+        break;
+    }
+    free(elf);
+
+    qsort(syms, sym_count, sizeof(symbol_t), cmp_sym_addr);
+    for (uint32_t a = 0; a < 0x10000; a++) sym_of[a] = -1;
+    for (int i = 0; i < sym_count; i++) {
+        for (uint32_t a = syms[i].addr; a < (uint32_t)syms[i].addr + syms[i].size && a < 0x10000; a++) {
+            sym_of[a] = (int16_t)i;
+        }
+    }
+    for (int i = 0; i < sym_count; i++) {
+        if (syms[i].size) continue;
+        uint32_t end = (i + 1 < sym_count) ? syms[i + 1].addr : RIA_READY;
+        for (uint32_t a = syms[i].addr; a < end && sym_of[a] < 0; a++) {
+            sym_of[a] = (int16_t)i;
+        }
+    }
+
+    sym_unknown = sym_count;
+    sym_ria = sym_count + 1;
+    syms[sym_unknown].name = "<unknown>";
+    syms[sym_ria].name = "<ria>";
+    for (uint32_t a = 0; a < 0x10000; a++) {
+        if (a >= RIA_READY) sym_of[a] = (int16_t)sym_ria;
+        else if (sym_of[a] < 0) sym_of[a] = (int16_t)sym_unknown;
+    }
+    return sym_count > 0;
+}
+
+// ============================================================================
+// RIA
+// ============================================================================
+
+static uint8_t xstack_pop8(void)
+{
+    return xstack_ptr < XSTACK_SIZE ? xstack[xstack_ptr++] : 0;
+}
+
+static uint16_t xstack_pop16(void)
+{
+    uint16_t lo = xstack_pop8();
+    return lo | (uint16_t)(xstack_pop8() << 8);
+}
+
+static void ria_return(int32_t value)
+{
+    reg_a = (uint8_t)value;
+    reg_x = (uint8_t)(value >> 8);
+    reg_sreg = (uint16_t)((uint32_t)value >> 16);
+}
+
+static void ria_fail(uint8_t err)
+{
+    reg_errno = err;
+    ria_return(-1);
+}
+
+/**
+ * Apply an xregn() call. Values were pushed device, channel, address,
+ * then each 16-bit value high byte first, so they read back downward
+ * from the top of the xstack. Only input mappings matter here.
+ */
+static void ria_xreg(void)
+{
+    if (XSTACK_SIZE - xstack_ptr < 5) {
+        ria_fail(RIA_EINVAL);
+        return;
+    }
+    uint8_t device = xstack[XSTACK_SIZE - 1];
+    uint8_t channel = xstack[XSTACK_SIZE - 2];
+    uint8_t address = xstack[XSTACK_SIZE - 3];
+    uint16_t value = (uint16_t)((xstack[XSTACK_SIZE - 4] << 8) | xstack[XSTACK_SIZE - 5]);
+    if (device == 0 && channel == 0 && address == 2) {
+        gamepad_addr = value;
+    }
+    xstack_ptr = XSTACK_SIZE;
+    ria_return(0);
+}
+
+static void ria_open(void)
+{
+    xstack[XSTACK_SIZE] = 0;
+    const char *path = (const char *)&xstack[xstack_ptr];
+    xstack_ptr = XSTACK_SIZE;
+    if (strncmp(path, "ROM:", 4) == 0) {
+        for (int i = 0; i < asset_count; i++) {
+            if (strcmp(assets[i].name, path + 4) != 0) continue;
+            for (int fd = 3; fd < MAX_FILES; fd++) {
+                if (files[fd].asset) continue;
+                files[fd].asset = &assets[i];
+                files[fd].pos = 0;
+                ria_return(fd);
+                return;
+            }
+        }
+    }
+    ria_fail(RIA_ENOENT);
+}
+
+static open_file_t *ria_file(void)
+{
+    int fd = reg_a | (reg_x << 8);
+    if (fd < 3 || fd >= MAX_FILES || !files[fd].asset) return NULL;
+    return &files[fd];
+}
+
+static uint32_t ria_file_read(open_file_t *f, uint8_t *dst, uint32_t n)
+{
+    uint32_t left = f->asset->len - f->pos;
+    if (n > left) n = left;
+    memcpy(dst, f->asset->data + f->pos, n);
+    f->pos += n;
+    return n;
+}
+
+static void ria_op(uint8_t op)
+{
+    open_file_t *f;
+    uint16_t count, buf;
+    reg_errno = 0;
+
+    switch (op) {
+    case RIA_OP_ZXSTACK:
+        xstack_ptr = XSTACK_SIZE;
+        ria_return(0);
+        break;
+    case RIA_OP_XREG:
+        ria_xreg();
+        break;
+    case RIA_OP_PHI2:
+        ria_return(phi2_khz);
+        break;
+    case RIA_OP_CODEPAGE:
+        ria_return(437);
+        break;
+    case RIA_OP_LRAND:
+        lrand_state = lrand_state * 1103515245u + 12345u;
+        ria_return((int32_t)(lrand_state & 0x7FFFFFFF));
+        break;
+    case RIA_OP_STDIN_OPT:
+        xstack_ptr = XSTACK_SIZE;
+        ria_return(0);
+        break;
+    case RIA_OP_CLOCK:
+        ria_return((int32_t)(cpu.cycles / (phi2_khz * 10u)));
+        break;
+    case RIA_OP_OPEN:
+        ria_open();
+        break;
+    case RIA_OP_CLOSE:
+        f = ria_file();
+        if (f) {
+            f->asset = NULL;
+            ria_return(0);
+        } else {
+            ria_fail(RIA_EBADF);
+        }
+        break;
+    case RIA_OP_READ_XSTACK:
+        count = xstack_pop16();
+        xstack_ptr = XSTACK_SIZE;
+        f = ria_file();
+        if (!f) {
+            ria_fail(RIA_EBADF);
+            break;
+        }
+        if (count > XSTACK_SIZE) count = XSTACK_SIZE;
+        {
+            uint8_t tmp[XSTACK_SIZE];
+            count = (uint16_t)ria_file_read(f, tmp, count);
+            xstack_ptr = XSTACK_SIZE - count;
+            memcpy(&xstack[xstack_ptr], tmp, count);
+        }
+        ria_return(count);
+        break;
+    case RIA_OP_READ_XRAM:
+        count = xstack_pop16();
+        buf = xstack_pop16();
+        xstack_ptr = XSTACK_SIZE;
+        f = ria_file();
+        if (!f) {
+            ria_fail(RIA_EBADF);
+            break;
+        }
+        if ((uint32_t)buf + count > 0x10000) count = (uint16_t)(0x10000 - buf);
+        ria_return((int32_t)ria_file_read(f, &xram[buf], count));
+        break;
+    case RIA_OP_WRITE_XSTACK:
+        count = (uint16_t)(XSTACK_SIZE - xstack_ptr);
+        if (echo_console && (reg_a == 1 || reg_a == 2)) {
+            fwrite(&xstack[xstack_ptr], 1, count, stderr);
+        }
+        xstack_ptr = XSTACK_SIZE;
+        ria_return(count);
+        break;
+    case RIA_OP_WRITE_XRAM:
+        count = xstack_pop16();
+        xstack_ptr = XSTACK_SIZE;
+        ria_return(count);
+        break;
+    case RIA_OP_EXIT:
+        program_exited = true;
+        break;
+    default:
+        if (!unknown_ops[op]) {
+            unknown_ops[op] = 1;
+            fprintf(stderr, "rp6502_prof: unhandled RIA op $%02X\n", op);
+        }
+        xstack_ptr = XSTACK_SIZE;
+        ria_fail(RIA_EINVAL);
+        break;
+    }
+}
+
+/**
+ * Reads of RIA.vsync split wait-loop time out of the profile. A tight
+ * run of reads is polling; the run that ends with the value changing
+ * closes one loop iteration, whose work is everything but that polling.
+ */
+static void on_vsync_read(void)
+{
+    uint64_t now = cpu.cycles;
+    uint64_t gap = now - last_vsync_read;
+    if (gap < POLL_GAP && profiling) {
+        idle_cycles += gap;
+        self_cycles[cur_sym] -= (int64_t)gap;
+        frame_cycles[cur_sym] -= (int64_t)gap;
+    }
+    if (vsync != last_vsync_value) {
+        if (profiling && iter_open) {
+            if (iter_count == iter_cap) {
+                iter_cap = iter_cap ? iter_cap * 2 : 1024;
+                iter_work = realloc(iter_work, iter_cap * sizeof(uint32_t));
+            }
+            iter_work[iter_count++] = (uint32_t)((now - iter_start) - (idle_cycles - iter_start_idle));
+            for (int i = 0; i < sym_count + 2; i++) {
+                if (frame_cycles[i] > max_frame[i]) max_frame[i] = frame_cycles[i];
+                frame_cycles[i] = 0;
+            }
+        }
+        iter_start = now;
+        iter_start_idle = idle_cycles;
+        iter_open = profiling;
+    }
+    last_vsync_read = now;
+    last_vsync_value = vsync;
+}
+
+static uint8_t bus_read(void *ctx, uint16_t addr)
+{
+    (void)ctx;
+    if (addr < RIA_READY || addr >= RIA_END) {
+        return ram[addr];
+    }
+    uint8_t v;
+    switch (addr) {
+    case RIA_READY: return 0x80;                    // TX ready, no RX
+    case RIA_VSYNC: on_vsync_read(); return vsync;
+    case RIA_RW0:   v = xram[addr0]; addr0 = (uint16_t)(addr0 + step0); return v;
+    case RIA_STEP0: return (uint8_t)step0;
+    case RIA_ADDR0: return (uint8_t)addr0;
+    case RIA_ADDR0 + 1: return addr0 >> 8;
+    case RIA_RW1:   v = xram[addr1]; addr1 = (uint16_t)(addr1 + step1); return v;
+    case RIA_STEP1: return (uint8_t)step1;
+    case RIA_ADDR1: return (uint8_t)addr1;
+    case RIA_ADDR1 + 1: return addr1 >> 8;
+    case RIA_XSTACK: return xstack_pop8();
+    case RIA_ERRNO: return reg_errno;
+    case RIA_IRQ:   cpu.irq = false; return 0;
+    // ria_spin: BRA +0 / LDA #a / LDX #x / RTS, never busy
+    case RIA_SPIN:  return 0x80;
+    case RIA_SPIN + 1: return 0x00;
+    case RIA_SPIN + 2: return 0xA9;
+    case RIA_A:     return reg_a;
+    case RIA_A + 1: return 0xA2;
+    case RIA_X:     return reg_x;
+    case RIA_X + 1: return 0x60;
+    case RIA_SREG:  return (uint8_t)reg_sreg;
+    case RIA_SREG + 1: return reg_sreg >> 8;
+    default:        return 0;
+    }
+}
+
+static void bus_write(void *ctx, uint16_t addr, uint8_t val)
+{
+    (void)ctx;
+    if (addr < RIA_READY || addr >= RIA_END) {
+        ram[addr] = val;
+        return;
+    }
+    switch (addr) {
+    case RIA_TX:    if (echo_console) fputc(val, stderr); break;
+    case RIA_RW0:   xram[addr0] = val; addr0 = (uint16_t)(addr0 + step0); break;
+    case RIA_STEP0: step0 = (int8_t)val; break;
+    case RIA_ADDR0: addr0 = (addr0 & 0xFF00) | val; break;
+    case RIA_ADDR0 + 1: addr0 = (uint16_t)((addr0 & 0x00FF) | (val << 8)); break;
+    case RIA_RW1:   xram[addr1] = val; addr1 = (uint16_t)(addr1 + step1); break;
+    case RIA_STEP1: step1 = (int8_t)val; break;
+    case RIA_ADDR1: addr1 = (addr1 & 0xFF00) | val; break;
+    case RIA_ADDR1 + 1: addr1 = (uint16_t)((addr1 & 0x00FF) | (val << 8)); break;
+    case RIA_XSTACK: if (xstack_ptr) xstack[--xstack_ptr] = val; break;
+    case RIA_OP:    ria_op(val); break;
+    case RIA_IRQ:   irq_enable = val; break;
+    case RIA_A:     reg_a = val; break;
+    case RIA_X:     reg_x = val; break;
+    case RIA_SREG:  reg_sreg = (reg_sreg & 0xFF00) | val; break;
+    case RIA_SREG + 1: reg_sreg = (uint16_t)((reg_sreg & 0x00FF) | (val << 8)); break;
+    default: break;
+    }
+}
+
+// ============================================================================
+// PROFILE
+// ============================================================================
+
+static void reset_profile(void)
+{
+    size_t n = (size_t)sym_count + 2;
+    memset(self_cycles, 0, n * sizeof(int64_t));
+    memset(incl_cycles, 0, n * sizeof(int64_t));
+    memset(frame_cycles, 0, n * sizeof(int64_t));
+    memset(max_frame, 0, n * sizeof(int64_t));
+    memset(calls, 0, n * sizeof(uint64_t));
+    for (int i = 0; i < depth; i++) {
+        shadow[i].entry = cpu.cycles;
+    }
+    idle_cycles = 0;
+    iter_count = 0;
+    iter_open = false;
+    profiling = true;
+}
+
+static void enter(int sym)
+{
+    calls[sym]++;
+    if (depth < MAX_DEPTH) {
+        shadow[depth].sym = sym;
+        shadow[depth].entry = cpu.cycles;
+        depth++;
+        active[sym]++;
+    }
+}
+
+static void leave(void)
+{
+    if (depth == 0) return;
+    depth--;
+    int sym = shadow[depth].sym;
+    // Recursive calls only count once, at the outermost return
+    if (--active[sym] == 0) {
+        incl_cycles[sym] += (int64_t)(cpu.cycles - shadow[depth].entry);
+    }
+}
+
+static const int64_t *sort_key;
+
+static int cmp_by_key(const void *a, const void *b)
+{
+    int64_t x = sort_key[*(const int *)a];
+    int64_t y = sort_key[*(const int *)b];
+    return (x < y) - (x > y);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char *rom_path, uint32_t frames, uint32_t budget,
+                   int top, const char *csv_path)
+{
+    int n = sym_count + 2;
+    int64_t work = 0;
+    for (int i = 0; i < n; i++) work += self_cycles[i];
+
+    printf("=== rp6502_prof: %s ===\n", rom_path);
+    printf("PHI2 %u kHz, %u cycles per frame budget\n", phi2_khz, budget);
+    printf("Profiled %u vsyncs, %u loop iterations\n", frames, iter_count);
+    printf("Work %lld cycles, vsync wait %llu cycles\n\n",
+           (long long)work, (unsigned long long)idle_cycles);
+
+    if (iter_count > 0) {
+        uint32_t *sorted = malloc(iter_count * sizeof(uint32_t));
+        memcpy(sorted, iter_work, iter_count * sizeof(uint32_t));
+        qsort(sorted, iter_count, sizeof(uint32_t), cmp_u32);
+        uint64_t sum = 0;
+        uint32_t over = 0;
+        for (uint32_t i = 0; i < iter_count; i++) {
+            sum += sorted[i];
+            if (sorted[i] > budget) over++;
+        }
+        uint32_t mean = (uint32_t)(sum / iter_count);
+        printf("Frame work cycles:\n");
+        printf("  mean %7u (%5.1f%%)\n", mean, 100.0 * mean / budget);
+        printf("  p50  %7u (%5.1f%%)\n", sorted[iter_count / 2], 100.0 * sorted[iter_count / 2] / budget);
+        printf("  p95  %7u (%5.1f%%)\n", sorted[(iter_count * 95) / 100], 100.0 * sorted[(iter_count * 95) / 100] / budget);
+        printf("  p99  %7u (%5.1f%%)\n", sorted[(iter_count * 99) / 100], 100.0 * sorted[(iter_count * 99) / 100] / budget);
+        printf("  max  %7u (%5.1f%%)\n", sorted[iter_count - 1], 100.0 * sorted[iter_count - 1] / budget);
+        printf("  over budget: %u\n\n", over);
+        free(sorted);
+    }
+
+    int *order = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) order[i] = i;
+    sort_key = self_cycles;
+    qsort(order, n, sizeof(int), cmp_by_key);
+
+    printf("Flat profile (per frame averages over %u vsyncs):\n", frames);
+    printf("  %%work   self/frm    max/frm   incl/frm  calls/frm  function\n");
+    int rows = (top > 0 && top < n) ? top : n;
+    for (int r = 0; r < rows; r++) {
+        int i = order[r];
+        if (self_cycles[i] <= 0 && calls[i] == 0) break;
+        printf("  %5.1f %10.0f %10lld %10.0f %10.2f  %s\n",
+               work ? 100.0 * self_cycles[i] / work : 0.0,
+               (double)self_cycles[i] / frames,
+               (long long)max_frame[i],
+               (double)incl_cycles[i] / frames,
+               (double)calls[i] / frames,
+               syms[i].name);
+    }
+    printf("  %5s %10.0f %10s %10s %10s  <vsync wait>\n\n", "",
+           (double)idle_cycles / frames, "", "", "");
+
+    if (iter_count > 0) {
+        // 5% buckets; everything past 150% shares the last one
+        enum { BUCKETS = 31 };
+        uint32_t hist[BUCKETS] = {0};
+        uint32_t peak = 1;
+        for (uint32_t i = 0; i < iter_count; i++) {
+            uint32_t b = (uint32_t)((uint64_t)iter_work[i] * 20 / budget);
+            if (b >= BUCKETS) b = BUCKETS - 1;
+            if (++hist[b] > peak) peak = hist[b];
+        }
+        printf("Per-frame work histogram (%% of budget):\n");
+        for (int b = 0; b < BUCKETS; b++) {
+            if (!hist[b]) continue;
+            char bar[51];
+            int len = (int)((uint64_t)hist[b] * 50 / peak);
+            if (len == 0) len = 1;
+            memset(bar, '#', len);
+            bar[len] = '\0';
+            if (b == BUCKETS - 1) printf("  >=%3d%%    |%-50s %u\n", b * 5, bar, hist[b]);
+            else printf("  %3d-%3d%%  |%-50s %u\n", b * 5, b * 5 + 5, bar, hist[b]);
+        }
+    }
+
+    if (csv_path) {
+        FILE *csv = fopen(csv_path, "w");
+        if (csv) {
+            fprintf(csv, "function,self,self_per_frame,max_frame,incl_per_frame,calls\n");
+            for (int r = 0; r < n; r++) {
+                int i = order[r];
+                if (self_cycles[i] <= 0 && calls[i] == 0) continue;
+                fprintf(csv, "%s,%lld,%.1f,%lld,%.1f,%llu\n", syms[i].name,
+                        (long long)self_cycles[i], (double)self_cycles[i] / frames,
+                        (long long)max_frame[i], (double)incl_cycles[i] / frames,
+                        (unsigned long long)calls[i]);
+            }
+            fprintf(csv, "<vsync wait>,%llu,%.1f,,,\n", (unsigned long long)idle_cycles,
+                    (double)idle_cycles / frames);
+            fclose(csv);
+        } else {
+            fprintf(stderr, "rp6502_prof: cannot write %s\n", csv_path);
+        }
+    }
+    free(order);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-n frames] [-w warmup] [-s script] [-p khz] [-t top]\n"
+            "          [-c csv] [-v] rom.rp6502 program.elf\n", prog);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = DEFAULT_FRAMES;
+    uint32_t warmup = DEFAULT_WARMUP;
+    int top = DEFAULT_TOP;
+    const char *csv_path = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:w:s:p:t:c:v")) != -1) {
+        switch (opt) {
+        case 'n': frames = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'w': warmup = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 's':
+            if (!input_script_load(optarg)) {
+                fprintf(stderr, "rp6502_prof: cannot read script %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'p': phi2_khz = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 't': top = atoi(optarg); break;
+        case 'c': csv_path = optarg; break;
+        case 'v': echo_console = true; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (argc - optind != 2 || frames == 0 || phi2_khz == 0) {
+        usage(argv[0]);
+    }
+
+    const char *rom_path = argv[optind];
+    if (!load_rom(rom_path)) {
+        fprintf(stderr, "rp6502_prof: invalid ROM %s\n", rom_path);
+        return 1;
+    }
+    if (!load_symbols(argv[optind + 1])) {
+        fprintf(stderr, "rp6502_prof: no function symbols in %s\n", argv[optind + 1]);
+        return 1;
+    }
+
+    size_t n = (size_t)sym_count + 2;
+    self_cycles = calloc(n, sizeof(int64_t));
+    incl_cycles = calloc(n, sizeof(int64_t));
+    frame_cycles = calloc(n, sizeof(int64_t));
+    max_frame = calloc(n, sizeof(int64_t));
+    calls = calloc(n, sizeof(uint64_t));
+    active = calloc(n, sizeof(uint16_t));
+
+    cpu.read = bus_read;
+    cpu.write = bus_write;
+    w65c02_reset(&cpu);
+
+    uint64_t phi2_hz = (uint64_t)phi2_khz * 1000;
+    uint32_t budget = (uint32_t)(phi2_hz / 60);
+    uint32_t ticks = 0;
+    uint64_t next_tick = phi2_hz / 60;
+    if (warmup == 0) reset_profile();
+
+    while (!program_exited && !cpu.stopped && ticks < warmup + frames) {
+        if (cpu.cycles >= next_tick) {
+            ticks++;
+            vsync++;
+            next_tick = (ticks + 1) * phi2_hz / 60;
+            if (gamepad_addr >= 0 && gamepad_addr + GAMEPAD_COUNT * GAMEPAD_DATA_SIZE <= 0x10000) {
+                input_script_pad(ticks, &xram[gamepad_addr]);
+            }
+            if (irq_enable & 1) cpu.irq = true;
+            if (ticks == warmup) reset_profile();
+            continue;
+        }
+        if (cpu.waiting && !cpu.irq) {
+            if (profiling) idle_cycles += next_tick - cpu.cycles;
+            cpu.cycles = next_tick;
+            continue;
+        }
+
+        bool irq_taken = cpu.irq && !(cpu.p & W65C02_FLAG_I);
+        uint8_t op = bus_read(NULL, cpu.pc);     // No side effects at code addresses
+        cur_sym = sym_of[cpu.pc];
+        unsigned c = w65c02_step(&cpu);
+        self_cycles[cur_sym] += c;
+        frame_cycles[cur_sym] += c;
+
+        if (irq_taken || op == 0x20 || op == 0x00) {
+            enter(sym_of[cpu.pc]);
+        } else if (op == 0x60 || op == 0x40) {
+            leave();
+        }
+    }
+
+    if (program_exited) {
+        fprintf(stderr, "rp6502_prof: program exited after %u vsyncs\n", ticks);
+    }
+    if (ticks <= warmup) {
+        fprintf(stderr, "rp6502_prof: nothing profiled\n");
+        return 1;
+    }
+    report(rom_path, ticks - warmup, budget, top, csv_path);
+    return 0;
+}
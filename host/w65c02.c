@@ -0,0 +1,467 @@
+/*
+ * w65c02.c - Cycle-counting W65C02S core for the profiler
+ *
+ * Implements the full WDC 65C02 instruction set that llvm-mos emits for
+ * the RP6502 (including BRA/PHX/STZ/TRB/TSB and the Rockwell bit ops),
+ * with the datasheet cycle counts: +1 for indexed reads that cross a
+ * page, +1 for taken branches and +1 more if the branch crosses a page,
+ * +1 for decimal-mode ADC/SBC. Bus timing within an instruction is not
+ * modelled; only totals matter for profiling.
+ */
+
+#include "w65c02.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+// Base cycles per opcode, before page-cross/branch/decimal penalties
+static const uint8_t cycle_table[256] = {
+    7,6,2,1,5,3,5,5,3,2,2,1,6,4,6,5,   // 0x00
+    2,5,5,1,5,4,6,5,2,4,2,1,6,4,6,5,   // 0x10
+    6,6,2,1,3,3,5,5,4,2,2,1,4,4,6,5,   // 0x20
+    2,5,5,1,4,4,6,5,2,4,2,1,4,4,6,5,   // 0x30
+    6,6,2,1,3,3,5,5,3,2,2,1,3,4,6,5,   // 0x40
+    2,5,5,1,4,4,6,5,2,4,3,1,8,4,6,5,   // 0x50
+    6,6,2,1,3,3,5,5,4,2,2,1,6,4,6,5,   // 0x60
+    2,5,5,1,4,4,6,5,2,4,4,1,6,4,6,5,   // 0x70
+    2,6,2,1,3,3,3,5,2,2,2,1,4,4,4,5,   // 0x80
+    2,6,5,1,4,4,4,5,2,5,2,1,4,5,5,5,   // 0x90
+    2,6,2,1,3,3,3,5,2,2,2,1,4,4,4,5,   // 0xA0
+    2,5,5,1,4,4,4,5,2,4,2,1,4,4,4,5,   // 0xB0
+    2,6,2,1,3,3,5,5,2,2,2,3,4,4,6,5,   // 0xC0
+    2,5,5,1,4,4,6,5,2,4,3,3,4,4,7,5,   // 0xD0
+    2,6,2,1,3,3,5,5,2,2,2,1,4,4,6,5,   // 0xE0
+    2,5,5,1,4,4,6,5,2,4,4,1,4,4,7,5,   // 0xF0
+};
+
+// ============================================================================
+// BUS AND STACK HELPERS
+// ============================================================================
+
+static inline uint8_t rd(w65c02_t *c, uint16_t addr)
+{
+    return c->read(c->ctx, addr);
+}
+
+static inline void wr(w65c02_t *c, uint16_t addr, uint8_t val)
+{
+    c->write(c->ctx, addr, val);
+}
+
+static inline uint8_t fetch8(w65c02_t *c)
+{
+    return rd(c, c->pc++);
+}
+
+static inline uint16_t fetch16(w65c02_t *c)
+{
+    uint16_t lo = fetch8(c);
+    return lo | (uint16_t)(fetch8(c) << 8);
+}
+
+static inline uint16_t rd16(w65c02_t *c, uint16_t addr)
+{
+    return rd(c, addr) | (uint16_t)(rd(c, (uint16_t)(addr + 1)) << 8);
+}
+
+static inline uint16_t rd16_zp(w65c02_t *c, uint8_t zp)
+{
+    return rd(c, zp) | (uint16_t)(rd(c, (uint8_t)(zp + 1)) << 8);
+}
+
+static inline void push(w65c02_t *c, uint8_t v)
+{
+    wr(c, 0x100 | c->s--, v);
+}
+
+static inline uint8_t pull(w65c02_t *c)
+{
+    return rd(c, 0x100 | ++c->s);
+}
+
+static inline void set_nz(w65c02_t *c, uint8_t v)
+{
+    c->p &= ~(W65C02_FLAG_N | W65C02_FLAG_Z);
+    c->p |= v & W65C02_FLAG_N;
+    if (v == 0) c->p |= W65C02_FLAG_Z;
+}
+
+static inline void set_flag(w65c02_t *c, uint8_t flag, bool on)
+{
+    if (on) c->p |= flag; else c->p &= ~flag;
+}
+
+// ============================================================================
+// ADDRESSING MODES
+// ============================================================================
+
+static inline uint16_t indexed(uint16_t base, uint8_t index, unsigned *cyc)
+{
+    uint16_t ea = (uint16_t)(base + index);
+    if (cyc && ((base ^ ea) & 0xFF00)) (*cyc)++;
+    return ea;
+}
+
+static inline uint16_t am_zpx(w65c02_t *c) { return (uint8_t)(fetch8(c) + c->x); }
+static inline uint16_t am_zpy(w65c02_t *c) { return (uint8_t)(fetch8(c) + c->y); }
+static inline uint16_t am_izx(w65c02_t *c) { return rd16_zp(c, (uint8_t)(fetch8(c) + c->x)); }
+static inline uint16_t am_izp(w65c02_t *c) { return rd16_zp(c, fetch8(c)); }
+
+static inline uint16_t am_absx(w65c02_t *c, unsigned *cyc)
+{
+    return indexed(fetch16(c), c->x, cyc);
+}
+
+static inline uint16_t am_absy(w65c02_t *c, unsigned *cyc)
+{
+    return indexed(fetch16(c), c->y, cyc);
+}
+
+static inline uint16_t am_izy(w65c02_t *c, unsigned *cyc)
+{
+    return indexed(rd16_zp(c, fetch8(c)), c->y, cyc);
+}
+
+/**
+ * Effective address for the regular ALU group (ORA..SBC, opcode xxxxxx01)
+ * plus the 65C02 (zp) forms (xxx10010). Penalty only applies to reads.
+ */
+static uint16_t am_alu(w65c02_t *c, uint8_t op, unsigned *cyc)
+{
+    unsigned *pen = ((op & 0xE0) == 0x80) ? 0 : cyc;   // STA has fixed timing
+    if ((op & 0x1F) == 0x12) {
+        return am_izp(c);
+    }
+    switch ((op >> 2) & 7) {
+    case 0: return am_izx(c);
+    case 1: return fetch8(c);
+    case 2: return c->pc++;
+    case 3: return fetch16(c);
+    case 4: return am_izy(c, pen);
+    case 5: return am_zpx(c);
+    case 6: return am_absy(c, pen);
+    default: return am_absx(c, pen);
+    }
+}
+
+// ============================================================================
+// ALU OPERATIONS
+// ============================================================================
+
+static void op_adc(w65c02_t *c, uint8_t v, unsigned *cyc)
+{
+    unsigned cin = c->p & W65C02_FLAG_C;
+    unsigned bin = c->a + v + cin;
+    set_flag(c, W65C02_FLAG_V, (~(c->a ^ v) & (c->a ^ bin) & 0x80) != 0);
+    if (c->p & W65C02_FLAG_D) {
+        unsigned lo = (c->a & 0x0F) + (v & 0x0F) + cin;
+        if (lo >= 0x0A) lo = ((lo + 6) & 0x0F) + 0x10;
+        unsigned r = (c->a & 0xF0) + (v & 0xF0) + lo;
+        if (r >= 0xA0) r += 0x60;
+        set_flag(c, W65C02_FLAG_C, r >= 0x100);
+        c->a = (uint8_t)r;
+        (*cyc)++;
+    } else {
+        set_flag(c, W65C02_FLAG_C, bin >= 0x100);
+        c->a = (uint8_t)bin;
+    }
+    set_nz(c, c->a);
+}
+
+static void op_sbc(w65c02_t *c, uint8_t v, unsigned *cyc)
+{
+    int cin = c->p & W65C02_FLAG_C;
+    int bin = c->a - v - (1 - cin);
+    set_flag(c, W65C02_FLAG_V, ((c->a ^ v) & (c->a ^ bin) & 0x80) != 0);
+    set_flag(c, W65C02_FLAG_C, bin >= 0);
+    if (c->p & W65C02_FLAG_D) {
+        int lo = (c->a & 0x0F) - (v & 0x0F) + cin - 1;
+        int r = c->a - v + cin - 1;
+        if (r < 0) r -= 0x60;
+        if (lo < 0) r -= 0x06;
+        c->a = (uint8_t)r;
+        (*cyc)++;
+    } else {
+        c->a = (uint8_t)bin;
+    }
+    set_nz(c, c->a);
+}
+
+static void op_cmp(w65c02_t *c, uint8_t reg, uint8_t v)
+{
+    set_flag(c, W65C02_FLAG_C, reg >= v);
+    set_nz(c, (uint8_t)(reg - v));
+}
+
+static void op_alu(w65c02_t *c, uint8_t op, uint16_t ea, unsigned *cyc)
+{
+    switch (op >> 5) {
+    case 0: c->a |= rd(c, ea); set_nz(c, c->a); break;
+    case 1: c->a &= rd(c, ea); set_nz(c, c->a); break;
+    case 2: c->a ^= rd(c, ea); set_nz(c, c->a); break;
+    case 3: op_adc(c, rd(c, ea), cyc); break;
+    case 4: wr(c, ea, c->a); break;
+    case 5: c->a = rd(c, ea); set_nz(c, c->a); break;
+    case 6: op_cmp(c, c->a, rd(c, ea)); break;
+    default: op_sbc(c, rd(c, ea), cyc); break;
+    }
+}
+
+// Shift/rotate/inc/dec by opcode row: ASL ROL LSR ROR . . DEC INC
+static uint8_t op_rmw(w65c02_t *c, uint8_t op, uint8_t v)
+{
+    uint8_t carry = c->p & W65C02_FLAG_C;
+    switch (op >> 5) {
+    case 0: set_flag(c, W65C02_FLAG_C, v & 0x80); v <<= 1; break;
+    case 1: set_flag(c, W65C02_FLAG_C, v & 0x80); v = (uint8_t)((v << 1) | carry); break;
+    case 2: set_flag(c, W65C02_FLAG_C, v & 0x01); v >>= 1; break;
+    case 3: set_flag(c, W65C02_FLAG_C, v & 0x01); v = (uint8_t)((v >> 1) | (carry << 7)); break;
+    case 6: v--; break;
+    default: v++; break;
+    }
+    set_nz(c, v);
+    return v;
+}
+
+static void op_bit(w65c02_t *c, uint8_t v, bool immediate)
+{
+    set_flag(c, W65C02_FLAG_Z, (c->a & v) == 0);
+    if (!immediate) {
+        c->p = (uint8_t)((c->p & 0x3F) | (v & 0xC0));
+    }
+}
+
+static void branch(w65c02_t *c, bool taken, unsigned *cyc)
+{
+    int8_t rel = (int8_t)fetch8(c);
+    if (taken) {
+        uint16_t dest = (uint16_t)(c->pc + rel);
+        *cyc += ((dest ^ c->pc) & 0xFF00) ? 2 : 1;
+        c->pc = dest;
+    }
+}
+
+static void interrupt(w65c02_t *c, uint16_t vector, bool brk)
+{
+    push(c, c->pc >> 8);
+    push(c, c->pc & 0xFF);
+    push(c, (uint8_t)((c->p | W65C02_FLAG_U) & ~W65C02_FLAG_B) | (brk ? W65C02_FLAG_B : 0));
+    c->p |= W65C02_FLAG_I;
+    c->p &= ~W65C02_FLAG_D;
+    c->pc = rd16(c, vector);
+}
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void w65c02_reset(w65c02_t *c)
+{
+    c->a = c->x = c->y = 0;
+    c->s = 0xFD;
+    c->p = W65C02_FLAG_U | W65C02_FLAG_I;
+    c->waiting = false;
+    c->stopped = false;
+    c->pc = rd16(c, 0xFFFC);
+}
+
+unsigned w65c02_step(w65c02_t *c)
+{
+    if (c->stopped) {
+        return 1;
+    }
+    if (c->irq) {
+        c->waiting = false;
+        if (!(c->p & W65C02_FLAG_I)) {
+            interrupt(c, 0xFFFE, false);
+            c->cycles += 7;
+            return 7;
+        }
+    }
+    if (c->waiting) {
+        c->cycles += 1;
+        return 1;
+    }
+
+    uint8_t op = fetch8(c);
+    unsigned cyc = cycle_table[op];
+    uint16_t ea;
+    uint8_t v;
+
+    // Regular ALU group and 65C02 (zp) forms; 0x89 is BIT #
+    if (((op & 0x03) == 0x01 && op != 0x89) || ((op & 0x1F) == 0x12)) {
+        ea = am_alu(c, op, &cyc);
+        op_alu(c, op, ea, &cyc);
+        c->cycles += cyc;
+        return cyc;
+    }
+
+    // Rockwell bit ops: RMBn/SMBn (x7), BBRn/BBSn (xF)
+    if ((op & 0x0F) == 0x07) {
+        ea = fetch8(c);
+        v = rd(c, ea);
+        uint8_t bit = (uint8_t)(1 << ((op >> 4) & 7));
+        wr(c, ea, (op & 0x80) ? (v | bit) : (v & ~bit));
+        c->cycles += cyc;
+        return cyc;
+    }
+    if ((op & 0x0F) == 0x0F) {
+        v = rd(c, fetch8(c));
+        bool set = (v >> ((op >> 4) & 7)) & 1;
+        branch(c, (op & 0x80) ? set : !set, &cyc);
+        c->cycles += cyc;
+        return cyc;
+    }
+
+    switch (op) {
+    // --- Shifts, rotates, INC/DEC ---
+    case 0x06: case 0x26: case 0x46: case 0x66: case 0xC6: case 0xE6:
+        ea = fetch8(c); wr(c, ea, op_rmw(c, op, rd(c, ea))); break;
+    case 0x16: case 0x36: case 0x56: case 0x76: case 0xD6: case 0xF6:
+        ea = am_zpx(c); wr(c, ea, op_rmw(c, op, rd(c, ea))); break;
+    case 0x0E: case 0x2E: case 0x4E: case 0x6E: case 0xCE: case 0xEE:
+        ea = fetch16(c); wr(c, ea, op_rmw(c, op, rd(c, ea))); break;
+    case 0x1E: case 0x3E: case 0x5E: case 0x7E:
+        ea = am_absx(c, &cyc); wr(c, ea, op_rmw(c, op, rd(c, ea))); break;
+    case 0xDE: case 0xFE:
+        ea = am_absx(c, 0); wr(c, ea, op_rmw(c, op, rd(c, ea))); break;
+    case 0x0A: case 0x2A: case 0x4A: case 0x6A:
+        c->a = op_rmw(c, op, c->a); break;
+    case 0x3A: c->a--; set_nz(c, c->a); break;
+    case 0x1A: c->a++; set_nz(c, c->a); break;
+
+    // --- TSB/TRB ---
+    case 0x04: case 0x0C: case 0x14: case 0x1C:
+        ea = (op & 0x08) ? fetch16(c) : fetch8(c);
+        v = rd(c, ea);
+        set_flag(c, W65C02_FLAG_Z, (v & c->a) == 0);
+        wr(c, ea, (op & 0x10) ? (v & ~c->a) : (v | c->a));
+        break;
+
+    // --- BIT ---
+    case 0x24: op_bit(c, rd(c, fetch8(c)), false); break;
+    case 0x2C: op_bit(c, rd(c, fetch16(c)), false); break;
+    case 0x34: op_bit(c, rd(c, am_zpx(c)), false); break;
+    case 0x3C: op_bit(c, rd(c, am_absx(c, &cyc)), false); break;
+    case 0x89: op_bit(c, fetch8(c), true); break;
+
+    // --- Loads ---
+    case 0xA0: c->y = fetch8(c); set_nz(c, c->y); break;
+    case 0xA4: c->y = rd(c, fetch8(c)); set_nz(c, c->y); break;
+    case 0xAC: c->y = rd(c, fetch16(c)); set_nz(c, c->y); break;
+    case 0xB4: c->y = rd(c, am_zpx(c)); set_nz(c, c->y); break;
+    case 0xBC: c->y = rd(c, am_absx(c, &cyc)); set_nz(c, c->y); break;
+    case 0xA2: c->x = fetch8(c); set_nz(c, c->x); break;
+    case 0xA6: c->x = rd(c, fetch8(c)); set_nz(c, c->x); break;
+    case 0xAE: c->x = rd(c, fetch16(c)); set_nz(c, c->x); break;
+    case 0xB6: c->x = rd(c, am_zpy(c)); set_nz(c, c->x); break;
+    case 0xBE: c->x = rd(c, am_absy(c, &cyc)); set_nz(c, c->x); break;
+
+    // --- Stores ---
+    case 0x84: wr(c, fetch8(c), c->y); break;
+    case 0x8C: wr(c, fetch16(c), c->y); break;
+    case 0x94: wr(c, am_zpx(c), c->y); break;
+    case 0x86: wr(c, fetch8(c), c->x); break;
+    case 0x8E: wr(c, fetch16(c), c->x); break;
+    case 0x96: wr(c, am_zpy(c), c->x); break;
+    case 0x64: wr(c, fetch8(c), 0); break;
+    case 0x74: wr(c, am_zpx(c), 0); break;
+    case 0x9C: wr(c, fetch16(c), 0); break;
+    case 0x9E: wr(c, am_absx(c, 0), 0); break;
+
+    // --- Compares on X/Y ---
+    case 0xC0: op_cmp(c, c->y, fetch8(c)); break;
+    case 0xC4: op_cmp(c, c->y, rd(c, fetch8(c))); break;
+    case 0xCC: op_cmp(c, c->y, rd(c, fetch16(c))); break;
+    case 0xE0: op_cmp(c, c->x, fetch8(c)); break;
+    case 0xE4: op_cmp(c, c->x, rd(c, fetch8(c))); break;
+    case 0xEC: op_cmp(c, c->x, rd(c, fetch16(c))); break;
+
+    // --- Register transfers and inc/dec ---
+    case 0xAA: c->x = c->a; set_nz(c, c->x); break;
+    case 0x8A: c->a = c->x; set_nz(c, c->a); break;
+    case 0xA8: c->y = c->a; set_nz(c, c->y); break;
+    case 0x98: c->a = c->y; set_nz(c, c->a); break;
+    case 0xBA: c->x = c->s; set_nz(c, c->x); break;
+    case 0x9A: c->s = c->x; break;
+    case 0xE8: c->x++; set_nz(c, c->x); break;
+    case 0xCA: c->x--; set_nz(c, c->x); break;
+    case 0xC8: c->y++; set_nz(c, c->y); break;
+    case 0x88: c->y--; set_nz(c, c->y); break;
+
+    // --- Stack ---
+    case 0x48: push(c, c->a); break;
+    case 0xDA: push(c, c->x); break;
+    case 0x5A: push(c, c->y); break;
+    case 0x08: push(c, c->p | W65C02_FLAG_B | W65C02_FLAG_U); break;
+    case 0x68: c->a = pull(c); set_nz(c, c->a); break;
+    case 0xFA: c->x = pull(c); set_nz(c, c->x); break;
+    case 0x7A: c->y = pull(c); set_nz(c, c->y); break;
+    case 0x28: c->p = pull(c) | W65C02_FLAG_U; break;
+
+    // --- Flags ---
+    case 0x18: c->p &= ~W65C02_FLAG_C; break;
+    case 0x38: c->p |= W65C02_FLAG_C; break;
+    case 0x58: c->p &= ~W65C02_FLAG_I; break;
+    case 0x78: c->p |= W65C02_FLAG_I; break;
+    case 0xB8: c->p &= ~W65C02_FLAG_V; break;
+    case 0xD8: c->p &= ~W65C02_FLAG_D; break;
+    case 0xF8: c->p |= W65C02_FLAG_D; break;
+
+    // --- Branches ---
+    case 0x10: branch(c, !(c->p & W65C02_FLAG_N), &cyc); break;
+    case 0x30: branch(c, c->p & W65C02_FLAG_N, &cyc); break;
+    case 0x50: branch(c, !(c->p & W65C02_FLAG_V), &cyc); break;
+    case 0x70: branch(c, c->p & W65C02_FLAG_V, &cyc); break;
+    case 0x90: branch(c, !(c->p & W65C02_FLAG_C), &cyc); break;
+    case 0xB0: branch(c, c->p & W65C02_FLAG_C, &cyc); break;
+    case 0xD0: branch(c, !(c->p & W65C02_FLAG_Z), &cyc); break;
+    case 0xF0: branch(c, c->p & W65C02_FLAG_Z, &cyc); break;
+    case 0x80: branch(c, true, &cyc); break;
+
+    // --- Jumps, calls, returns ---
+    case 0x4C: c->pc = fetch16(c); break;
+    case 0x6C: c->pc = rd16(c, fetch16(c)); break;
+    case 0x7C: c->pc = rd16(c, (uint16_t)(fetch16(c) + c->x)); break;
+    case 0x20:
+        ea = fetch16(c);
+        c->pc--;
+        push(c, c->pc >> 8);
+        push(c, c->pc & 0xFF);
+        c->pc = ea;
+        break;
+    case 0x60:
+        c->pc = pull(c);
+        c->pc |= (uint16_t)(pull(c) << 8);
+        c->pc++;
+        break;
+    case 0x40:
+        c->p = pull(c) | W65C02_FLAG_U;
+        c->pc = pull(c);
+        c->pc |= (uint16_t)(pull(c) << 8);
+        break;
+    case 0x00:
+        c->pc++;
+        interrupt(c, 0xFFFE, true);
+        break;
+
+    // --- Halts ---
+    case 0xCB: c->waiting = true; break;
+    case 0xDB: c->stopped = true; break;
+
+    // --- Multi-byte NOPs; everything left is a 1-byte NOP ---
+    case 0x02: case 0x22: case 0x42: case 0x62: case 0x82: case 0xC2: case 0xE2:
+    case 0x44: case 0x54: case 0xD4: case 0xF4:
+        c->pc++;
+        break;
+    case 0x5C: case 0xDC: case 0xFC:
+        c->pc += 2;
+        break;
+    default:
+        break;
+    }
+
+    c->cycles += cyc;
+    return cyc;
+}
@@ -0,0 +1,51 @@
+#ifndef W65C02_H
+#define W65C02_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define W65C02_FLAG_C 0x01
+#define W65C02_FLAG_Z 0x02
+#define W65C02_FLAG_I 0x04
+#define W65C02_FLAG_D 0x08
+#define W65C02_FLAG_B 0x10
+#define W65C02_FLAG_U 0x20
+#define W65C02_FLAG_V 0x40
+#define W65C02_FLAG_N 0x80
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct w65c02 {
+    uint16_t pc;
+    uint8_t a, x, y, s, p;
+    uint64_t cycles;            // Total cycles executed since reset
+    bool irq;                   // IRQ line level (active high here)
+    bool waiting;               // Halted by WAI until an interrupt
+    bool stopped;               // Halted by STP
+    uint8_t (*read)(void *ctx, uint16_t addr);
+    void (*write)(void *ctx, uint16_t addr, uint8_t val);
+    void *ctx;
+} w65c02_t;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+/**
+ * Reset the CPU and load PC from the $FFFC vector
+ */
+void w65c02_reset(w65c02_t *cpu);
+
+/**
+ * Execute one instruction (or take a pending IRQ)
+ * @return Cycles consumed, including page-cross and branch penalties
+ */
+unsigned w65c02_step(w65c02_t *cpu);
+
+#endif // W65C02_H
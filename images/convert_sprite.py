@@ -4,7 +4,11 @@ import sys
 import os
 import argparse
 import colorsys
-from PIL import Image
+import math
+try:
+    from PIL import Image
+except ImportError:
+    Image = None    # Only needed for PNG input
 
 def rp6502_rgb_tile_bpp4(r1, g1, b1, r2, g2, b2):
     return (((b1 >> 7) << 6) | ((g1 >> 7) << 5) | ((r1 >> 7) << 4) | 
@@ -18,7 +22,61 @@ def rp6502_rgb_sprite_bpp16(r, g, b):
         # Format: A BBBBB GGGGG RRRRR
         return ((((b >> 3) << 11) | ((g >> 3) << 6) | (r >> 3)) | 1 << 5)
 
-def convert_image(image_path, output_path, mode):
+def rotate_frame(frame, angle):
+    """Nearest-neighbour rotation of a square frame of 16-bit sprite pixels
+    about its centre. Screen pixel (x, y) samples the source at R(angle)
+    applied to it, the same mapping as the affine sprite transform
+    [cos -sin; sin cos], so frame k matches rotation step k at runtime.
+    Samples that fall outside the source are transparent."""
+    size = len(frame)
+    c = size / 2
+    cos_a = math.cos(angle)
+    sin_a = math.sin(angle)
+    out = []
+    for y in range(size):
+        row = []
+        for x in range(size):
+            dx = x + 0.5 - c
+            dy = y + 0.5 - c
+            u = math.floor(c + cos_a * dx - sin_a * dy)
+            v = math.floor(c + sin_a * dx + cos_a * dy)
+            row.append(frame[v][u] if 0 <= u < size and 0 <= v < size else 0)
+        out.append(row)
+    return out
+
+def write_sprite_frames(frames, output_path, rotations):
+    """Write 16-bit sprite frames; with rotations > 1 each frame is followed
+    by rotations - 1 copies turned in 360 / rotations degree steps"""
+    with open(output_path, "wb") as o:
+        for frame in frames:
+            for k in range(rotations):
+                rotated = rotate_frame(frame, 2 * math.pi * k / rotations) if k else frame
+                for row in rotated:
+                    for val in row:
+                        o.write(val.to_bytes(2, "little"))
+    count = len(frames) * rotations
+    print(f"Output:     {output_path} [{count} frames, {count * 2 * len(frames[0]) ** 2} bytes]")
+
+def convert_raw_sprite(input_path, output_path, size, rotations):
+    """Re-rotate an existing 16-bit sprite .bin (frames of size x size)"""
+    with open(input_path, "rb") as f:
+        data = f.read()
+    frame_bytes = size * size * 2
+    if size <= 0 or len(data) % frame_bytes != 0:
+        print(f"Error: {input_path} is not a whole number of {size}x{size} 16-bit frames.")
+        sys.exit(1)
+    frames = []
+    for base in range(0, len(data), frame_bytes):
+        frames.append([[int.from_bytes(data[base + (y * size + x) * 2:base + (y * size + x) * 2 + 2],
+                                       "little") for x in range(size)] for y in range(size)])
+    print(f"Processing: {input_path} ({len(frames)} frames of {size}x{size})")
+    write_sprite_frames(frames, output_path, rotations)
+    print("Done.")
+
+def convert_image(image_path, output_path, mode, rotations=1):
+    if Image is None:
+        print("Error: PNG input needs Pillow (pip install pillow).")
+        sys.exit(1)
     try:
         with Image.open(image_path) as im:
             rgb_im = im.convert("RGB")
@@ -133,26 +191,31 @@ def convert_image(image_path, output_path, mode):
                 
             num_frames = width // height
             print(f"Layout:     {num_frames} frames of {sprite_size}x{sprite_size}")
+
+            if mode == 'sprite':
+                frames = []
+                for i in range(num_frames):
+                    base_x = i * sprite_size
+                    frames.append([[rp6502_rgb_sprite_bpp16(*rgb_im.getpixel((x, y)))
+                                    for x in range(base_x, base_x + sprite_size)]
+                                   for y in range(sprite_size)])
+                write_sprite_frames(frames, output_path, rotations)
+                print("Done.")
+                return
+
             print(f"Output:     {output_path} [{mode}]")
 
             with open(output_path, "wb") as o:
                 for i in range(num_frames):
                     base_x = i * sprite_size
-                    if mode == 'tile':
-                        if sprite_size % 2 != 0:
-                            print("Error: Sprite size must be even for Tile mode.")
-                            sys.exit(1)
-                        for y in range(sprite_size):
-                            for x in range(base_x, base_x + sprite_size, 2):
-                                r1, g1, b1 = rgb_im.getpixel((x, y))
-                                r2, g2, b2 = rgb_im.getpixel((x+1, y))
-                                o.write(rp6502_rgb_tile_bpp4(r1, g1, b1, r2, g2, b2).to_bytes(1, "little"))
-                    else:
-                        for y in range(sprite_size):
-                            for x in range(base_x, base_x + sprite_size):
-                                r, g, b = rgb_im.getpixel((x, y))
-                                val = rp6502_rgb_sprite_bpp16(r, g, b)
-                                o.write(val.to_bytes(2, "little"))
+                    if sprite_size % 2 != 0:
+                        print("Error: Sprite size must be even for Tile mode.")
+                        sys.exit(1)
+                    for y in range(sprite_size):
+                        for x in range(base_x, base_x + sprite_size, 2):
+                            r1, g1, b1 = rgb_im.getpixel((x, y))
+                            r2, g2, b2 = rgb_im.getpixel((x+1, y))
+                            o.write(rp6502_rgb_tile_bpp4(r1, g1, b1, r2, g2, b2).to_bytes(1, "little"))
             
             print("Done.")
 
@@ -165,17 +228,31 @@ def convert_image(image_path, output_path, mode):
 
 def main():
     parser = argparse.ArgumentParser(description="Convert images to RP6502 binary format.")
-    parser.add_argument("input_file", help="Input PNG image.")
+    parser.add_argument("input_file", help="Input PNG image (or a 16-bit sprite .bin with --size).")
     parser.add_argument("-o", "--output", help="Output BIN file.")
     parser.add_argument("--mode", choices=['sprite', 'tile', 'bitmap'], default='sprite', 
                         help="Mode: 'sprite' (16-bit), 'tile' (4-bit), or 'bitmap' (8-bit indexed).")
+    parser.add_argument("--rotations", type=int, default=1,
+                        help="Sprite mode: emit this many pre-rotated frames per frame "
+                             "(24 matches SHIP_ROTATION_STEPS).")
+    parser.add_argument("--size", type=int, default=0,
+                        help="Frame size in pixels when the input is a sprite .bin.")
 
     args = parser.parse_args()
 
     if not args.output:
         args.output = os.path.splitext(args.input_file)[0] + ".bin"
+    if args.rotations < 1 or (args.rotations > 1 and args.mode != 'sprite'):
+        print("Error: --rotations needs a positive count and sprite mode.")
+        sys.exit(1)
 
-    convert_image(args.input_file, args.output, args.mode)
+    if args.input_file.lower().endswith(".bin"):
+        if args.output == args.input_file:
+            print("Error: give an output file (-o) when re-rotating a .bin.")
+            sys.exit(1)
+        convert_raw_sprite(args.input_file, args.output, args.size, args.rotations)
+    else:
+        convert_image(args.input_file, args.output, args.mode, args.rotations)
 
 if __name__ == "__main__":
     main()
\ No newline at end of file
@@ -0,0 +1,142 @@
+/*
+ * anim.c - Table-driven sprite frame animation
+ *
+ * Frame stepping used to be pointer math in each module (a timer divided
+ * down to a frame index, times the bytes per frame, every update), which
+ * rewrote xram_sprite_ptr on frames where nothing changed. Each channel
+ * now counts down its step's duration and touches the sprite only when
+ * it moves to a step with a different frame.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <rp6502.h>
+#include "constants.h"
+#include "sprite_shadow.h"
+#include "anim.h"
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct {
+    const anim_step_t *first;   // NULL: channel free
+    const anim_step_t *step;    // Step shown now
+    unsigned config;            // Sprite config the frames go to
+    uint8_t timer;              // Frames left on this step; 0: ended
+} anim_channel_t;
+
+// ============================================================================
+// TABLES
+// ============================================================================
+
+// The fighter sheet: 8 frames of 4x4 pixels (16bpp), intact ship first
+#define FIGHTER_SHEET_FRAME(n)  (EXPLOSION_DATA + (n) * 32)
+
+const anim_step_t ANIM_FIGHTER_EXPLODE[] = {
+    { FIGHTER_SHEET_FRAME(0), 4, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(1), 4, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(2), 4, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(3), 4, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(4), 4, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(5), 4, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(6), 4, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(7), 4, ANIM_END },
+};
+
+const anim_step_t ANIM_PARTICLE[] = {
+    { FIGHTER_SHEET_FRAME(2), 10, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(3), 5, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(4), 5, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(5), 5, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(6), 5, ANIM_NEXT },
+    { FIGHTER_SHEET_FRAME(7), 5, ANIM_END },
+};
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static anim_channel_t channels[ANIM_MAX];
+static uint8_t channels_used = 0;   // Allocated channels (running or ended)
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+static void show_frame(const anim_channel_t *c)
+{
+    sprite_struct_set(c->config, vga_mode4_sprite_t, xram_sprite_ptr, c->step->frame);
+}
+
+void anim_init(void)
+{
+    for (uint8_t ch = 0; ch < ANIM_MAX; ch++) {
+        channels[ch].first = NULL;
+    }
+    channels_used = 0;
+}
+
+uint8_t anim_start(unsigned config, const anim_step_t *steps)
+{
+    for (uint8_t ch = 0; ch < ANIM_MAX; ch++) {
+        anim_channel_t *c = &channels[ch];
+        if (c->first) {
+            continue;
+        }
+        c->first = steps;
+        c->step = steps;
+        c->config = config;
+        c->timer = steps->duration;
+        channels_used++;
+        show_frame(c);
+        return ch;
+    }
+    printf("ERROR: no free animation channel\n");
+    return ANIM_NONE;
+}
+
+bool anim_running(uint8_t ch)
+{
+    return ch < ANIM_MAX && channels[ch].first && channels[ch].timer;
+}
+
+void anim_stop(uint8_t ch)
+{
+    if (ch < ANIM_MAX && channels[ch].first) {
+        channels[ch].first = NULL;
+        channels_used--;
+    }
+}
+
+void animate_all(void)
+{
+    if (channels_used == 0) {
+        return;
+    }
+
+    for (uint8_t ch = 0; ch < ANIM_MAX; ch++) {
+        anim_channel_t *c = &channels[ch];
+        if (!c->first || !c->timer || --c->timer) {
+            continue;
+        }
+
+        const anim_step_t *prev = c->step;
+        switch (prev->action) {
+        case ANIM_END:
+            continue;       // Timer stays 0: ended
+        case ANIM_LOOP:
+            c->step = c->first;
+            break;
+        default:
+            c->step++;
+            break;
+        }
+        c->timer = c->step->duration;
+        if (c->step->frame != prev->frame) {
+            show_frame(c);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef ANIM_H
+#define ANIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * anim.h - Table-driven sprite frame animation
+ *
+ * An animation is a const table of steps: the XRAM address of a frame's
+ * pixels, how many frames to show it, and what to do after it (carry on,
+ * loop back to the first step, or end). anim_start() binds a table to a
+ * sprite config and returns a channel; animate_all() steps every channel
+ * once per frame and writes the sprite's xram_sprite_ptr only when the
+ * frame shown actually changes.
+ *
+ * A channel that reaches ANIM_END keeps its last frame and stays
+ * allocated until its owner sees anim_running() go false and calls
+ * anim_stop(), so the owner decides what happens to the sprite.
+ */
+
+typedef enum {
+    ANIM_NEXT = 0,      // Go on to the next step
+    ANIM_LOOP,          // Go back to the first step
+    ANIM_END            // Hold this frame and stop
+} AnimAction;
+
+typedef struct {
+    uint16_t frame;     // XRAM address of the frame's pixels
+    uint8_t duration;   // Frames to show it (at least 1)
+    uint8_t action;     // AnimAction after it
+} anim_step_t;
+
+#define ANIM_MAX    48      // Channels: every fighter and particle at once
+#define ANIM_NONE   0xFF
+
+// Fighter explosion: the 8 frames of the fighter sheet, 4 frames each
+extern const anim_step_t ANIM_FIGHTER_EXPLODE[];
+// Explosion particle: frames 2-7 of the same sheet
+extern const anim_step_t ANIM_PARTICLE[];
+
+/**
+ * Free every channel (start of a game)
+ */
+void anim_init(void);
+
+/**
+ * Show the first step of `steps` on the sprite at `config` and start
+ * timing it; returns the channel, or ANIM_NONE if all are in use
+ */
+uint8_t anim_start(unsigned config, const anim_step_t *steps);
+
+/**
+ * True while the channel has steps left to show
+ */
+bool anim_running(uint8_t ch);
+
+/**
+ * Free the channel (ANIM_NONE is ignored); the sprite keeps its frame
+ */
+void anim_stop(uint8_t ch);
+
+/**
+ * Advance every running channel by one frame; call once per game frame
+ */
+void animate_all(void);
+
+#endif // ANIM_H
@@ -1,6 +1,6 @@
 #include "asteroids.h"
 #include "constants.h"      // Needs ASTEROID_M_DATA, game_frame
-#include "player.h"         // Needs scroll_dx, scroll_dy
+#include "player.h"         // Needs player_x, player_y
 #include "random.h"
 #include <stdint.h>
 #include <stdbool.h>
@@ -8,7 +8,11 @@
 #include <rp6502.h>
 #include <stdlib.h>
 #include "explosions.h"    // Needs start_explosion()   
-#include "text.h"           // For score display update
+#include "overlay.h"        // Crash message
+#include "sprite_shadow.h"
+#include "motion.h"
+#include "pool.h"
+#include "camera.h"
 
 // Rotation Tables (Reuse from player.c)
 extern const int16_t sin_fix[];
@@ -27,10 +31,10 @@ asteroid_t ast_l[MAX_AST_L];
 asteroid_t ast_m[MAX_AST_M];
 asteroid_t ast_s[MAX_AST_S];
 
-// Active counts for early-exit optimization
-static uint8_t active_ast_l_count = 0;
-static uint8_t active_ast_m_count = 0;
-static uint8_t active_ast_s_count = 0;
+// Live slots of each array (see pool.h)
+static pool_t ast_l_pool;
+static pool_t ast_m_pool;
+static pool_t ast_s_pool;
 
 // Config Addresses (From rpmegafighter.c)
 extern unsigned ASTEROID_L_CONFIG;
@@ -40,8 +44,7 @@ extern unsigned ASTEROID_S_CONFIG;
 
 extern void start_explosion(int16_t x, int16_t y);
 
-extern int16_t scroll_dx, scroll_dy;
-extern int player_score, enemy_score;
+extern int16_t player_score, enemy_score;
 extern int16_t game_score, game_level;
 
 // Asteroid World Boundaries
@@ -66,32 +69,29 @@ static inline bool broad_phase_check(int16_t dx, int16_t dy, int16_t margin) {
 // INITIALIZATION
 // ---------------------------------------------------------
 void init_asteroids(void) {
-    // Reset active counters
-    active_ast_l_count = 0;
-    active_ast_m_count = 0;
-    active_ast_s_count = 0;
+    // Free every slot
+    pool_init(&ast_l_pool, MAX_AST_L);
+    pool_init(&ast_m_pool, MAX_AST_M);
+    pool_init(&ast_s_pool, MAX_AST_S);
     
     // 1. Reset Large (Affine)
     size_t size_l = sizeof(vga_mode4_asprite_t);
     for (int i=0; i<MAX_AST_L; i++) {
-        ast_l[i].active = false;
         unsigned ptr = ASTEROID_L_CONFIG + (i * size_l);
-        xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100); // Hide
+        sprite_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100); // Hide
     }
     
     // 2. Reset Medium (Standard)
     size_t size_std = sizeof(vga_mode4_sprite_t);
     for (int i=0; i<MAX_AST_M; i++) {
-        ast_m[i].active = false;
         unsigned ptr = ASTEROID_M_CONFIG + (i * size_std);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
     }
     
     // 3. Reset Small (Standard)
     for (int i=0; i<MAX_AST_S; i++) {
-        ast_s[i].active = false;
         unsigned ptr = ASTEROID_S_CONFIG + (i * size_std);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
     }
 }
 
@@ -100,11 +100,11 @@ void init_asteroids(void) {
 // ---------------------------------------------------------
 // Internal helper to setup a specific asteroid
 static void activate_asteroid(asteroid_t *a, AsteroidType type, int level) {
-    a->active = true;
     a->type = type;
-    a->rx = 0; 
-    a->ry = 0;
+    a->x_frac = 0;
+    a->y_frac = 0;
     a->anim_frame = random(0, MAX_ROTATION); // Random start angle
+    a->transform_stale = true;
 
     // 1. Calculate Effective Level (Cap at 20)
     int eff_lvl = (level > 20) ? 20 : level;
@@ -118,6 +118,9 @@ static void activate_asteroid(asteroid_t *a, AsteroidType type, int level) {
         a->x = (int16_t)random(0, AWORLD_X) + AWORLD_X1;
         a->y = (rand16() & 1) ? AWORLD_Y1 : AWORLD_Y2;
     }
+    // Edges above are relative to the screen
+    a->x = world_x(a->x);
+    a->y = world_y(a->y);
 
     // Velocity (Slower for Large, Faster for Small)
     // int speed_base = (type == AST_LARGE) ? 64 : ((type == AST_MEDIUM) ? 128 : 256);
@@ -193,16 +196,13 @@ void spawn_asteroid_wave(int level) {
     }
 
     if (rand16() % 100 < 2) {
-        for (int i = 0; i < MAX_AST_L; i++) {
-            if (!ast_l[i].active) {
-                // Pass the level to scaling logic
-                activate_asteroid(&ast_l[i], AST_LARGE, level);
-                active_ast_l_count++;
-                
-                printf("Spawned Large Asteroid %d (Lvl %d)\n", i, level);
-                spawn_timer = 120; // 2 second cooldown
-                break; 
-            }
+        uint8_t i = pool_alloc(&ast_l_pool);
+        if (i != POOL_NONE) {
+            // Pass the level to scaling logic
+            activate_asteroid(&ast_l[i], AST_LARGE, level);
+            
+            printf("Spawned Large Asteroid %d (Lvl %d)\n", i, level);
+            spawn_timer = 120; // 2 second cooldown
         }
     }
 }
@@ -211,42 +211,17 @@ void spawn_asteroid_wave(int level) {
 // UPDATE & RENDER
 // ---------------------------------------------------------
 static void update_single(asteroid_t *a, int index, unsigned base_cfg, int size_bytes) {
-    // 1. Movement (Fixed Point)
-    // a->rx += a->vx; if (a->rx >= 256) { a->x++; a->rx -= 256; } else if (a->rx <= -256) { a->x--; a->rx += 256; }
-    // a->ry += a->vy; if (a->ry >= 256) { a->y++; a->ry -= 256; } else if (a->ry <= -256) { a->y--; a->ry += 256; }
-
-    // 1. MOVEMENT (Fixed Point - High Speed Capable)
-    
-    // X Axis
-    a->rx += a->vx;
-    int16_t whole_x = a->rx / 256; // Integer Division (e.g., 600 / 256 = 2)
-    if (whole_x != 0) {
-        a->x += whole_x;
-        a->rx %= 256; // Keep only the remainder (e.g., 600 % 256 = 88)
-    }
-
-    // Y Axis
-    a->ry += a->vy;
-    int16_t whole_y = a->ry / 256;
-    if (whole_y != 0) {
-        a->y += whole_y;
-        a->ry %= 256;
-    }
+    // 1. MOVEMENT (Q8.8 Fixed Point - High Speed Capable)
+    motion_step(&a->x, &a->x_frac, a->vx);
+    motion_step(&a->y, &a->y_frac, a->vy);
 
     // 2. World Wrap (AWORLD_X1 to AWORLD_X2) & (AWORLD_Y1 to AWORLD_Y2)
-    if (a->x < AWORLD_X1) a->x += AWORLD_X; else if (a->x > AWORLD_X2) a->x -= AWORLD_X;
-    if (a->y < AWORLD_Y1) a->y += AWORLD_Y; else if (a->y > AWORLD_Y2) a->y -= AWORLD_Y;
-
-    // Save world position before scrolling (needed for spawning children)
-    a->world_x = a->x;
-    a->world_y = a->y;
-
-    a->x -= scroll_dx;
-    a->y -= scroll_dy;
+    camera_wrap_x(&a->x, AWORLD_X1, AWORLD_X2);
+    camera_wrap_y(&a->y, AWORLD_Y1, AWORLD_Y2);
 
     // 3. Render
-    int sx = a->x;
-    int sy = a->y;
+    int sx = screen_x(a->x);
+    int sy = screen_y(a->y);
     unsigned ptr = base_cfg + (index * size_bytes);
 
     if (a->type == AST_LARGE) {
@@ -265,41 +240,48 @@ static void update_single(asteroid_t *a, int index, unsigned base_cfg, int size_
             // a->anim_frame--; // Spin Counter-Clockwise
             // if (a->anim_frame >= 250) a->anim_frame = MAX_ROTATION - 1; // Handle wrap
         }
-        int r = a->anim_frame; 
 
-        // Update Matrix (Rotation)
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[0],  cos_fix[r]); // SX
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[1], -sin_fix[r]); // SHY
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[3],  sin_fix[r]); // SHX
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[4],  cos_fix[r]); // SY
+        // The matrix only changes with the rotation step, so the six
+        // transform writes are skipped on the other seven frames (a spawn
+        // marks it stale so the new angle is written straight away)
+        if (game_frame % 8 == 0 || a->transform_stale) {
+            a->transform_stale = false;
+            int r = a->anim_frame; 
 
-        int16_t tx = t2_fix32[r]; 
-        
-        // TY uses the inverse angle (24 - r)
-        // Check bounds just in case r > 24
-        int y_idx = (MAX_ROTATION - r);
-        if (y_idx < 0) y_idx += MAX_ROTATION; // Safety wrap
-        int16_t ty = t2_fix32[y_idx];
+            // Update Matrix (Rotation)
+            sprite_struct_set(ptr, vga_mode4_asprite_t, transform[0],  cos_fix[r]); // SX
+            sprite_struct_set(ptr, vga_mode4_asprite_t, transform[1], -sin_fix[r]); // SHY
+            sprite_struct_set(ptr, vga_mode4_asprite_t, transform[3],  sin_fix[r]); // SHX
+            sprite_struct_set(ptr, vga_mode4_asprite_t, transform[4],  cos_fix[r]); // SY
 
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[2], tx); // TX
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[5], ty); // TY
+            int16_t tx = t2_fix32[r]; 
+            
+            // TY uses the inverse angle (24 - r)
+            // Check bounds just in case r > 24
+            int y_idx = (MAX_ROTATION - r);
+            if (y_idx < 0) y_idx += MAX_ROTATION; // Safety wrap
+            int16_t ty = t2_fix32[y_idx];
+
+            sprite_struct_set(ptr, vga_mode4_asprite_t, transform[2], tx); // TX
+            sprite_struct_set(ptr, vga_mode4_asprite_t, transform[5], ty); // TY
+        }
 
-        xram0_struct_set(ptr, vga_mode4_asprite_t, x_pos_px, sx);
-        xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, sy);
+        sprite_struct_set(ptr, vga_mode4_asprite_t, x_pos_px, sx);
+        sprite_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, sy);
     } 
     else {
         // --- MED/SMALL (Standard Plane 2) ---
         // Just position (no rotation logic yet)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, sx);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, sy);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, sx);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, sy);
         
         // Ensure data ptr is set (simple safeguard)
         uint16_t data = (a->type == AST_MEDIUM) ? ASTEROID_M_DATA : ASTEROID_S_DATA;
         uint8_t lsize = (a->type == AST_MEDIUM) ? 4 : 3;
         
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, data);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, lsize);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, data);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, lsize);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
     }
 }
 
@@ -308,28 +290,31 @@ void move_asteroids_offscreen(void) {
     for(int i=0; i<MAX_AST_L; i++) {
         // update_single(&ast_l[i], i, ASTEROID_L_CONFIG, sizeof(vga_mode4_asprite_t));
         unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-        xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
     }
     for(int i=0; i<MAX_AST_M; i++) {
         unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
     }
     for(int i=0; i<MAX_AST_S; i++) {
         unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
     }
 }
 
 void update_asteroids(void) {
-    // Loop through pools
-    for(int i=0; i<MAX_AST_L; i++) {
-        if (ast_l[i].active) update_single(&ast_l[i], i, ASTEROID_L_CONFIG, sizeof(vga_mode4_asprite_t));
+    // Loop through live slots only
+    for (uint8_t k = ast_l_pool.count; k-- > 0; ) {
+        uint8_t i = ast_l_pool.live[k];
+        update_single(&ast_l[i], i, ASTEROID_L_CONFIG, sizeof(vga_mode4_asprite_t));
     }
-    for(int i=0; i<MAX_AST_M; i++) {
-        if (ast_m[i].active) update_single(&ast_m[i], i, ASTEROID_M_CONFIG, sizeof(vga_mode4_sprite_t));
+    for (uint8_t k = ast_m_pool.count; k-- > 0; ) {
+        uint8_t i = ast_m_pool.live[k];
+        update_single(&ast_m[i], i, ASTEROID_M_CONFIG, sizeof(vga_mode4_sprite_t));
     }
-    for(int i=0; i<MAX_AST_S; i++) {
-        if (ast_s[i].active) update_single(&ast_s[i], i, ASTEROID_S_CONFIG, sizeof(vga_mode4_sprite_t));
+    for (uint8_t k = ast_s_pool.count; k-- > 0; ) {
+        uint8_t i = ast_s_pool.live[k];
+        update_single(&ast_s[i], i, ASTEROID_S_CONFIG, sizeof(vga_mode4_sprite_t));
     }
 }
 
@@ -341,84 +326,59 @@ void update_asteroids(void) {
 // If aim_at_player is true, velocity will be calculated to head toward player
 static void spawn_child(AsteroidType type, int16_t x, int16_t y, int16_t vx, int16_t vy, bool aim_at_player) {
     asteroid_t *pool;
-    int max_count;
+    pool_t *slots;
     
     // Select Pool
-    if (type == AST_MEDIUM) { pool = ast_m; max_count = MAX_AST_M; }
-    else { pool = ast_s; max_count = MAX_AST_S; }
-
-    // Find free slot
-    for (int i = 0; i < max_count; i++) {
-        if (!pool[i].active) {
-            pool[i].active = true;
-            pool[i].type = type;
-            pool[i].x = x;
-            pool[i].y = y;
-            pool[i].rx = 0; 
-            pool[i].ry = 0;
-            
-            printf("spawn_child: type=%d, x=%d, y=%d, vx=%d, vy=%d\n", type, x, y, vx, vy);
-            
-            // Calculate velocity - aim at player if requested
-            if (aim_at_player) {
-                // Calculate direction to player
-                int16_t dx = player_x - x;
-                int16_t dy = player_y - y;
-                
-                // Calculate base speed for this asteroid type
-                int16_t base_speed = (type == AST_MEDIUM) ? 180 : 280;
-                
-                // Normalize direction and scale to base_speed
-                // Use simple ratio to avoid sqrt
-                int16_t abs_dx = (dx < 0) ? -dx : dx;
-                int16_t abs_dy = (dy < 0) ? -dy : dy;
-                int16_t max_dist = (abs_dx > abs_dy) ? abs_dx : abs_dy;
-                
-                if (max_dist > 0) {
-                    pool[i].vx = (dx * base_speed) / max_dist;
-                    pool[i].vy = (dy * base_speed) / max_dist;
-                } else {
-                    // Fallback if player is at same position
-                    pool[i].vx = vx;
-                    pool[i].vy = vy;
-                }
-            } else {
-                pool[i].vx = vx;
-                pool[i].vy = vy;
-            }
-            pool[i].anim_frame = 0;
-            
-            // Set Health
-            pool[i].health = (type == AST_MEDIUM) ? 6 : 1;
-            
-            // Update active counters
-            if (type == AST_MEDIUM) {
-                active_ast_m_count++;
-            } else {
-                active_ast_s_count++;
-            }
-            
-            // Set Config Immediately (So it doesn't wait for next update frame)
-            // unsigned ptr;
-            // if (type == AST_MEDIUM) {
-            //     ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_M_DATA);
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 4); // 16x16
-            // } else {
-            //     ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_S_DATA);
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 3); // 8x8
-            // }
-            // xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-
-            // printf("Spawning Child Type %d at %d,%d (Slot %d)\n", type, x, y, i);
-            
-            return; // Spawned successfully
+    if (type == AST_MEDIUM) { pool = ast_m; slots = &ast_m_pool; }
+    else { pool = ast_s; slots = &ast_s_pool; }
+
+    // Take a free slot
+    uint8_t i = pool_alloc(slots);
+    if (i == POOL_NONE) {
+        // No free slot available - pool is full
+        printf("WARNING: Failed to spawn asteroid type %d - pool full!\n", type);
+        return;
+    }
+
+    pool[i].type = type;
+    pool[i].x = x;
+    pool[i].y = y;
+    pool[i].x_frac = 0;
+    pool[i].y_frac = 0;
+    
+    printf("spawn_child: type=%d, x=%d, y=%d, vx=%d, vy=%d\n", type, x, y, vx, vy);
+    
+    // Calculate velocity - aim at player if requested
+    if (aim_at_player) {
+        // Calculate direction to player
+        int16_t dx = player_x - screen_x(x);
+        int16_t dy = player_y - screen_y(y);
+        
+        // Calculate base speed for this asteroid type
+        int16_t base_speed = (type == AST_MEDIUM) ? 180 : 280;
+        
+        // Normalize direction and scale to base_speed
+        // Use simple ratio to avoid sqrt
+        int16_t abs_dx = (dx < 0) ? -dx : dx;
+        int16_t abs_dy = (dy < 0) ? -dy : dy;
+        int16_t max_dist = (abs_dx > abs_dy) ? abs_dx : abs_dy;
+        
+        if (max_dist > 0) {
+            pool[i].vx = (dx * base_speed) / max_dist;
+            pool[i].vy = (dy * base_speed) / max_dist;
+        } else {
+            // Fallback if player is at same position
+            pool[i].vx = vx;
+            pool[i].vy = vy;
         }
+    } else {
+        pool[i].vx = vx;
+        pool[i].vy = vy;
     }
+    pool[i].anim_frame = 0;
     
-    // No free slot available - pool is full
-    printf("WARNING: Failed to spawn asteroid type %d - pool full!\n", type);
+    // Set Health
+    pool[i].health = (type == AST_MEDIUM) ? 6 : 1;
 }
 
 // ---------------------------------------------------------
@@ -427,17 +387,17 @@ static void spawn_child(AsteroidType type, int16_t x, int16_t y, int16_t vx, int
 
 bool check_asteroid_hit(int16_t bx, int16_t by) {
     // Early exit if no asteroids active
-    if (active_ast_l_count == 0 && active_ast_m_count == 0 && active_ast_s_count == 0) {
+    if (ast_l_pool.count == 0 && ast_m_pool.count == 0 && ast_s_pool.count == 0) {
         return false;
     }
 
     // 1. Check LARGE Asteroids (Radius ~14px)
-    if (active_ast_l_count > 0) {
-        for (int i = 0; i < MAX_AST_L; i++) {
-            if (!ast_l[i].active) continue;
+    if (ast_l_pool.count > 0) {
+        for (uint8_t k = ast_l_pool.count; k-- > 0; ) {
+            uint8_t i = ast_l_pool.live[k];
             
-            int16_t dx = ast_l[i].x + 16 - bx;
-            int16_t dy = ast_l[i].y + 16 - by;
+            int16_t dx = world_delta(ast_l[i].x, bx) + 16;
+            int16_t dy = world_delta(ast_l[i].y, by) + 16;
             
             // Broad-phase then narrow-phase using inline helpers
             if (!broad_phase_check(dx, dy, 20)) continue;
@@ -446,8 +406,7 @@ bool check_asteroid_hit(int16_t bx, int16_t by) {
             ast_l[i].health--;
             if (ast_l[i].health <= 0) {
                 // DESTROY LARGE -> Spawn 2 Mediums
-                ast_l[i].active = false;
-                active_ast_l_count--;
+                pool_free(&ast_l_pool, i);
                 start_explosion(ast_l[i].x, ast_l[i].y);
                 player_score += 15;
                 game_score += 15 * game_level;
@@ -457,24 +416,24 @@ bool check_asteroid_hit(int16_t bx, int16_t by) {
                 asteroids_destroyed++;
 
                 // Split velocities (one diverges, one aims at player)
-                spawn_child(AST_MEDIUM, ast_l[i].world_x, ast_l[i].world_y, ast_l[i].vx + 128, ast_l[i].vy - 128, false);
-                spawn_child(AST_MEDIUM, ast_l[i].world_x, ast_l[i].world_y, ast_l[i].vx - 128, ast_l[i].vy + 128, true);
+                spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx + 128, ast_l[i].vy - 128, false);
+                spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx - 128, ast_l[i].vy + 128, true);
                 
                 // Hide sprite immediately
                 unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-                xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
             }
             return true;
         }
     }
 
     // 2. Check MEDIUM Asteroids (Radius ~7px)
-    if (active_ast_m_count > 0) {
-        for (int i = 0; i < MAX_AST_M; i++) {
-            if (!ast_m[i].active) continue;
+    if (ast_m_pool.count > 0) {
+        for (uint8_t k = ast_m_pool.count; k-- > 0; ) {
+            uint8_t i = ast_m_pool.live[k];
 
-            int16_t dx = ast_m[i].x + 8 - bx;
-            int16_t dy = ast_m[i].y + 8 - by;
+            int16_t dx = world_delta(ast_m[i].x, bx) + 8;
+            int16_t dy = world_delta(ast_m[i].y, by) + 8;
             
             if (!broad_phase_check(dx, dy, 12)) continue;
             if (!box_collision(dx, dy, 8)) continue;
@@ -482,8 +441,7 @@ bool check_asteroid_hit(int16_t bx, int16_t by) {
             ast_m[i].health--;
             if (ast_m[i].health <= 0) {
                 // DESTROY MEDIUM -> Spawn 2 Smalls
-                ast_m[i].active = false;
-                active_ast_m_count--;
+                pool_free(&ast_m_pool, i);
                 start_explosion(ast_m[i].x, ast_m[i].y);
                 player_score += 7;
                 game_score += 7 * game_level;
@@ -493,24 +451,24 @@ bool check_asteroid_hit(int16_t bx, int16_t by) {
                 asteroids_destroyed++;
 
                 // Make small ones fast! (one aims at player)
-                spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx + 128, ast_m[i].vy + 128, false);
-                spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx - 128, ast_m[i].vy - 128, true);
+                spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx + 128, ast_m[i].vy + 128, false);
+                spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx - 128, ast_m[i].vy - 128, true);
 
                 // Hide sprite
                 unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             }
             return true;
         }
     }
 
     // 3. Check SMALL Asteroids (Radius ~4px)
-    if (active_ast_s_count > 0) {
-        for (int i = 0; i < MAX_AST_S; i++) {
-            if (!ast_s[i].active) continue;
+    if (ast_s_pool.count > 0) {
+        for (uint8_t k = ast_s_pool.count; k-- > 0; ) {
+            uint8_t i = ast_s_pool.live[k];
 
-            int16_t dx = ast_s[i].x + 4 - bx;
-            int16_t dy = ast_s[i].y + 4 - by;
+            int16_t dx = world_delta(ast_s[i].x, bx) + 4;
+            int16_t dy = world_delta(ast_s[i].y, by) + 4;
             
             if (!broad_phase_check(dx, dy, 8)) continue;
             if (!box_collision(dx, dy, 4)) continue;
@@ -518,9 +476,8 @@ bool check_asteroid_hit(int16_t bx, int16_t by) {
             ast_s[i].health--; // Usually 1 hit kill
             if (ast_s[i].health <= 0) {
                 // DESTROY SMALL -> Dust
-                ast_s[i].active = false;
-                active_ast_s_count--;
-                start_explosion(ast_s[i].x, ast_s[i].y);
+                pool_free(&ast_s_pool, i);
+            start_explosion(ast_s[i].x, ast_s[i].y);
                 player_score += 2;
                 game_score += 2 * game_level;
                 
@@ -530,7 +487,7 @@ bool check_asteroid_hit(int16_t bx, int16_t by) {
 
                 // Hide sprite
                 unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             }
             return true;
         }
@@ -546,7 +503,7 @@ bool check_asteroid_hit(int16_t bx, int16_t by) {
 // Returns true if the fighter at (fx, fy) crashed into a rock
 bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
     // Early exit if no asteroids active
-    if (active_ast_l_count == 0 && active_ast_m_count == 0 && active_ast_s_count == 0) {
+    if (ast_l_pool.count == 0 && ast_m_pool.count == 0 && ast_s_pool.count == 0) {
         return false;
     }
     
@@ -559,12 +516,12 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
     // 1. Check LARGE Asteroids
     // -------------------------------------------------
     // Collision Radius: Rock(14) + Fighter(2) = 16
-    if (active_ast_l_count > 0) {
-        for (int i = 0; i < MAX_AST_L; i++) {
-            if (!ast_l[i].active) continue;
+    if (ast_l_pool.count > 0) {
+        for (uint8_t k = ast_l_pool.count; k-- > 0; ) {
+            uint8_t i = ast_l_pool.live[k];
             
-            int16_t a_cx = ast_l[i].x + 16 - f_cx;
-            int16_t a_cy = ast_l[i].y + 16 - f_cy;
+            int16_t a_cx = world_delta(ast_l[i].x, f_cx) + 16;
+            int16_t a_cy = world_delta(ast_l[i].y, f_cy) + 16;
             
             if (!broad_phase_check(a_cx, a_cy, 20)) continue;
             if (!box_collision(a_cx, a_cy, 16)) continue;
@@ -573,18 +530,17 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
                 
                 if (ast_l[i].health <= 0) {
                     // Destroy
-                    ast_l[i].active = false;
-                    active_ast_l_count--;
-                    start_explosion(a_cx - 16, a_cy - 16);
+                    pool_free(&ast_l_pool, i);
+                    start_explosion(ast_l[i].x, ast_l[i].y);
                     
                     // Hide sprite
                     unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-                    xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
+                    sprite_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
 
                     // Spawn Debris (one aims at player)
                     int16_t spread = 50;
-                    spawn_child(AST_MEDIUM, ast_l[i].world_x, ast_l[i].world_y, ast_l[i].vx + spread, ast_l[i].vy - spread, false);
-                    spawn_child(AST_MEDIUM, ast_l[i].world_x, ast_l[i].world_y, ast_l[i].vx - spread, ast_l[i].vy + spread, true);
+                    spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx + spread, ast_l[i].vy - spread, false);
+                    spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx - spread, ast_l[i].vy + spread, true);
                 }
                 return true;
         }
@@ -594,12 +550,12 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
     // 2. Check MEDIUM Asteroids
     // -------------------------------------------------
     // Collision Radius: Rock(7) + Fighter(2) = 9
-    if (active_ast_m_count > 0) {
-        for (int i = 0; i < MAX_AST_M; i++) {
-            if (!ast_m[i].active) continue;
+    if (ast_m_pool.count > 0) {
+        for (uint8_t k = ast_m_pool.count; k-- > 0; ) {
+            uint8_t i = ast_m_pool.live[k];
             
-            int16_t a_cx = ast_m[i].x + 8 - f_cx;
-            int16_t a_cy = ast_m[i].y + 8 - f_cy;
+            int16_t a_cx = world_delta(ast_m[i].x, f_cx) + 8;
+            int16_t a_cy = world_delta(ast_m[i].y, f_cy) + 8;
 
             if (!broad_phase_check(a_cx, a_cy, 12)) continue;
             if (!box_collision(a_cx, a_cy, 9)) continue;
@@ -607,17 +563,16 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
             ast_m[i].health -= 1;
                 
             if (ast_m[i].health <= 0) {
-                ast_m[i].active = false;
-                active_ast_m_count--;
+                pool_free(&ast_m_pool, i);
                 start_explosion(ast_m[i].x, ast_m[i].y);
 
                 // Hide sprite
                 unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
 
                 int16_t spread = 80;
-                spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx + spread, ast_m[i].vy - spread, false);
-                spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx - spread, ast_m[i].vy + spread, true);
+                spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx + spread, ast_m[i].vy - spread, false);
+                spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx - spread, ast_m[i].vy + spread, true);
             }
             return true;
         }
@@ -627,23 +582,22 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
     // 3. Check SMALL Asteroids
     // -------------------------------------------------
     // Collision Radius: Rock(3) + Fighter(2) = 5
-    if (active_ast_s_count > 0) {
-        for (int i = 0; i < MAX_AST_S; i++) {
-            if (!ast_s[i].active) continue;
+    if (ast_s_pool.count > 0) {
+        for (uint8_t k = ast_s_pool.count; k-- > 0; ) {
+            uint8_t i = ast_s_pool.live[k];
             
-            int16_t a_cx = ast_s[i].x + 4 - f_cx;
-            int16_t a_cy = ast_s[i].y + 4 - f_cy;
+            int16_t a_cx = world_delta(ast_s[i].x, f_cx) + 4;
+            int16_t a_cy = world_delta(ast_s[i].y, f_cy) + 4;
 
             if (!broad_phase_check(a_cx, a_cy, 8)) continue;
             if (!box_collision(a_cx, a_cy, 4)) continue;
 
-            ast_s[i].active = false;
-                active_ast_s_count--;
-                start_explosion(ast_s[i].x, ast_s[i].y);
+            pool_free(&ast_s_pool, i);
+            start_explosion(ast_s[i].x, ast_s[i].y);
 
             // Hide sprite
             unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
 
             return true;
         }
@@ -659,12 +613,12 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
     // 1. LARGE ASTEROIDS (Radius ~14)
     // -------------------------------------------------
     // Hitbox: 14 (Rock) + 3 (Player) = 17
-    for (int i = 0; i < MAX_AST_L; i++) {
-        if (!ast_l[i].active) continue;
+    for (uint8_t k = ast_l_pool.count; k-- > 0; ) {
+        uint8_t i = ast_l_pool.live[k];
         
         // Large uses centered coordinates due to Affine offset
-        int16_t a_cx = ast_l[i].x + 16;
-        int16_t a_cy = ast_l[i].y + 16;
+        int16_t a_cx = screen_x(ast_l[i].x) + 16;
+        int16_t a_cy = screen_y(ast_l[i].y) + 16;
 
         if (abs(a_cx - p_cx) < 17 && abs(a_cy - p_cy) < 17) {
             // CRASH INTO LARGE -> INSTANT GAME OVER
@@ -677,7 +631,7 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
             printf("CRASH! Triggering Death Sequence...\n");
             
             // 1. Start the first big explosion exactly at player position
-            start_explosion(px, py);
+            start_explosion(world_x(px), world_y(py));
             
             // 2. Begin the 3-second drama
             trigger_player_death();
@@ -686,15 +640,16 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
             uint8_t text_color = 32; 
             
             // Position text to upper-right of player (offset by ~20px right, ~20px up)
-            int16_t text_x = px + 20;
-            int16_t text_y = py - 20;
+            int16_t text_col = (px + 20) / 8;
+            uint8_t text_row = overlay_row_at(py - 20);
             
-            // Clamp to screen bounds
-            if (text_x > 200) text_x = 200;  // Keep text on screen
-            if (text_y < 10) text_y = 10;
+            // Clamp to the overlay
+            if (text_col < 0) text_col = 0;
+            if (text_col > OVERLAY_COLS - 14) text_col = OVERLAY_COLS - 14;  // Keep text on screen
+            if (text_row > OVERLAY_ROWS - 3) text_row = OVERLAY_ROWS - 3;
             
-            draw_text(text_x, text_y, "YOU CRASHED...", text_color);
-            draw_text(text_x + 15, text_y + 12, "GAME OVER", text_color);
+            overlay_text(text_col, text_row, "YOU CRASHED...", text_color);
+            overlay_text(text_col + 2, text_row + 2, "GAME OVER", text_color);
             
             return;
         }
@@ -704,11 +659,11 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
     // 2. MEDIUM ASTEROIDS (Radius ~7)
     // -------------------------------------------------
     // Hitbox: 7 (Rock) + 3 (Player) = 10
-    for (int i = 0; i < MAX_AST_M; i++) {
-        if (!ast_m[i].active) continue;
+    for (uint8_t k = ast_m_pool.count; k-- > 0; ) {
+        uint8_t i = ast_m_pool.live[k];
         
-        int16_t a_cx = ast_m[i].x + 8;
-        int16_t a_cy = ast_m[i].y + 8;
+        int16_t a_cx = screen_x(ast_m[i].x) + 8;
+        int16_t a_cy = screen_y(ast_m[i].y) + 8;
 
         if (abs(a_cx - p_cx) < 10 && abs(a_cy - p_cy) < 10) {
             // PENALTY: -20 Points
@@ -716,20 +671,20 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
             else player_score = 0;
 
             // Destroy Rock
-            ast_m[i].active = false;
+            pool_free(&ast_m_pool, i);
             start_explosion(ast_m[i].x, ast_m[i].y);
             
             // Hide Sprite
             unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
 
                         // Split into Smalls (one aims at player)
             int16_t spread = 80;
-            spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx + spread, ast_m[i].vy - spread, false);
-            spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx - spread, ast_m[i].vy + spread, true);
+            spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx + spread, ast_m[i].vy - spread, false);
+            spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx - spread, ast_m[i].vy + spread, true);
             
             // Visual feedback
-            start_explosion(px, py);
+            start_explosion(world_x(px), world_y(py));
             return; // Prevent multi-hit in one frame
         }
     }
@@ -738,11 +693,11 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
     // 3. SMALL ASTEROIDS (Radius ~3)
     // -------------------------------------------------
     // Hitbox: 3 (Rock) + 3 (Player) = 6
-    for (int i = 0; i < MAX_AST_S; i++) {
-        if (!ast_s[i].active) continue;
+    for (uint8_t k = ast_s_pool.count; k-- > 0; ) {
+        uint8_t i = ast_s_pool.live[k];
         
-        int16_t a_cx = ast_s[i].x + 4;
-        int16_t a_cy = ast_s[i].y + 4;
+        int16_t a_cx = screen_x(ast_s[i].x) + 4;
+        int16_t a_cy = screen_y(ast_s[i].y) + 4;
 
         if (abs(a_cx - p_cx) < 6 && abs(a_cy - p_cy) < 6) {
             // PENALTY: -10 Points
@@ -750,13 +705,13 @@ bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
             else player_score = 0;
 
             // Destroy Rock
-            ast_s[i].active = false;
+            pool_free(&ast_s_pool, i);
             start_explosion(ast_s[i].x, ast_s[i].y);
 
             unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             
-            start_explosion(px, py);
+            start_explosion(world_x(px), world_y(py));
             return;
         }
     }
@@ -768,29 +723,29 @@ bool check_asteroid_hit_no_score(int16_t bx, int16_t by) {
     // ---------------------------------------------------------
     // 1. Check LARGE Asteroids
     // ---------------------------------------------------------
-    for (int i = 0; i < MAX_AST_L; i++) {
-        if (!ast_l[i].active) continue;
+    for (uint8_t k = ast_l_pool.count; k-- > 0; ) {
+        uint8_t i = ast_l_pool.live[k];
         
         // Large uses Centered Coords (Affine offset)
-        int16_t a_cx = ast_l[i].x + 16;
-        int16_t a_cy = ast_l[i].y + 16;
+        int16_t a_cx = world_delta(ast_l[i].x, bx) + 16;
+        int16_t a_cy = world_delta(ast_l[i].y, by) + 16;
         
         // Radius 14 + Bullet 2 = 16
-        if (abs(a_cx - bx) < 16 && abs(a_cy - by) < 16) {
+        if (abs(a_cx) < 16 && abs(a_cy) < 16) {
             ast_l[i].health--; // 1 Damage
             
             if (ast_l[i].health <= 0) {
                 // Destroy & Split
-                ast_l[i].active = false;
+                pool_free(&ast_l_pool, i);
                 start_explosion(ast_l[i].x, ast_l[i].y);
                 // NO POINTS AWARDED
 
                 unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-                xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
 
                 int16_t spread = 50;
-                spawn_child(AST_MEDIUM, ast_l[i].world_x, ast_l[i].world_y, ast_l[i].vx + spread, ast_l[i].vy - spread, false);
-                spawn_child(AST_MEDIUM, ast_l[i].world_x, ast_l[i].world_y, ast_l[i].vx - spread, ast_l[i].vy + spread, true);
+                spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx + spread, ast_l[i].vy - spread, false);
+                spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx - spread, ast_l[i].vy + spread, true);
             }
             return true;
         }
@@ -799,27 +754,27 @@ bool check_asteroid_hit_no_score(int16_t bx, int16_t by) {
     // ---------------------------------------------------------
     // 2. Check MEDIUM Asteroids
     // ---------------------------------------------------------
-    for (int i = 0; i < MAX_AST_M; i++) {
-        if (!ast_m[i].active) continue;
+    for (uint8_t k = ast_m_pool.count; k-- > 0; ) {
+        uint8_t i = ast_m_pool.live[k];
         
         // Medium uses Top-Left Coords
-        int16_t a_cx = ast_m[i].x + 8;
-        int16_t a_cy = ast_m[i].y + 8;
+        int16_t a_cx = world_delta(ast_m[i].x, bx) + 8;
+        int16_t a_cy = world_delta(ast_m[i].y, by) + 8;
 
         // Radius 8 + Bullet 2 = 10
-        if (abs(a_cx - bx) < 10 && abs(a_cy - by) < 10) {
+        if (abs(a_cx) < 10 && abs(a_cy) < 10) {
             ast_m[i].health--;
             
             if (ast_m[i].health <= 0) {
-                ast_m[i].active = false;
+                pool_free(&ast_m_pool, i);
                 start_explosion(ast_m[i].x, ast_m[i].y);
                 
                 unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
 
                 int16_t spread = 80;
-                spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx + spread, ast_m[i].vy - spread, false);
-                spawn_child(AST_SMALL, ast_m[i].world_x, ast_m[i].world_y, ast_m[i].vx - spread, ast_m[i].vy + spread, true);
+                spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx + spread, ast_m[i].vy - spread, false);
+                spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx - spread, ast_m[i].vy + spread, true);
             }
             return true;
         }
@@ -828,23 +783,23 @@ bool check_asteroid_hit_no_score(int16_t bx, int16_t by) {
     // ---------------------------------------------------------
     // 3. Check SMALL Asteroids
     // ---------------------------------------------------------
-    for (int i = 0; i < MAX_AST_S; i++) {
-        if (!ast_s[i].active) continue;
+    for (uint8_t k = ast_s_pool.count; k-- > 0; ) {
+        uint8_t i = ast_s_pool.live[k];
         
         // Small uses Top-Left Coords
-        int16_t a_cx = ast_s[i].x + 4;
-        int16_t a_cy = ast_s[i].y + 4;
+        int16_t a_cx = world_delta(ast_s[i].x, bx) + 4;
+        int16_t a_cy = world_delta(ast_s[i].y, by) + 4;
 
         // Radius 4 + Bullet 2 = 6
-        if (abs(a_cx - bx) < 6 && abs(a_cy - by) < 6) {
+        if (abs(a_cx) < 6 && abs(a_cy) < 6) {
             ast_s[i].health--;
             
             if (ast_s[i].health <= 0) {
-                ast_s[i].active = false;
-                start_explosion(ast_s[i].x, ast_s[i].y);
+                pool_free(&ast_s_pool, i);
+            start_explosion(ast_s[i].x, ast_s[i].y);
 
                 unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             }
             return true;
         }
@@ -13,17 +13,16 @@ typedef enum {
 
 // Object Structure
 typedef struct {
-    bool active;
-    int16_t x, y;       // World Position (modified by scroll for rendering/collision)
-    int16_t world_x, world_y; // True world position (before scroll adjustment)
-    int16_t rx, ry;     // Sub-pixel remainders (for smooth movement)
-    int16_t vx, vy;     // Velocity (Speed)
+    int16_t x, y;       // World Position (see camera.h)
+    uint8_t x_frac, y_frac; // Sub-pixel position (see motion.h)
+    int16_t vx, vy;     // Velocity (Q8.8 pixels per frame)
     uint8_t anim_frame; // For rotation/animation
+    bool transform_stale; // Large: affine matrix not yet written for anim_frame
     int8_t health;      // Hit points
     AsteroidType type;
 } asteroid_t;
 
-// Pools
+// Array sizes (slots are handed out by a pool, see pool.h)
 #define MAX_AST_L 2
 #define MAX_AST_M 4
 #define MAX_AST_S 8
@@ -38,16 +37,17 @@ void spawn_asteroid_wave(int level); // Call every frame
 void update_asteroids(void);         // Call every frame
 void move_asteroids_offscreen(void); // Move all asteroids offscreen (for screen transitions)
 
-// Returns true if the bullet hit an asteroid (so the bullet should die)
+// Returns true if the bullet at world (x, y) hit an asteroid (so the bullet should die)
 bool check_asteroid_hit(int16_t x, int16_t y);
 
-// Returns true if the fighter at (fx, fy) crashed into a rock
+// Returns true if the fighter at world (fx, fy) crashed into a rock
 bool check_asteroid_hit_fighter(int16_t fx, int16_t fy);
 
-// Checks collision between Player and all Asteroids
+// Checks collision between Player (screen px, py) and all Asteroids
 // Modifies scores and destroys asteroids if hit
 void check_player_asteroid_collision(int16_t px, int16_t py);
 
+// check_asteroid_hit() for enemy bullets (world x, y); awards no points
 bool check_asteroid_hit_no_score(int16_t x, int16_t y);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+ * audio.c - Music and sound effects ticked from the vsync interrupt
+ *
+ * The IRQ vector is RAM at $FFFE on the Picocomputer, so audio_init()
+ * points it at the handler, enables the RIA's vsync interrupt and clears
+ * the CPU's interrupt mask. The host build has no 6502; its stand-in RIA
+ * calls the handler through ria_host_irq_vector at each emulated vsync.
+ */
+
+#include <rp6502.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "audio.h"
+#include "psg.h"
+#include "sound.h"
+#include "music.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define QUEUE_MASK      (AUDIO_QUEUE_LEN - 1)
+#define RIA_IRQ_VSYNC   0x01
+
+#ifdef __mos__
+// Saves every register the handler uses and returns with RTI
+#define IRQ_HANDLER     __attribute__((interrupt))
+#define IRQ_VECTOR      (*(void (*volatile *)(void))0xFFFE)
+#define irq_unmask()    __asm__ volatile ("cli")
+#else
+#define IRQ_HANDLER
+#define IRQ_VECTOR      ria_host_irq_vector
+#define irq_unmask()
+#endif
+
+// Keeps the compiler from moving queue slot accesses across an index update
+#define barrier()       __asm__ volatile ("" ::: "memory")
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static AudioCommand queue[AUDIO_QUEUE_LEN];
+static volatile uint8_t queue_head = 0;     // Next slot the game fills
+static volatile uint8_t queue_tail = 0;     // Next slot the tick runs
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+AudioCommand *audio_command(AudioOp op)
+{
+    uint8_t head = queue_head;
+    if ((uint8_t)(head - queue_tail) >= AUDIO_QUEUE_LEN) {
+        return NULL;
+    }
+    AudioCommand *cmd = &queue[head & QUEUE_MASK];
+    cmd->op = op;
+    return cmd;
+}
+
+void audio_post(void)
+{
+    barrier();
+    queue_head = queue_head + 1;
+}
+
+bool audio_send(AudioOp op, uint8_t arg, const void *ptr)
+{
+    AudioCommand *cmd = audio_command(op);
+    if (!cmd) {
+        return false;
+    }
+    cmd->arg[0] = arg;
+    cmd->ptr = ptr;
+    audio_post();
+    return true;
+}
+
+static void run_command(const AudioCommand *cmd)
+{
+    switch (cmd->op) {
+    case AUDIO_CMD_SFX:
+        sound_start(cmd->arg[0], cmd->word, cmd->arg[1], cmd->arg[2],
+                    cmd->arg[3], cmd->arg[4], cmd->arg[5]);
+        break;
+    case AUDIO_CMD_SONG:
+        music_play((const MusicSong *)cmd->ptr);
+        break;
+    case AUDIO_CMD_STREAM:
+        music_play_stream(cmd->arg[0]);
+        break;
+    case AUDIO_CMD_STOP:
+        music_halt();
+        break;
+    case AUDIO_CMD_TEMPO:
+        music_set_tempo(cmd->arg[0]);
+        break;
+    }
+}
+
+/**
+ * One frame of audio: apply the posted commands, step the music and the
+ * voice timers, write the changed PSG registers
+ */
+static IRQ_HANDLER void audio_irq(void)
+{
+    (void)RIA.irq;                  // Acknowledge
+
+    uint16_t addr = RIA.addr1;
+    uint8_t step = RIA.step1;
+
+    // The game can't run until this returns, so the slots up to the head
+    // seen here are complete
+    uint8_t head = queue_head;
+    for (uint8_t tail = queue_tail; tail != head; tail++) {
+        run_command(&queue[tail & QUEUE_MASK]);
+    }
+    queue_tail = head;
+
+    update_music();
+    psg_flush();
+
+    RIA.addr1 = addr;
+    RIA.step1 = step;
+}
+
+void audio_init(void)
+{
+    queue_head = queue_tail = 0;
+    IRQ_VECTOR = audio_irq;
+    RIA.irq = RIA_IRQ_VSYNC;
+    irq_unmask();
+}
@@ -0,0 +1,68 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * audio.h - Music and sound effects ticked from the vsync interrupt
+ *
+ * The sequencer and the voice timers used to advance only in loops that
+ * remembered to call update_music() and psg_flush(), so the music froze
+ * behind the level-up, initials and save screens and drifted whenever a
+ * frame overran. They now run from the RIA vsync IRQ, once per frame no
+ * matter what the game is doing.
+ *
+ * The game never touches the PSG state itself: play_sound(),
+ * start_music() and friends post a command, and the next tick applies
+ * it. Only the game moves the queue's head and only the tick moves its
+ * tail, both single bytes, so neither side ever waits for the other. A
+ * full queue drops the command.
+ *
+ * The tick writes the PSG through XRAM portal 1 and puts the portal's
+ * address and step back afterwards, so a portal 1 write the game was in
+ * the middle of carries on unharmed. It makes no OS calls; reading a
+ * streamed log off storage stays with the game (music_stream_fill()).
+ */
+
+#define AUDIO_QUEUE_LEN     16      // Commands in flight; a power of two
+
+typedef enum {
+    AUDIO_CMD_SFX,          // play_sound(): arg = type, wave, attack, decay, release, volume; word = Hz
+    AUDIO_CMD_SONG,         // Play ptr, a MusicSong
+    AUDIO_CMD_STREAM,       // Play the register log buffered from ring position arg[0]
+    AUDIO_CMD_STOP,         // Stop the music
+    AUDIO_CMD_TEMPO         // arg[0] frames per row
+} AudioOp;
+
+typedef struct {
+    uint8_t op;             // AudioOp
+    uint8_t arg[6];
+    uint16_t word;
+    const void *ptr;
+} AudioCommand;
+
+/**
+ * Hook the tick to the vsync IRQ; call once after init_psg() and
+ * init_music()
+ */
+void audio_init(void);
+
+/**
+ * Queue slot for the next command (op already set), or NULL if the
+ * queue is full. Fill in the arguments, then audio_post().
+ */
+AudioCommand *audio_command(AudioOp op);
+
+/**
+ * Hand the command from audio_command() to the tick
+ */
+void audio_post(void);
+
+/**
+ * Queue a command with at most one byte argument and a pointer; false
+ * if the queue is full
+ */
+bool audio_send(AudioOp op, uint8_t arg, const void *ptr);
+
+#endif // AUDIO_H
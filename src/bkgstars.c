@@ -5,77 +5,148 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include "random.h"
-#include "graphics.h"
+#include "raster.h"
+#include "palette.h"
+
+#define STAR_CYCLE_PERIOD 2    // Frames per rainbow step of the star band
+
+#ifdef TILE_STARS
+
+#include "camera.h"
+
+// Hardware-scrolled starfield: a repeating map of 16x16 star tiles on the
+// plane 0 fill, behind the bitmap (palette index 0 is transparent), so the
+// bitmap stays free and scrolling costs two config writes per frame.
+// Tile pixels use palette indices 1-3 from the star band, so they cycle too.
+#define STAR_MAP_W        16      // Map size in tiles (256x128 px, wrapped)
+#define STAR_MAP_H        8
+#define STAR_TILE_BYTES   64      // 16x16 pixels at 2bpp
+#define STAR_TILE_KINDS   5       // Tile 0 is empty
+#define STAR_DENSITY      6       // About one map cell in STAR_DENSITY holds stars
+#define STAR_PARALLAX     1       // The layer moves at camera >> STAR_PARALLAX
+#define STAR_MODE_ATTR    0x09    // Mode 2 attributes: 2bpp, 16x16 tiles
+
+/**
+ * OR one 2bpp pixel into a star tile
+ */
+static void plot_tile_star(uint8_t tile, uint8_t px, uint8_t py, uint8_t value)
+{
+    RIA.addr0 = STAR_TILE_DATA + tile * STAR_TILE_BYTES + py * 4 + px / 4;
+    RIA.step0 = 0;
+    uint8_t bits = RIA.rw0;
+    RIA.rw0 = bits | (value << (6 - 2 * (px % 4)));
+}
+
+void init_stars(void) 
+{
+    palette_effect_start(PAL_FX_STARS, PAL_BAND_STARS, PAL_STARS_LEN, PAL_RAINBOW_FIRST,
+                         PAL_RAINBOW_LEN, PAL_RAINBOW_LEN / PAL_STARS_LEN, STAR_CYCLE_PERIOD);
+
+    // One or two stars per tile, in different colours
+    RIA.addr0 = STAR_TILE_DATA;
+    RIA.step0 = 1;
+    for (unsigned i = STAR_TILE_KINDS * STAR_TILE_BYTES; i--;) {
+        RIA.rw0 = 0;
+    }
+    for (uint8_t t = 1; t < STAR_TILE_KINDS; t++) {
+        plot_tile_star(t, random(0, 15), random(0, 15), 1 + t % 3);
+        if (t & 1) {
+            plot_tile_star(t, random(0, 15), random(0, 15), 1 + (t + 1) % 3);
+        }
+    }
+
+    // Scatter the star tiles over the map
+    RIA.addr0 = STAR_MAP_DATA;
+    RIA.step0 = 1;
+    for (uint8_t i = 0; i < STAR_MAP_W * STAR_MAP_H; i++) {
+        RIA.rw0 = random(1, STAR_DENSITY) == 1 ? random(1, STAR_TILE_KINDS - 1) : 0;
+    }
+
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, x_wrap, true);
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, y_wrap, true);
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, width_tiles, STAR_MAP_W);
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, height_tiles, STAR_MAP_H);
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, xram_data_ptr, STAR_MAP_DATA);
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, xram_palette_ptr, PALETTE_ADDR);
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, xram_tile_ptr, STAR_TILE_DATA);
+    draw_stars(0, 0);
+
+    // Plane 0 fill, below the HUD rows like the bitmap stars
+    xregn(1, 0, 1, 6, 2, STAR_MODE_ATTR, STAR_PLANE_CONFIG, 0, PLAYFIELD_TOP, SCREEN_HEIGHT);
+}
+
+void stop_stars(void)
+{
+    // The title screen reloads the rows holding the map and tiles, so park
+    // the layer below the screen
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, y_wrap, false);
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, y_pos_px, SCREEN_HEIGHT);
+}
+
+void draw_stars(int16_t dx, int16_t dy) 
+{
+    (void)dx;
+    (void)dy;
+
+    // Unsigned shift keeps the layer seamless when the camera wraps
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, x_pos_px,
+                     -(int16_t)((uint16_t)camera_x >> STAR_PARALLAX));
+    xram0_struct_set(STAR_PLANE_CONFIG, vga_mode2_config_t, y_pos_px,
+                     -(int16_t)((uint16_t)camera_y >> STAR_PARALLAX));
+}
+
+#else
 
 // Star arrays (defined here, declared in bkgstars.h)
 int16_t star_x[32] = {0};
 int16_t star_y[32] = {0};
-int16_t star_x_old[32] = {0};
-int16_t star_y_old[32] = {0};
 uint8_t star_colour[32] = {0};
 
-// Color cycle timer for Galaga-style rainbow effect
-static uint16_t star_color_timer = 0;
+// Where each star was last plotted on each bitmap page
+static int16_t star_x_old[RASTER_PAGES][32];
+static int16_t star_y_old[RASTER_PAGES][32];
+
+// Pages still showing stars at an older position
+static uint8_t stale_pages = 0;
 
 void init_stars(void) 
 {
+    // Galaga-style rainbow: stars keep their index and the band cycles
+    palette_effect_start(PAL_FX_STARS, PAL_BAND_STARS, PAL_STARS_LEN, PAL_RAINBOW_FIRST,
+                         PAL_RAINBOW_LEN, PAL_RAINBOW_LEN / PAL_STARS_LEN, STAR_CYCLE_PERIOD);
+
+    stale_pages = 0;
     for (uint8_t i = 0; i < NSTAR; i++) {
         star_x[i] = random(1, STARFIELD_X);
         // Keep stars away from HUD area (top 10 pixels)
         star_y[i] = random(11, STARFIELD_Y);
-        star_colour[i] = random(32, 255);
-        star_x_old[i] = star_x[i];
-        star_y_old[i] = star_y[i];
+        star_colour[i] = PAL_BAND_STARS + i % PAL_STARS_LEN;
+        for (uint8_t p = 0; p < RASTER_PAGES; p++) {
+            star_x_old[p][i] = star_x[i];
+            star_y_old[p][i] = star_y[i];
+        }
+        
+        // Plot once on every page; draw_stars() only redraws stars that move
+        if (star_x[i] < 320 && star_y[i] < 180) {
+            raster_pixel(star_x[i], star_y[i], star_colour[i]);
+        }
     }
 }
 
 void draw_stars(int16_t dx, int16_t dy) 
 {
-    // Cycle rainbow colors (update every 4 frames like in title_screen.c)
-    star_color_timer++;
-    bool update_color = (star_color_timer % 4) == 0;
-    bool has_movement = (dx != 0 || dy != 0);
-    
-    // Early exit: skip if no movement and not a color update frame
-    if (!has_movement && !update_color) {
-        return;
-    }
-    
-    uint8_t base_color_index = 32 + ((star_color_timer / 2) % 224);
-    
-    for (uint8_t i = 0; i < NSTAR; i++) {
-        // Update color if it's time
-        if (update_color) {
-            // Each star gets an offset color from the cycling rainbow
-            // This creates the Galaga-style rotating rainbow effect
-            uint8_t new_color = 32 + ((base_color_index - 32 + (i * 7)) % 224);
-            
-            // Only redraw if color actually changed or if we're also moving
-            if (new_color != star_colour[i] || has_movement) {
-                star_colour[i] = new_color;
-            } else {
-                continue; // Color unchanged and no movement, skip this star
-            }
-        }
-        
-        // Clear previous star position only if moving
-        if (has_movement) {
-            if (star_x_old[i] > 0 && star_x_old[i] < 320 && 
-                star_y_old[i] > 0 && star_y_old[i] < 180) {
-                set(star_x_old[i], star_y_old[i], 0x00);
-            }
-            
+    if (dx != 0 || dy != 0) {
+        for (uint8_t i = 0; i < NSTAR; i++) {
             // Update star position based on scroll
-            star_x[i] = star_x_old[i] - dx;
+            star_x[i] -= dx;
             if (star_x[i] <= 0) {
                 star_x[i] += STARFIELD_X;
             }
             if (star_x[i] > STARFIELD_X) {
                 star_x[i] -= STARFIELD_X;
             }
-            star_x_old[i] = star_x[i];
-            
-            star_y[i] = star_y_old[i] - dy;
+
+            star_y[i] -= dy;
             if (star_y[i] <= 10) {
                 // When wrapping from top, place at bottom minus HUD offset
                 star_y[i] += (STARFIELD_Y - 10);
@@ -84,13 +155,41 @@ void draw_stars(int16_t dx, int16_t dy)
                 // When wrapping from bottom, place below HUD area
                 star_y[i] = (star_y[i] - STARFIELD_Y) + 11;
             }
-            star_y_old[i] = star_y[i];
         }
+        stale_pages = RASTER_PAGES;
+    }
+
+    // Colours animate in the palette, so stars only redraw after a move,
+    // once on each page (the back page is drawn, then shown)
+    if (stale_pages == 0) {
+        return;
+    }
+    stale_pages--;
+
+    int16_t *x_old = star_x_old[raster_back_page];
+    int16_t *y_old = star_y_old[raster_back_page];
+    raster_set_target(RASTER_BACK);
+    for (uint8_t i = 0; i < NSTAR; i++) {
+        // Clear previous star position
+        if (x_old[i] > 0 && x_old[i] < 320 && 
+            y_old[i] > 0 && y_old[i] < 180) {
+            raster_pixel(x_old[i], y_old[i], 0x00);
+        }
+        x_old[i] = star_x[i];
+        y_old[i] = star_y[i];
         
         // Draw star at new position if on screen (avoid HUD area at top)
         if (star_x[i] > 0 && star_x[i] < 320 && 
             star_y[i] > 10 && star_y[i] < 180) {
-            set(star_x[i], star_y[i], star_colour[i]);
+            raster_pixel(star_x[i], star_y[i], star_colour[i]);
         }
     }
+    raster_set_target(RASTER_BOTH);
+}
+
+void stop_stars(void)
+{
+    // Nothing to do: the title screen's image replaces the bitmap stars
 }
+
+#endif // TILE_STARS
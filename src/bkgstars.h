@@ -10,4 +10,7 @@ void init_stars(void);
 // dx, dy: change in world coordinates for scrolling
 void draw_stars(int16_t dx, int16_t dy);
 
+// Take the star field off screen at the end of a game
+void stop_stars(void);
+
 #endif // BKGSTARS_H
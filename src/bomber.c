@@ -8,23 +8,25 @@
 #include "graphics.h"
 #include "bomber.h"
 #include "player.h"
+#include "sprite_shadow.h"
+#include "motion.h"
+#include "camera.h"
 
 // Bomber State
 typedef struct {
     bool active;
-    int16_t x, y;       // Integer screen/world coordinates
-    int16_t rx, ry;     // Remainders (Accumulators for sub-pixel movement)
+    int16_t x, y;       // World coordinates (see camera.h)
+    uint8_t x_frac, y_frac; // Sub-pixel position (see motion.h)
     int health;
 } bomber_t;
 
-#define BOMBER_SPEED_SUBPIXEL 20
+#define BOMBER_SPEED_SUBPIXEL 20  // Q8.8 pixels per frame
 
-extern int16_t scroll_dx, scroll_dy;
 extern int16_t earth_x, earth_y;
 
 bomber_t bomber = { .active = false };
 
-void spawn_bomber(int level) {
+void spawn_bomber(int16_t level) {
     if (bomber.active) return;
 
     bomber.active = true;
@@ -32,8 +34,8 @@ void spawn_bomber(int level) {
     bomber.health = 10 + (level * 5); 
 
     // Initialize remainders to 0 (center of pixel)
-    bomber.rx = 0;
-    bomber.ry = 0;
+    bomber.x_frac = 0;
+    bomber.y_frac = 0;
 
     // Spawn Logic: Pick a random edge of the World (1024x1024)
     // We want it far from Earth so it has to travel.
@@ -65,94 +67,61 @@ void spawn_bomber(int level) {
         // 50% chance for Top or Bottom
         bomber.y = (rand16() & 1) ? -WORLD_Y2 : WORLD_Y2;
     }
+    // Edges above are relative to the screen
+    bomber.x = world_x(bomber.x);
+    bomber.y = world_y(bomber.y);
 
     // Initialize Sprite Config (Mode 4 Swarm)
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, BOMBER_DATA);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, log_size, 3); // 3 = 8x8
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, BOMBER_DATA);
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, log_size, 3); // 3 = 8x8
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
     
     printf("WARNING: Bomber Spawned at %d, %d\n", (int)bomber.x, (int)bomber.y);
 }
 
 void update_bomber(void) {
     if (!bomber.active) {
-        xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
         return;
     }
 
     // ---------------------------------------------------------
-    // 1. MOVEMENT LOGIC (Integer + Remainder)
+    // 1. MOVEMENT LOGIC (Q8.8 Fixed Point)
     // ---------------------------------------------------------
     
     // X Axis Movement
-    if (bomber.x < earth_x) {
-        bomber.rx += BOMBER_SPEED_SUBPIXEL;
-        if (bomber.rx >= 256) {
-            bomber.x++;
-            bomber.rx -= 256;
-        }
-    } else if (bomber.x > earth_x) {
-        bomber.rx -= BOMBER_SPEED_SUBPIXEL;
-        if (bomber.rx <= -256) {
-            bomber.x--;
-            bomber.rx += 256;
-        }
+    int16_t to_earth_x = world_delta(earth_x, bomber.x);
+    if (to_earth_x > 0) {
+        motion_step(&bomber.x, &bomber.x_frac, BOMBER_SPEED_SUBPIXEL);
+    } else if (to_earth_x < 0) {
+        motion_step(&bomber.x, &bomber.x_frac, -BOMBER_SPEED_SUBPIXEL);
     }
 
     // Y Axis Movement
-    if (bomber.y < earth_y) {
-        bomber.ry += BOMBER_SPEED_SUBPIXEL;
-        if (bomber.ry >= 256) {
-            bomber.y++;
-            bomber.ry -= 256;
-        }
-    } else if (bomber.y > earth_y) {
-        bomber.ry -= BOMBER_SPEED_SUBPIXEL;
-        if (bomber.ry <= -256) {
-            bomber.y--;
-            bomber.ry += 256;
-        }
+    int16_t to_earth_y = world_delta(earth_y, bomber.y);
+    if (to_earth_y > 0) {
+        motion_step(&bomber.y, &bomber.y_frac, BOMBER_SPEED_SUBPIXEL);
+    } else if (to_earth_y < 0) {
+        motion_step(&bomber.y, &bomber.y_frac, -BOMBER_SPEED_SUBPIXEL);
     }
 
     // ---------------------------------------------------------
-    // 2. APPLY SCROLL (Camera Movement)
+    // 2. WORLD WRAPPING
     // ---------------------------------------------------------
-    // Since everything is integers now, this is perfectly accurate
-    bomber.x -= scroll_dx;
-    bomber.y -= scroll_dy;
-
-    // ---------------------------------------------------------
-    // 3. WORLD WRAPPING
-    // ---------------------------------------------------------
-    // Wrap Earth horizontally
-    if (earth_x <= -WORLD_X2) {
-        earth_x += WORLD_X;
-        bomber.x += WORLD_X;
-    } else if (earth_x > WORLD_X2) {
-        earth_x -= WORLD_X;
-        bomber.x -= WORLD_X;
-    }
-    
-    // Wrap Earth vertically
-    if (earth_y <= -WORLD_Y2) {
-        earth_y += WORLD_Y;
-        bomber.y += WORLD_Y;
-    } else if (earth_y > WORLD_Y2) {
-        earth_y -= WORLD_Y;
-        bomber.y -= WORLD_Y;
-    }
+    // Keep Earth within a world's width of the camera; the bomber moves with it
+    bomber.x += camera_wrap_x(&earth_x, -WORLD_X2, WORLD_X2);
+    bomber.y += camera_wrap_y(&earth_y, -WORLD_Y2, WORLD_Y2);
 
     // printf("Bomber Pos: %d, %d | Earth Pos: %d, %d\n", (int)bomber.x, (int)bomber.y, (int)earth_x, (int)earth_y);
 
     // ---------------------------------------------------------
-    // 4. RENDER
+    // 3. RENDER
     // ---------------------------------------------------------
-    // No casting needed, values are stable integers
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, x_pos_px, bomber.x);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, bomber.y);
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, x_pos_px, screen_x(bomber.x));
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, screen_y(bomber.y));
 
     // ---------------------------------------------------------
-    // 5. COLLISION (Using Earth struct properties)
+    // 4. COLLISION (Using Earth struct properties)
     // ---------------------------------------------------------
     // Simple box check (Bomber 8x8 vs Earth 32x32)
     // We check center points or overlapping boxes
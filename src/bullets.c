@@ -8,11 +8,18 @@
 #include "sbullets.h"
 #include "asteroids.h"
 #include <stdio.h>
+#include "sprite_shadow.h"
+#include "motion.h"
+#include "pool.h"
+#include "scheduler.h"
+#include "camera.h"
 
 // ============================================================================
 // CONSTANTS
 // ============================================================================
 
+#define BULLET_ROCKS_PERIOD 2   // Frames between asteroid checks
+
 // ============================================================================
 // EXTERNAL DEPENDENCIES
 // ============================================================================
@@ -40,11 +47,7 @@ extern bool check_asteroid_hit(int16_t x, int16_t y);
 
 // Player bullets (exported for use by player.c)
 Bullet bullets[MAX_BULLETS];
-uint8_t current_bullet_index = 0;
-int16_t active_bullet_count = 0;  // Track active bullets for optimization (exported)
-
-// Dirty flags: track which sprites need XRAM updates (1 bit per bullet)
-static uint8_t bullet_sprite_dirty = 0xFF; // All dirty initially
+pool_t bullet_pool;             // Live bullet slots (exported)
 
 // Spread shot bullets (internal to this module for now)
 static Bullet sbullets[MAX_SBULLETS];
@@ -57,15 +60,14 @@ static Bullet sbullets[MAX_SBULLETS];
 
 void init_bullets(void)
 {
-    active_bullet_count = 0;
+    pool_init(&bullet_pool, MAX_BULLETS);
+    sched_register(SCHED_BULLET_ROCKS, BULLET_ROCKS_PERIOD, MAX_BULLETS, SCHED_COST_HEAVY);
     for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        bullets[i].status = -1;
         bullets[i].x = 0;
         bullets[i].y = 0;
-        bullets[i].vx_rem = 0;
-        bullets[i].vy_rem = 0;
+        bullets[i].x_frac = 0;
+        bullets[i].y_frac = 0;
     }
-    bullet_sprite_dirty = 0xFF; // Mark all for initial cleanup
     
     // Note: ebullets initialized in init_fighters()
     
@@ -74,88 +76,69 @@ void init_bullets(void)
     }
 }
 
+/**
+ * Free a bullet slot and hide its sprite
+ */
+static void kill_bullet(uint8_t i)
+{
+    pool_free(&bullet_pool, i);
+    unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
+    sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+}
+
 void update_bullets(void)
 {
-    // Early exit if no active bullets
-    if (active_bullet_count == 0) {
-        // Still need to clean up any dirty sprites
-        if (bullet_sprite_dirty != 0) {
-            for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-                uint8_t mask = 1 << i;
-                if (bullet_sprite_dirty & mask) {
-                    unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-                    xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-                    bullet_sprite_dirty &= ~mask;
-                }
-            }
-        }
-        return;
-    }
+    uint8_t rocks_slot = sched_slot(SCHED_BULLET_ROCKS, game_frame);
     
-    for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        uint8_t mask = 1 << i;
-        
-        if (bullets[i].status < 0) {
-            // Only update sprite if dirty (just became inactive)
-            if (bullet_sprite_dirty & mask) {
-                unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-                bullet_sprite_dirty &= ~mask; // Clear dirty flag
-            }
-            continue;  // Bullet is inactive
-        }
+    // Walk live bullets only (backwards, so kill_bullet() is safe)
+    for (uint8_t k = bullet_pool.count; k-- > 0; ) {
+        uint8_t i = bullet_pool.live[k];
         
         // Check collision with fighters before moving
         if (check_bullet_fighter_collision(bullets[i].x, bullets[i].y, &player_score, &game_score)) {
             // Hit! Remove bullet
-            bullets[i].status = -1;
-            active_bullet_count--;
-            bullet_sprite_dirty |= mask; // Mark for cleanup next frame
-            goto next_bullet;  // Skip rest of bullet update
+            kill_bullet(i);
+            continue;
         }
 
         // Interleaved asteroid collision: Check every other bullet per frame
         // This reduces checks from 8/frame to ~4/frame
-        if ((i & 1) == (game_frame & 1)) {
-            if (check_asteroid_hit(bullets[i].x, bullets[i].y)) {
-                bullets[i].status = -1; // Kill bullet
-                active_bullet_count--;
-                bullet_sprite_dirty |= mask; // Mark for cleanup
-                goto next_bullet; // Move to next bullet
+        if ((i % BULLET_ROCKS_PERIOD) == rocks_slot) {
+            // Bullets fly in screen space, asteroids live in the world
+            if (check_asteroid_hit(world_x(bullets[i].x), world_y(bullets[i].y))) {
+                kill_bullet(i);
+                continue;
             }
         }
         
-        // Get velocity components based on bullet direction
-        int16_t bvx = -sin_fix[bullets[i].status];
-        int16_t bvy = -cos_fix[bullets[i].status];
-        
-        // Apply velocity with fixed-point math (divide by 64 for bullet speed)
-        int16_t bvx_applied = (bvx + bullets[i].vx_rem) >> 6;
-        int16_t bvy_applied = (bvy + bullets[i].vy_rem) >> 6;
-        
-        // Update remainder
-        bullets[i].vx_rem = bvx + bullets[i].vx_rem - (bvx_applied << 6);
-        bullets[i].vy_rem = bvy + bullets[i].vy_rem - (bvy_applied << 6);
+        // Get velocity components based on bullet direction (table value / 64 for bullet speed)
+        q88_t bvx = Q88_FROM_SHIFT(-sin_fix[bullets[i].status], 6);
+        q88_t bvy = Q88_FROM_SHIFT(-cos_fix[bullets[i].status], 6);
         
         // Update bullet position
-        bullets[i].x += bvx_applied;
-        bullets[i].y += bvy_applied;
+        motion_step(&bullets[i].x, &bullets[i].x_frac, bvx);
+        motion_step(&bullets[i].y, &bullets[i].y_frac, bvy);
         
         // Check if bullet is still on screen
         if (bullets[i].x > 0 && bullets[i].x < SCREEN_WIDTH && 
             bullets[i].y > 0 && bullets[i].y < SCREEN_HEIGHT) {
             // Update sprite hardware position (always update active bullets)
             unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, bullets[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, bullets[i].y);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, bullets[i].x);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, bullets[i].y);
         } else {
             // Bullet went off screen, deactivate it
-            bullets[i].status = -1;
-            active_bullet_count--;
-            bullet_sprite_dirty |= mask; // Mark for cleanup
+            kill_bullet(i);
         }
-        
-    next_bullet:
-        continue;
     }
 }
+
+void move_bullets_offscreen(void)
+{
+    for (uint8_t k = 0; k < bullet_pool.count; k++) {
+        unsigned ptr = BULLET_CONFIG + bullet_pool.live[k] * sizeof(vga_mode4_sprite_t);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+    }
+    pool_init(&bullet_pool, MAX_BULLETS);
+}
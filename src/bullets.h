@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "constants.h"
+#include "pool.h"
 
 /**
  * bullets.h - Player bullet management system
@@ -13,8 +14,8 @@
 // Bullet structure
 typedef struct {
     int16_t x, y;           // Position
-    int16_t status;         // -1 = inactive, 0-23 = active with direction
-    int16_t vx_rem, vy_rem; // Velocity remainder for sub-pixel movement
+    int16_t status;         // Direction (0-23) while the slot is live
+    uint8_t x_frac, y_frac; // Sub-pixel position (see motion.h)
 } Bullet;
 
 /**
@@ -30,9 +31,13 @@ void init_bullets(void);
  */
 void update_bullets(void);
 
+/**
+ * Hide every live player bullet and free its slot
+ */
+void move_bullets_offscreen(void);
+
 // Exported for use by player.c
 extern Bullet bullets[MAX_BULLETS];
-extern uint8_t current_bullet_index;
-extern int16_t active_bullet_count;
+extern pool_t bullet_pool;
 
 #endif // BULLETS_H
@@ -0,0 +1,80 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <stdint.h>
+#include "motion.h"
+
+/**
+ * camera.h - World-space camera
+ *
+ * Entities keep stable world coordinates; the camera is the world
+ * position of the screen's top-left pixel and only moves when the player
+ * pushes past the scroll boundary. Screen positions are worked out where
+ * they are needed (sprite writes, on-screen tests, hits against screen
+ * space objects like player bullets) instead of every entity subtracting
+ * the scroll every frame.
+ *
+ * The world is 16 bits and wraps, so positions are only ever compared
+ * through their offset from the camera.
+ */
+
+extern int16_t camera_x, camera_y;
+
+/**
+ * World coordinate to screen coordinate
+ */
+static inline int16_t screen_x(int16_t wx)
+{
+    return (int16_t)((uint16_t)wx - (uint16_t)camera_x);
+}
+
+static inline int16_t screen_y(int16_t wy)
+{
+    return (int16_t)((uint16_t)wy - (uint16_t)camera_y);
+}
+
+/**
+ * Screen coordinate to world coordinate
+ */
+static inline int16_t world_x(int16_t sx)
+{
+    return (int16_t)((uint16_t)sx + (uint16_t)camera_x);
+}
+
+static inline int16_t world_y(int16_t sy)
+{
+    return (int16_t)((uint16_t)sy + (uint16_t)camera_y);
+}
+
+/**
+ * Offset from world coordinate b to world coordinate a, safe across the
+ * 16-bit wrap (use instead of a - b when comparing two world positions)
+ */
+static inline int16_t world_delta(int16_t a, int16_t b)
+{
+    return (int16_t)((uint16_t)a - (uint16_t)b);
+}
+
+/**
+ * Wrap a world position into the band [lo, hi] of screen coordinates
+ * (the play area that follows the camera); returns the distance moved
+ */
+static inline int16_t camera_wrap_x(int16_t *wx, int16_t lo, int16_t hi)
+{
+    int16_t sx = screen_x(*wx);
+    int16_t before = sx;
+    motion_wrap(&sx, lo, hi);
+    *wx = world_x(sx);
+    return sx - before;
+}
+
+static inline int16_t camera_wrap_y(int16_t *wy, int16_t lo, int16_t hi)
+{
+    int16_t sy = screen_y(*wy);
+    int16_t before = sy;
+    motion_wrap(&sy, lo, hi);
+    *wy = world_y(sy);
+    return sy - before;
+}
+
+#endif // CAMERA_H
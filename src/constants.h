@@ -14,6 +14,30 @@
 // XRAM Map Addresses
 
 // 0x0000 - 0xE100 57,600  Pixels  Background      320x180 Bitmap (8bpp)
+//
+// During gameplay the bitmap starts at row PLAYFIELD_TOP. The rows above
+// sit under the HUD, so their XRAM is lent out until the title screen
+// reloads its image (LOWRES_BITMAP builds put their two pages after it):
+// 0x0000 - 0x0960 2,400   Data    Text Overlay    40x20 chars x 3 bytes
+// 0x0960 - 0x09E0 128     Data    Star Map        16x8 tiles (TILE_STARS)
+// 0x09E0 - 0x0B20 320     Pixels  Star Tiles      5 tiles 16x16 (2bpp, TILE_STARS)
+// 0x0B20 - 0x0DC0 672     Gap
+// 0x0DC0 - 0xE100 54,080  Pixels  Playfield       Rows 11-179
+//
+// PREROTATED_SHIP builds start the playfield at row 19 instead:
+// 0x0B20 - 0x1720 3,072   Pixels  Ship Frames     24 rotations 8x8 (16bpp)
+// 0x1720 - 0x17C0 160     Gap
+// 0x17C0 - 0xE100 51,520  Pixels  Playfield       Rows 19-179
+#ifdef PREROTATED_SHIP
+#define PLAYFIELD_TOP     19
+#else
+#define PLAYFIELD_TOP     11
+#endif
+#define OVERLAY_DATA      0x0000
+#define STAR_MAP_DATA     0x0960
+#define STAR_TILE_DATA    0x09E0
+#define SHIP_FRAMES_DATA  0x0B20
+#define SHIP_FRAME_BYTES  128
 
 // Sprite locations
 // 0xE100 - 0xE180 128     Pixels  Spaceship       8x8 (16bpp)
@@ -35,20 +59,18 @@
 #define GAMEPAD_INPUT   0xE9D0 // XRAM address for gamepad data
 #define KEYBOARD_INPUT  0xE9F8  // XRAM address for keyboard data
 
-// 0xEA20 - 0xEA2E 14      Config  Bitmap Config   Plane 0 Setup
-// 0xEA2E - 0xEA36 8       Config  Earth Config    Plane 2 Setup
-// 0xEA36 - 0xEA56 32      Config  Spaceship       Start of Plane 1 Swarm (Affine)
-// 0xEA56 - 0xEA96 64      Config  Asteroid L      2 Sprites (Affine)  
-// 0xEA96 - 0xEB96 256     Config  Fighters        32 sprites (Standard)
-// 0xEB96 - 0xEC16 128     Config  E-Bullets       16 sprites
-// 0xEC16 - 0xEC56 64      Config  P-Bullets       8 sprites
-// 0xEC56 - 0xEC6E 24      Config  S-Bullets       3 sprites
-// 0xEC6E - 0xEC76 8       Config  Powerup         1 sprite
-// 0xEC76 - 0xEC7E 8       Config  Bomber          1 sprite
-// 0xEC7E - 0xEC86 8       Config  Marker          1 sprite
+// 0xEA20 - 0xEA2E 14      Config  Bitmap Config   Plane 1 Setup
+// 0xEA2E - 0xEA42 20      Config  Spaceship       Plane 2 affine list
+// 0xEA42 - 0xEA6A 40      Config  Asteroid L      2 Sprites (Affine)
+// 0xEA6A - 0xEA72 8       Config  Earth Config    Plane 0 Setup
+// 0xEA72 - 0xEC72 512     Config  Sprite List     64 shared slots (Standard, see sprite_mux.h)
+// Fighters, bullets, power-up, bomber, asteroids M/S and explosions have
+// no XRAM configs of their own: their *_CONFIG values are sprite_mux
+// handles, and the mux copies whichever are on screen into the slots.
 #define VGA_CONFIG_START 0xEA20         //Start of graphic config addresses (after gamepad and keyboard data)
 extern unsigned BITMAP_CONFIG;          //Bitmap Config 
 extern unsigned SPACECRAFT_CONFIG;      //Spacecraft Sprite Config - Affine 
+extern unsigned SPRITE_LIST_CONFIG;     //Shared regular sprite slots
 extern unsigned EARTH_CONFIG;           //Earth Sprite Config - Standard 
 extern unsigned ASTEROID_L_CONFIG;      //Asteroid L Sprite Config - Affine
 extern unsigned STATION_CONFIG;         //Enemy station sprite config
@@ -61,24 +83,26 @@ extern unsigned POWERUP_CONFIG;         // Powerup sprite config
 extern unsigned BOMBER_CONFIG;          // Bomber Sprite (8x8)
 extern unsigned EXPLOSION_CONFIG;       // Explosion sprite configs
 
-// 0xEC86 - 0xECA6 32      Config  Asteroid M      4 Sprites (Standard)
-// 0xECA6 - 0xECE6 64      Config  Asteroid S      8 Sprites (Standard)
 extern unsigned ASTEROID_L_CONFIG;
 extern unsigned ASTEROID_M_CONFIG;
 extern unsigned ASTEROID_S_CONFIG;
 
-// 0xEC46 - 0xEC56 16      Config  Text Config     Plane 2 Overlay
-// 0xEC56 - 0xED2E 216     Data    Text Buffer     72 chars x 3 bytes
-// 0xED2E - 0xED40 18      Gap     Safety Padding
+// 0xEC72 - 0xEC82 16      Config  Text Config     Plane 2 HUD rows
+// 0xEC82 - 0xED5A 216     Data    Text Buffer     72 chars x 3 bytes
 extern unsigned TEXT_CONFIG;            //On screen text configs
 extern unsigned text_message_addr;
 
-// 0xEDCE - 0xF000 562     Gap     FreeSpace
+// 0xED5A - 0xEE20 198     Gap
+// 0xEE20 - 0xEE30 16      Config  Text Overlay    Plane 2 below the HUD rows
+// 0xEE30 - 0xEE40 16      Config  Star Plane      Plane 0 tile layer (TILE_STARS)
+// 0xEE40 - 0xEF40 256     Pixels  Explosion       Fighter explosion frames
+// 0xEF40 - 0xEFC0 128     Pixels  Powerup         8x8 (16bpp)
+// 0xEFC0 - 0xF000 64      Gap
+#define OVERLAY_CONFIG    0xEE20
+#define STAR_PLANE_CONFIG 0xEE30
 
 // 0xF000 - 0xF200 512     Palette 
 
-// 0xF200 - 0xF300 256     Pixels  Explosion       4x32 Anim Strip
-// 0xF300 - 0xF380 128     Pixels  Powerup         8x8 (16bpp)
 // 0xF380 - 0xF400 128     Pixels  Bomber          8x8 (16bpp)
 // 0xF400 - 0xF480 128     Pixels  Marker          8x8 (16bpp)
 #define EXPLOSION_DATA  0xEE40    // Sprite data for explosion animation (not config data)
@@ -93,6 +117,8 @@ extern unsigned text_message_addr;
 #define ASTEROID_S_DATA   0xFC00  // Asteroid S Sprite Data (8x8)
 
 // 0xFE80 - 0xFFC0 320     Gap     Space  Room for ~2 more 16x16 sprites
+// 0xFD00 - 0xFF88 648     Text    HUD + profiler rows (ENABLE_PROFILER builds only)
+#define PROFILER_TEXT_ADDR 0xFD00
 // 0xFFC0 - 0xFFFF 64      Config  Sound (PSG) Safety Anchor
 #define PSG_XRAM_ADDR   0xFFC0    // PSG memory location (must match sound.c)
 
@@ -228,6 +254,19 @@ extern int16_t enemy_score;
 #define BLOCK2_ATTR 0x03 // yellow
 #define BLOCK_EMPTY_ATTR 0x08 // grey
 
+// HUD text plane size (chars); profiler builds add rows for the timing bars
+#define MESSAGE_WIDTH 36
+#ifdef PROFILER
+#define PROFILER_ROWS 4
+#define MESSAGE_HEIGHT (2 + PROFILER_ROWS)
+#else
+#define MESSAGE_HEIGHT 2
+#endif
+
+// Scanlines taken by the HUD rows (y_pos_px 1, 8-pixel font); the message
+// overlay has the rest of plane 2
+#define HUD_SCANLINES (1 + 8 * MESSAGE_HEIGHT)
+
 // Level text buffer length (chars)
 #define LEVEL_MESSAGE_LENGTH 10
 
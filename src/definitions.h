@@ -10,8 +10,6 @@
 #define NTEXT 1
 static char score_message[6] = "SCORE ";
 static char score_value[6] = "00000";
-#define MESSAGE_WIDTH 36
-#define MESSAGE_HEIGHT 2
 #define MESSAGE_LENGTH (MESSAGE_WIDTH * MESSAGE_HEIGHT)
 static char message[MESSAGE_LENGTH]; 
 static char level_message[6] = "LEVEL";
@@ -0,0 +1,78 @@
+/*
+ * direction.c - Vector to rotation index quantizer
+ *
+ * sin_fix/cos_fix have the symmetry of the square, so the vector is folded
+ * into the first octant (0 <= w <= u), placed between the tangents of the
+ * sector boundaries from direction_table.h, and the octant sector is
+ * unfolded back to a rotation index. A vector exactly on a boundary ties
+ * two directions and takes the lower index, like the old dot product scan.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "constants.h"
+#include "direction.h"
+#include "direction_table.h"
+
+// Octant sector k (0 = along the octant's start axis) to rotation index
+static uint8_t unfold(uint8_t octant, uint8_t k)
+{
+    switch (octant) {
+        case 0:  return k;
+        case 1:  return 2 * DIR_OCTANT_STEPS - k;
+        case 2:  return 2 * DIR_OCTANT_STEPS + k;
+        case 3:  return 4 * DIR_OCTANT_STEPS - k;
+        case 4:  return 4 * DIR_OCTANT_STEPS + k;
+        case 5:  return 6 * DIR_OCTANT_STEPS - k;
+        case 6:  return 6 * DIR_OCTANT_STEPS + k;
+        default: return k ? 8 * DIR_OCTANT_STEPS - k : 0;
+    }
+}
+
+uint8_t direction_from_vector(int16_t x, int16_t y)
+{
+    if (x == 0 && y == 0) {
+        return 0;
+    }
+
+    // Fold: octants 0-7 counter-clockwise from +x, with (u, w) the
+    // distance along / away from the octant's start axis
+    uint16_t ax = x < 0 ? -(uint16_t)x : (uint16_t)x;
+    uint16_t ay = y < 0 ? -(uint16_t)y : (uint16_t)y;
+    uint8_t octant;
+    uint16_t u, w;
+    if (y >= 0) {
+        if (x >= 0) {
+            octant = ay <= ax ? 0 : 1;
+        } else {
+            octant = ay > ax ? 2 : 3;
+        }
+    } else {
+        if (x < 0) {
+            octant = ay <= ax ? 4 : 5;
+        } else {
+            octant = ay > ax ? 6 : 7;
+        }
+    }
+    if (ay <= ax) {
+        u = ax;
+        w = ay;
+    } else {
+        u = ay;
+        w = ax;
+    }
+
+    for (uint8_t k = 0; k < DIR_OCTANT_STEPS; k++) {
+        uint32_t lhs = (uint32_t)w * dir_bound_den[k];
+        uint32_t rhs = (uint32_t)u * dir_bound_num[k];
+        if (lhs < rhs) {
+            return unfold(octant, k);
+        }
+        if (lhs == rhs) {
+            uint8_t a = unfold(octant, k);
+            uint8_t b = unfold(octant, k + 1);
+            return a < b ? a : b;
+        }
+    }
+    return unfold(octant, DIR_OCTANT_STEPS);
+}
@@ -0,0 +1,14 @@
+#ifndef DIRECTION_H
+#define DIRECTION_H
+
+#include <stdint.h>
+
+/**
+ * Quantize a vector to one of the SHIP_ROTATION_STEPS directions: returns
+ * the index j that maximizes x * cos_fix[j] + y * sin_fix[j], lowest index
+ * on ties and 0 for a zero vector - the same answer as scanning all steps,
+ * without any 32-bit multiplies
+ */
+uint8_t direction_from_vector(int16_t x, int16_t y);
+
+#endif // DIRECTION_H
@@ -0,0 +1,14 @@
+// Generated by tools/gen_direction_table.py from sin_fix/cos_fix - do not edit
+#ifndef DIRECTION_TABLE_H
+#define DIRECTION_TABLE_H
+
+#include <stdint.h>
+
+#define DIR_OCTANT_STEPS 3
+
+// Sector boundaries inside the first octant (0 <= w <= u): the vector
+// is past boundary k when w * dir_bound_den[k] > u * dir_bound_num[k]
+static const uint8_t dir_bound_num[DIR_OCTANT_STEPS] = { 9, 13, 40 };
+static const uint8_t dir_bound_den[DIR_OCTANT_STEPS] = { 65, 31, 53 };
+
+#endif // DIRECTION_TABLE_H
@@ -1,25 +1,32 @@
 #include "explosions.h"
 #include "constants.h" // EXPLOSION_DATA
-#include "player.h" // scroll_x, scroll_y, random
+#include "player.h" // random
 #include "random.h"
 #include <rp6502.h>
 #include <stdlib.h>
+#include "sprite_shadow.h"
+#include "motion.h"
+#include "pool.h"
+#include "camera.h"
+#include "anim.h"
 
 explosion_t explosions[MAX_EXPLOSIONS];
 extern unsigned EXPLOSION_CONFIG;
-int16_t active_explosion_count = 0;
+static pool_t explosion_pool;
 
 // ---------------------------------------------------------
 // INIT
 // ---------------------------------------------------------
 void init_explosions(void) {
     size_t size = sizeof(vga_mode4_sprite_t);
-    active_explosion_count = 0;
+    // Particles cut short keep their channels until they're handed back
+    for (uint8_t k = explosion_pool.count; k-- > 0; ) {
+        anim_stop(explosions[explosion_pool.live[k]].anim);
+    }
+    pool_init(&explosion_pool, MAX_EXPLOSIONS);
     for (int i = 0; i < MAX_EXPLOSIONS; i++) {
-        explosions[i].active = false;
-        
         unsigned ptr = EXPLOSION_CONFIG + (i * size);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
     }
 }
 
@@ -27,44 +34,35 @@ void init_explosions(void) {
 // SPAWN
 // ---------------------------------------------------------
 void start_explosion(int16_t x, int16_t y) {
-    int particles_spawned = 0;
     size_t size = sizeof(vga_mode4_sprite_t);
     
     // Try to spawn 4 particles for a nice cluster
-    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
-        if (!explosions[i].active) {
-            explosions[i].active = true;
-            active_explosion_count++;
-            
-            // Random scatter (-4 to +4 pixels)
-            explosions[i].x = x + (int16_t)random(0, 8) - 4;
-            explosions[i].y = y + (int16_t)random(0, 8) - 4;
-            
-            // Random Velocity (Explode outward)
-            explosions[i].vx = (rand16() & 1) ? random(10, 40) : -random(10, 40);
-            explosions[i].vy = (rand16() & 1) ? random(10, 40) : -random(10, 40);
-            
-            // Start at frame 1 (skip the "ship" frames 0/1)
-            explosions[i].frame = 1; 
-            explosions[i].timer = 0;
-
-            // --- CONFIG (Standard Sprite) ---
-            unsigned ptr = EXPLOSION_CONFIG + (i * size);
-            
-            // Calculate offset: 4x4 sprite = 16 pixels * 2 bytes = 32 bytes per frame
-            uint16_t offset = 2 * 32; 
+    for (int particle = 0; particle < 4; particle++) {
+        uint8_t i = pool_alloc(&explosion_pool);
+        if (i == POOL_NONE) break;
 
-            xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr,(uint16_t)(EXPLOSION_DATA + offset));
-            xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 2); // 4x4
-            xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-            
-            // Note: Position is set in update loop, or can set here initially
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, explosions[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, explosions[i].y);
+        // Random scatter (-4 to +4 pixels)
+        explosions[i].x = x + (int16_t)random(0, 8) - 4;
+        explosions[i].y = y + (int16_t)random(0, 8) - 4;
+        
+        explosions[i].x_frac = 0;
+        explosions[i].y_frac = 0;
+        
+        // Random Velocity (Explode outward), 1 to 4 pixels per frame
+        explosions[i].vx = (rand16() & 1) ? random(256, 1024) : -random(256, 1024);
+        explosions[i].vy = (rand16() & 1) ? random(256, 1024) : -random(256, 1024);
+        
+        // --- CONFIG (Standard Sprite) ---
+        unsigned ptr = EXPLOSION_CONFIG + (i * size);
 
-            particles_spawned++;
-            if (particles_spawned >= 4) break; 
-        }
+        // Skips the "ship" frames 0/1 and sets the first pointer
+        explosions[i].anim = anim_start(ptr, ANIM_PARTICLE);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 2); // 4x4
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        
+        // Note: Position is set in update loop, or can set here initially
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, screen_x(explosions[i].x));
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, screen_y(explosions[i].y));
     }
 }
 
@@ -73,48 +71,30 @@ void start_explosion(int16_t x, int16_t y) {
 // ---------------------------------------------------------
 void update_explosions(void) {
     // Early exit if no active explosions
-    if (active_explosion_count == 0) {
+    if (explosion_pool.count == 0) {
         return;
     }
     
     size_t size = sizeof(vga_mode4_sprite_t);
 
-    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
-        if (!explosions[i].active) continue;
+    for (uint8_t k = explosion_pool.count; k-- > 0; ) {
+        uint8_t i = explosion_pool.live[k];
 
-        // Move (Simple integer math for particles)
-        // Divide by 10 to slow down the subpixel velocity
-        explosions[i].x += (explosions[i].vx / 10); 
-        explosions[i].y += (explosions[i].vy / 10);
+        // Move
+        motion_step(&explosions[i].x, &explosions[i].x_frac, explosions[i].vx);
+        motion_step(&explosions[i].y, &explosions[i].y_frac, explosions[i].vy);
 
-        // Animation Timer
-        explosions[i].timer++;
-        if (explosions[i].timer > 4) { // Change frame every 4 ticks
-            explosions[i].timer = 0;
-            explosions[i].frame++;
-            
-            // Asset has 8 frames total (0-7). We use 2-7.
-            if (explosions[i].frame >= 8) {
-                // Done
-                explosions[i].active = false;
-                active_explosion_count--;
-                unsigned ptr = EXPLOSION_CONFIG + (i * size);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-                continue;
-            }
-            
-            // Update Pointer
-            unsigned ptr = EXPLOSION_CONFIG + (i * size);
-            uint16_t offset = explosions[i].frame * 32; 
-            xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, (uint16_t)(EXPLOSION_DATA + offset));
+        // Frames are stepped by animate_all(); done after the last one
+        unsigned ptr = EXPLOSION_CONFIG + (i * size);
+        if (!anim_running(explosions[i].anim)) {
+            anim_stop(explosions[i].anim);
+            pool_free(&explosion_pool, i);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            continue;
         }
 
         // Render
-        explosions[i].x -= scroll_dx;
-        explosions[i].y -= scroll_dy;
-        
-        unsigned ptr = EXPLOSION_CONFIG + (i * size);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, explosions[i].x);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, explosions[i].y);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, screen_x(explosions[i].x));
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, screen_y(explosions[i].y));
     }
 }
@@ -5,19 +5,16 @@
 #include <stdbool.h>
 
 typedef struct {
-    bool active;
-    int16_t x, y;
-    int16_t vx, vy;
-    uint8_t frame;
-    uint8_t timer;
+    int16_t x, y;           // World position (see camera.h)
+    uint8_t x_frac, y_frac; // Sub-pixel position (see motion.h)
+    int16_t vx, vy;         // Q8.8 pixels per frame
+    uint8_t anim;           // Animation channel (see anim.h)
 } explosion_t;
 
-#define MAX_EXPLOSIONS 16
-
-extern int16_t active_explosion_count;
+#define MAX_EXPLOSIONS 16  // Particle slots (handed out by a pool, see pool.h)
 
 void init_explosions(void);
 void update_explosions(void);
-void start_explosion(int16_t x, int16_t y);
+void start_explosion(int16_t x, int16_t y);  // World coordinates
 
 #endif
\ No newline at end of file
@@ -9,11 +9,21 @@
 #include <stdio.h>
 #include "powerup.h"
 #include "asteroids.h"
+#include "sprite_shadow.h"
+#include "direction.h"
+#include "motion.h"
+#include "pool.h"
+#include "scheduler.h"
+#include "camera.h"
+#include "anim.h"
 
 // ============================================================================
 // CONSTANTS
 // ============================================================================
 
+#define FIGHTER_RETARGET_PERIOD 60  // Frames between course corrections
+#define FIGHTER_ROCKS_PERIOD    4   // Frames between asteroid checks
+#define EBULLET_ROCKS_PERIOD    2   // Frames between asteroid checks
 
 // ============================================================================
 // TYPES
@@ -21,21 +31,21 @@
 
 typedef struct {
     int16_t x, y;
-    int16_t status;
-    int16_t vx_rem, vy_rem;
+    int16_t status;         // Direction (0-23) while the slot is live
+    uint8_t x_frac, y_frac;
 } Bullet;
 
 typedef struct {
     int16_t x, y;
     int16_t vx, vy;
-    int16_t vx_i, vy_i;
-    int16_t vx_rem, vy_rem;
+    int16_t vx_i, vy_i;     // Speeds are Q8.8 (see motion.h)
+    uint8_t x_frac, y_frac;
     int16_t status;
     int16_t dx, dy;
     int16_t frame;
     int16_t lx1, ly1;
     int16_t lx2, ly2;
-    int16_t anim_timer;
+    uint8_t anim;           // Explosion animation channel (see anim.h)
     bool is_exploding;
 } Fighter;
 
@@ -46,7 +56,6 @@ typedef struct {
 // Game state from main
 extern int16_t player_x, player_y;
 extern int16_t player_vx_applied, player_vy_applied;
-extern int16_t scroll_dx, scroll_dy;
 extern int16_t player_score;
 extern int16_t enemy_score;
 extern int16_t game_level;
@@ -73,6 +82,12 @@ extern bool check_asteroid_hit_fighter(int16_t fx, int16_t fy);
 #define FWORLD_X (FWORLD_X2 - FWORLD_X1)  // Total world width
 #define FWORLD_Y (FWORLD_Y2 - FWORLD_Y1)  // Total world height
 
+// Collision grid: 32x32 px buckets over the fighter world (screen + FWORLD_PAD)
+#define FGRID_SHIFT 5
+#define FGRID_W ((FWORLD_X >> FGRID_SHIFT) + 1)
+#define FGRID_H ((FWORLD_Y >> FGRID_SHIFT) + 1)
+#define FGRID_EMPTY 0xFF
+
 // Sound system (types defined in sound.h)
 extern void play_sound(uint8_t type, uint16_t frequency, uint8_t waveform, 
                        uint8_t attack, uint8_t decay, uint8_t sustain, uint8_t release);
@@ -85,8 +100,7 @@ static Bullet ebullets[MAX_EBULLETS];
 static uint16_t ebullet_cooldown = 0;
 static uint16_t max_ebullet_cooldown = INITIAL_EBULLET_COOLDOWN;
 static uint16_t fire_rate_adjustment = INITIAL_EBULLET_COOLDOWN; // Dynamic fire rate based on score
-static uint8_t current_ebullet_index = 0;
-static int16_t active_ebullet_count = 0;  // Track active ebullets for optimization
+static pool_t ebullet_pool;   // Live ebullet slots
 
 static Fighter fighters[MAX_FIGHTERS];
 int16_t active_fighter_count = 0;  // Non-static, may be used externally
@@ -95,27 +109,67 @@ int16_t active_fighter_count = 0;  // Non-static, may be used externally
 static int16_t fighter_speed_min = INITIAL_FIGHTER_SPEED_MIN;
 static int16_t fighter_speed_max = INITIAL_FIGHTER_SPEED_MAX;
 
+// Live fighters bucketed by cell, each list in ascending fighter index
+static uint8_t fgrid_head[FGRID_W * FGRID_H];
+static uint8_t fgrid_next[MAX_FIGHTERS];
+
 // ============================================================================
 // FUNCTIONS
 // ============================================================================
 
-#define FIGHTER_BYTES_PER_FRAME 32  // 4x4 pixels * 2 bytes per pixel
-
-void set_fighter_frame(uint8_t fighter_idx, uint8_t frame_idx) {
-    if (fighter_idx >= MAX_FIGHTERS) return; // Safety check
+/**
+ * Put a fighter back on the intact ship (frame 0 of the sheet)
+ */
+static void reset_fighter_frame(uint8_t i)
+{
+    anim_stop(fighters[i].anim);
+    fighters[i].anim = ANIM_NONE;
+    fighters[i].is_exploding = false;
+    unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
+    sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, EXPLOSION_DATA);
+}
 
-    // 1. Calculate address of the specific fighter's configuration struct
-    unsigned sprite_config_ptr = FIGHTER_CONFIG + (fighter_idx * sizeof(vga_mode4_sprite_t));
+/**
+ * Start a destroyed fighter's explosion frames
+ */
+static void start_fighter_explosion(uint8_t i)
+{
+    fighters[i].is_exploding = true;
+    fighters[i].anim = anim_start(FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t),
+                                  ANIM_FIGHTER_EXPLODE);
+}
 
-    // 2. Calculate address of the specific frame image data
-    //    Address = Start of Sheet + (Frame Number * Bytes per Frame)
-    unsigned image_data_ptr = EXPLOSION_DATA + (frame_idx * FIGHTER_BYTES_PER_FRAME);
 
-    // 3. Update the pointer in XRAM
-    //    We only change where this specific sprite looks for pixels
-    xram0_struct_set(sprite_config_ptr, vga_mode4_sprite_t, xram_sprite_ptr, image_data_ptr);
+/**
+ * Bucket index along one axis; positions off the grid land in the edge cells
+ */
+static uint8_t fgrid_cell(int16_t offset, uint8_t cells)
+{
+    if (offset < 0) return 0;
+    offset >>= FGRID_SHIFT;
+    return offset >= cells ? cells - 1 : (uint8_t)offset;
 }
 
+/**
+ * Rebuild the collision grid from the live fighters' positions
+ */
+static void build_fighter_grid(void)
+{
+    for (uint8_t c = 0; c < FGRID_W * FGRID_H; c++) {
+        fgrid_head[c] = FGRID_EMPTY;
+    }
+
+    // Insert from the top so each bucket ends up in ascending index order
+    for (int8_t i = MAX_FIGHTERS - 1; i >= 0; i--) {
+        if (fighters[i].status <= 0) continue;
+
+        // Bucket by screen position, the space player bullets live in
+        uint8_t c = fgrid_cell(screen_y(fighters[i].y) - FWORLD_Y1, FGRID_H) * FGRID_W +
+                    fgrid_cell(screen_x(fighters[i].x) - FWORLD_X1, FGRID_W);
+        fgrid_next[i] = fgrid_head[c];
+        fgrid_head[c] = i;
+    }
+}
 
 void init_fighters(void)
 {
@@ -125,9 +179,8 @@ void init_fighters(void)
         fighters[i].vx = 0;
         fighters[i].vy = 0;
         fighters[i].status = 1;
-        fighters[i].is_exploding = false; // Not exploding at start
-        fighters[i].anim_timer = 0; // Initialize animation timer
-        set_fighter_frame(i, 0); // Points back to the first image in the sheet (Normal ship)
+        fighters[i].anim = ANIM_NONE;   // anim_init() freed every channel
+        reset_fighter_frame(i);
 
         uint8_t edge = random(0, 4);  // 0=right, 1=left, 2=top, 3=bottom
                 
@@ -148,33 +201,36 @@ void init_fighters(void)
             fighters[i].x = random(20, SCREEN_WIDTH - 20);
             fighters[i].y = -random(FWORLD_PAD_D2, FWORLD_PAD);
         }
+        // Edges above are relative to the screen
+        fighters[i].x = world_x(fighters[i].x);
+        fighters[i].y = world_y(fighters[i].y);
         
-        fighters[i].vx_rem = 0;
-        fighters[i].vy_rem = 0;
+        fighters[i].x_frac = 0;
+        fighters[i].y_frac = 0;
         fighters[i].dx = 0;
         fighters[i].dy = 0;
         fighters[i].frame = random(0, 1);
     }
     active_fighter_count = MAX_FIGHTERS;
+    build_fighter_grid();
+    
+    // Spread the periodic per-fighter work over the frame cycle
+    sched_register(SCHED_FIGHTER_RETARGET, FIGHTER_RETARGET_PERIOD, MAX_FIGHTERS, SCHED_COST_MEDIUM);
+    sched_register(SCHED_FIGHTER_ROCKS, FIGHTER_ROCKS_PERIOD, MAX_FIGHTERS, SCHED_COST_HEAVY);
+    sched_register(SCHED_EBULLET_ROCKS, EBULLET_ROCKS_PERIOD, MAX_EBULLETS, SCHED_COST_HEAVY);
     
     // Initialize ebullets
-    active_ebullet_count = 0;
+    pool_init(&ebullet_pool, MAX_EBULLETS);
     for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        ebullets[i].status = -1;
         ebullets[i].x = 0;
         ebullets[i].y = 0;
-        ebullets[i].vx_rem = 0;
-        ebullets[i].vy_rem = 0;
+        ebullets[i].x_frac = 0;
+        ebullets[i].y_frac = 0;
     }
 }
 
 void update_fighters(void)
 {
-    int16_t fvx_applied, fvy_applied;
-    
-    int16_t player_world_x = player_x;
-    int16_t player_world_y = player_y;
-    
     // Dynamic fire rate adjustment based on score difference (rubber-banding)
     // If player is behind by significant margin, slow down enemy fire rate to help them catch up
     int16_t score_diff = enemy_score - player_score;
@@ -195,26 +251,23 @@ void update_fighters(void)
     //     printf(fighters[i].status ? "active\n" : "inactive\n");
     // }
 
+    // Which fighters get the periodic work this frame
+    uint8_t retarget_slot = sched_slot(SCHED_FIGHTER_RETARGET, game_frame);
+    uint8_t rocks_slot = sched_slot(SCHED_FIGHTER_ROCKS, game_frame);
+
     for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
 
-        if (fighters[i].is_exploding) {
-            fighters[i].anim_timer++;
-    
-            // Slow down animation (e.g., change frame every 4 ticks)
-            uint8_t current_frame = fighters[i].anim_timer / 4;
-            
-            if (current_frame < 8) {
-                set_fighter_frame(i, current_frame);
-            } else {
-                // Animation done, kill fighter or respawn
-                fighters[i].is_exploding = false;
-                // Move sprite offscreen immediately when explosion finishes
-                unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            }
+        // Frames are stepped by animate_all(); this only handles the end
+        if (fighters[i].is_exploding && !anim_running(fighters[i].anim)) {
+            anim_stop(fighters[i].anim);
+            fighters[i].anim = ANIM_NONE;
+            fighters[i].is_exploding = false;
+            // Move sprite offscreen immediately when explosion finishes
+            unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
 
-            if (current_frame == 8 && !powerup.active) {
+            if (!powerup.active) {
                 int16_t drop_chance = random(0, 100);
                 if (drop_chance < POWERUP_DROP_CHANCE_PERCENT) {
                     powerup.active = true;
@@ -251,47 +304,45 @@ void update_fighters(void)
                     fighters[i].x = random(20, SCREEN_WIDTH - 20);
                     fighters[i].y = -random(FWORLD_PAD_D2, FWORLD_PAD);
                 }
+                // Edges above are relative to the screen
+                fighters[i].x = world_x(fighters[i].x);
+                fighters[i].y = world_y(fighters[i].y);
                 
                 fighters[i].status = 1;
-                fighters[i].is_exploding = false; // Reset exploding state
-                fighters[i].anim_timer = 0; // Initialize animation timer
-                set_fighter_frame(i, 0); // Points back to the first image in the sheet (Normal ship)
+                reset_fighter_frame(i);
                 active_fighter_count++;
             }
-            if (fighters[i].is_exploding) {
-                fighters[i].x -= scroll_dx;
-                fighters[i].y -= scroll_dy;
-            } 
             continue;
         }
 
-        fighters[i].x -= scroll_dx;
-        fighters[i].y -= scroll_dy;
+        // The player is in screen space
+        int16_t sx = screen_x(fighters[i].x);
+        int16_t sy = screen_y(fighters[i].y);
 
-        if (fighters[i].x + 4 > player_x && fighters[i].x < player_x + 8 &&
-            fighters[i].y + 4 > player_y && fighters[i].y < player_y + 8) {
+        if (sx + 4 > player_x && sx < player_x + 8 &&
+            sy + 4 > player_y && sy < player_y + 8) {
             fighters[i].status = 0;
             active_fighter_count--;
             enemy_score += 2;
-            fighters[i].is_exploding = true; // Start explosion sequence
+            start_fighter_explosion(i);
             continue;
         }
 
         // Inside update_fighters
-        if ((i % 4) == (game_frame % 4)) { 
+        if ((i % FIGHTER_ROCKS_PERIOD) == rocks_slot) {
             if (check_asteroid_hit_fighter(fighters[i].x, fighters[i].y)) {
                 fighters[i].status = 0;
                 active_fighter_count--;
                 // enemy_score += 2;
-                fighters[i].is_exploding = true; // Start explosion sequence
+                start_fighter_explosion(i);
                 continue;
                 // Do not give player points? Or give points for "Environment Kill"?
             }
         }
         
-        if (game_frame == 0) {
-            int16_t fdx = player_world_x - fighters[i].x;
-            int16_t fdy = player_world_y - fighters[i].y;
+        if ((i % FIGHTER_RETARGET_PERIOD) == retarget_slot) {
+            int16_t fdx = player_x - sx;
+            int16_t fdy = player_y - sy;
             
             if (fdx > 0) {
                 fighters[i].vx = fighters[i].vx_i;
@@ -310,17 +361,8 @@ void update_fighters(void)
             }
         }
         
-        fvx_applied = (fighters[i].vx + fighters[i].vx_rem) >> 8;
-        fvy_applied = (fighters[i].vy + fighters[i].vy_rem) >> 8;
-        
-        fighters[i].vx_rem = fighters[i].vx + fighters[i].vx_rem - (fvx_applied << 8);
-        fighters[i].vy_rem = fighters[i].vy + fighters[i].vy_rem - (fvy_applied << 8);
-        
-        fighters[i].dx = fvx_applied;
-        fighters[i].dy = fvy_applied;
-        
-        fighters[i].x += fvx_applied;
-        fighters[i].y += fvy_applied;
+        fighters[i].dx = motion_step(&fighters[i].x, &fighters[i].x_frac, fighters[i].vx);
+        fighters[i].dy = motion_step(&fighters[i].y, &fighters[i].y_frac, fighters[i].vy);
 
         // if (fighters[i].x > FIGHTER_WORLD_X2) {
         //     fighters[i].x -= FIGHTER_WORLD_X;
@@ -333,11 +375,13 @@ void update_fighters(void)
         // } else if (fighters[i].y < -FIGHTER_WORLD_Y2) {
         //     fighters[i].y += FIGHTER_WORLD_Y;
         // }
-        if (fighters[i].x < FWORLD_X1) fighters[i].x += FWORLD_X; else if (fighters[i].x > FWORLD_X2) fighters[i].x -= FWORLD_X;
-        if (fighters[i].y < FWORLD_Y1) fighters[i].y += FWORLD_Y; else if (fighters[i].y > FWORLD_Y2) fighters[i].y -= FWORLD_Y;
+        camera_wrap_x(&fighters[i].x, FWORLD_X1, FWORLD_X2);
+        camera_wrap_y(&fighters[i].y, FWORLD_Y1, FWORLD_Y2);
 
     }
 
+    build_fighter_grid();
+
     // for (uint8_t i = 0; i < 1; i++) {
     //     printf("Fighter %d position 2: x=%d, y=%d\n", i, fighters[i].x, fighters[i].y);
     //     printf(fighters[i].status ? "active\n" : "inactive\n");
@@ -354,15 +398,18 @@ void fire_ebullet(void)
     // ebullet_cooldown = max_ebullet_cooldown; // NEBULLET_TIMER_MAX;
     ebullet_cooldown = fire_rate_adjustment; // Dynamic fire rate based on score (with rubber-banding)
     
-    if (ebullets[current_ebullet_index].status < 0) {
+    // Any free slot will do, not just the next one in rotation
+    if (ebullet_pool.count < MAX_EBULLETS) {
         for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
             if (fighters[i].status == 1) {  // A single ship is ready to fire
+                int16_t sx = screen_x(fighters[i].x);
+                int16_t sy = screen_y(fighters[i].y);
 
-                if (fighters[i].x > 0 && fighters[i].x < SCREEN_WIDTH - 4 &&
-                    fighters[i].y > 0 && fighters[i].y < SCREEN_HEIGHT - 4) {
+                if (sx > 0 && sx < SCREEN_WIDTH - 4 &&
+                    sy > 0 && sy < SCREEN_HEIGHT - 4) {
 
-                    int16_t fdx = player_x - fighters[i].x;
-                    int16_t fdy = -(player_y - fighters[i].y);
+                    int16_t fdx = player_x - sx;
+                    int16_t fdy = -(player_y - sy);
                     int16_t distance = abs(fdx) + abs(fdy);
                     
                     if (distance > 0) {
@@ -372,40 +419,27 @@ void fire_ebullet(void)
                         int16_t pre_player_x = player_x + 4 + (player_vx_applied * tti_frames);
                         int16_t pre_player_y = player_y + 4 + (player_vy_applied * tti_frames);
 
-                        fdx = pre_player_x - fighters[i].x;
-                        fdy = -pre_player_y + fighters[i].y;
-                        
-                        int16_t best_index = 0;
-                        int32_t max_dot = -8388608;
+                        fdx = pre_player_x - sx;
+                        fdy = -pre_player_y + sy;
                         
-                        for (uint8_t j = 0; j < SHIP_ROTATION_STEPS; j++) {
-                            int32_t current_dot = (int32_t)fdx * cos_fix[j] + (int32_t)fdy * sin_fix[j];
-                            if (current_dot > max_dot) {
-                                max_dot = current_dot;
-                                best_index = j;
-                            }
-                        }
+                        // Rotation step closest to the predicted intercept
+                        int16_t best_index = direction_from_vector(fdx, fdy);
                         
-                        ebullets[current_ebullet_index].status = best_index;
-                        ebullets[current_ebullet_index].x = fighters[i].x;
-                        ebullets[current_ebullet_index].y = fighters[i].y;
-                        ebullets[current_ebullet_index].vx_rem = 0;
-                        ebullets[current_ebullet_index].vy_rem = 0;
-                        active_ebullet_count++;
+                        uint8_t slot = pool_alloc(&ebullet_pool);
+                        ebullets[slot].status = best_index;
+                        ebullets[slot].x = fighters[i].x;
+                        ebullets[slot].y = fighters[i].y;
+                        ebullets[slot].x_frac = 0;
+                        ebullets[slot].y_frac = 0;
                         
-                        unsigned bullet_ptr = EBULLET_CONFIG + current_ebullet_index * sizeof(vga_mode4_sprite_t);
-                        xram0_struct_set(bullet_ptr, vga_mode4_sprite_t, x_pos_px, fighters[i].x);
-                        xram0_struct_set(bullet_ptr, vga_mode4_sprite_t, y_pos_px, fighters[i].y);
+                        unsigned bullet_ptr = EBULLET_CONFIG + slot * sizeof(vga_mode4_sprite_t);
+                        sprite_struct_set(bullet_ptr, vga_mode4_sprite_t, x_pos_px, sx);
+                        sprite_struct_set(bullet_ptr, vga_mode4_sprite_t, y_pos_px, sy);
 
                         play_sound(SFX_TYPE_ENEMY_FIRE, 440, PSG_WAVE_TRIANGLE, 0, 4, 3, 3);
                         
                         fighters[i].status = 2;
                         
-                        current_ebullet_index++;
-                        if (current_ebullet_index >= MAX_EBULLETS) {
-                            current_ebullet_index = 0;
-                        }
-                        
                         break;
                     }
                 }
@@ -422,7 +456,7 @@ void fire_ebullet(void)
 void update_ebullets(void)
 {
     // Early exit if no active ebullets
-    if (active_ebullet_count == 0) {
+    if (ebullet_pool.count == 0) {
         if (ebullet_cooldown > 0) {
             ebullet_cooldown--;
         }
@@ -434,69 +468,57 @@ void update_ebullets(void)
         ebullet_cooldown--;
     }
     
-    // Adjust for scrolling - only active bullets
-    for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        if (ebullets[i].status >= 0) {
-            ebullets[i].x -= scroll_dx;
-            ebullets[i].y -= scroll_dy;
-        }
-    }
+    uint8_t rocks_slot = sched_slot(SCHED_EBULLET_ROCKS, game_frame);
     
-    for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        if (ebullets[i].status < 0) {
-            continue;  // Skip inactive bullets entirely
-        }
+    for (uint8_t k = ebullet_pool.count; k-- > 0; ) {
+        uint8_t i = ebullet_pool.live[k];
         
         unsigned ptr = EBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
         
-        if (player_x < ebullets[i].x + 2 &&
-            player_x + 8 > ebullets[i].x &&
-            player_y < ebullets[i].y + 2 &&
-            player_y + 8 > ebullets[i].y) {
+        // The player is in screen space
+        int16_t sx = screen_x(ebullets[i].x);
+        int16_t sy = screen_y(ebullets[i].y);
+        
+        if (player_x < sx + 2 &&
+            player_x + 8 > sx &&
+            player_y < sy + 2 &&
+            player_y + 8 > sy) {
             
-            ebullets[i].status = -1;
-            active_ebullet_count--;
+            pool_free(&ebullet_pool, i);
             enemy_score++;
             
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             
             continue;
         }
 
-        if ((i & 1) == (game_frame & 1)) {
+        if ((i % EBULLET_ROCKS_PERIOD) == rocks_slot) {
             if (check_asteroid_hit_no_score(ebullets[i].x, ebullets[i].y)) {
                 // Hit!
-                ebullets[i].status = -1; // Kill bullet
-                active_ebullet_count--;
-                xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                pool_free(&ebullet_pool, i); // Kill bullet
+                sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
                 
                 continue; // Stop processing this bullet
             }
         }
         
-        int16_t bvx = cos_fix[ebullets[i].status];
-        int16_t bvy = -sin_fix[ebullets[i].status];
+        // Table value / 64 pixels per frame (~4 pixels/frame)
+        q88_t bvx = Q88_FROM_SHIFT(cos_fix[ebullets[i].status], 6);
+        q88_t bvy = Q88_FROM_SHIFT(-sin_fix[ebullets[i].status], 6);
         
-        int16_t bvx_applied = (bvx + ebullets[i].vx_rem) >> 6;
-        int16_t bvy_applied = (bvy + ebullets[i].vy_rem) >> 6;
+        sx += motion_step(&ebullets[i].x, &ebullets[i].x_frac, bvx);
+        sy += motion_step(&ebullets[i].y, &ebullets[i].y_frac, bvy);
         
-        ebullets[i].vx_rem = bvx + ebullets[i].vx_rem - (bvx_applied << 6);
-        ebullets[i].vy_rem = bvy + ebullets[i].vy_rem - (bvy_applied << 6);
-        
-        ebullets[i].x += bvx_applied;
-        ebullets[i].y += bvy_applied;
-        
-        if (ebullets[i].x > -10 && ebullets[i].x < SCREEN_WIDTH + 10 &&
-            ebullets[i].y > -10 && ebullets[i].y < SCREEN_HEIGHT + 10) {
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, ebullets[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, ebullets[i].y);
+        if (sx > -10 && sx < SCREEN_WIDTH + 10 &&
+            sy > -10 && sy < SCREEN_HEIGHT + 10) {
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, sx);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, sy);
         } else {
-            ebullets[i].status = -1;
-            active_ebullet_count--;
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            pool_free(&ebullet_pool, i);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
         }
     }
 }
@@ -507,12 +529,12 @@ void render_fighters(void)
         unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
         
         if (fighters[i].status > 0 || fighters[i].is_exploding) {
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, fighters[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, fighters[i].y);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, screen_x(fighters[i].x));
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, screen_y(fighters[i].y));
         } else if (fighters[i].status == 0) {
             // Only move offscreen on first frame of death (status just became 0)
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
         }
         // Skip fighters with status < 0 (already offscreen, respawning)
     }
@@ -523,8 +545,8 @@ void move_fighters_offscreen(void)
     for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
         // if (fighters[i].status > 0) {
             unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             fighters[i].status = 0;
         // }
     }
@@ -532,45 +554,72 @@ void move_fighters_offscreen(void)
 
 void move_ebullets_offscreen(void)
 {
-    for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        if (ebullets[i].status >= 0) {
-            unsigned ptr = EBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            ebullets[i].status = -1;
+    for (uint8_t k = 0; k < ebullet_pool.count; k++) {
+        unsigned ptr = EBULLET_CONFIG + ebullet_pool.live[k] * sizeof(vga_mode4_sprite_t);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+    }
+    pool_init(&ebullet_pool, MAX_EBULLETS);
+}
+
+/**
+ * Index of the first live fighter whose hit box contains the bullet, or
+ * FGRID_EMPTY. Only the grid cells the hit box can reach are searched.
+ */
+static uint8_t find_fighter_hit(int16_t bullet_x, int16_t bullet_y)
+{
+    // Hit box is bullet within [fx - 2, fx + 6) of the fighter, so only
+    // fighters with fx in [bx - 5, bx + 2] (screen coords) can be hit
+    int16_t wx = bullet_x - FWORLD_X1;
+    int16_t wy = bullet_y - FWORLD_Y1;
+    uint8_t gx0 = fgrid_cell(wx - 5, FGRID_W);
+    uint8_t gx1 = fgrid_cell(wx + 2, FGRID_W);
+    uint8_t gy0 = fgrid_cell(wy - 5, FGRID_H);
+    uint8_t gy1 = fgrid_cell(wy + 2, FGRID_H);
+
+    // Lowest matching index wins, as with the old linear scan. Buckets are
+    // ascending and end in FGRID_EMPTY, so "i < f" also ends each list.
+    uint8_t f = FGRID_EMPTY;
+    for (uint8_t gy = gy0; gy <= gy1; gy++) {
+        for (uint8_t gx = gx0; gx <= gx1; gx++) {
+            for (uint8_t i = fgrid_head[gy * FGRID_W + gx]; i < f; i = fgrid_next[i]) {
+                if (fighters[i].status <= 0) continue;
+
+                int16_t fighter_screen_x = screen_x(fighters[i].x);
+                int16_t fighter_screen_y = screen_y(fighters[i].y);
+
+                if (bullet_x >= fighter_screen_x - 2 && bullet_x < fighter_screen_x + 6 &&
+                    bullet_y >= fighter_screen_y - 2 && bullet_y < fighter_screen_y + 6) {
+                    f = i;
+                    break;
+                }
+            }
         }
     }
-    active_ebullet_count = 0;
+    return f;
 }
 
 bool check_bullet_fighter_collision(int16_t bullet_x, int16_t bullet_y, 
                                      int16_t* player_score_out, int16_t* game_score_out)
 {
-    for (uint8_t f = 0; f < MAX_FIGHTERS; f++) {
-        if (fighters[f].status > 0) {
-            int16_t fighter_screen_x = fighters[f].x - scroll_dx;
-            int16_t fighter_screen_y = fighters[f].y - scroll_dy;
-            
-            if (bullet_x >= fighter_screen_x - 2 && bullet_x < fighter_screen_x + 6 &&
-                bullet_y >= fighter_screen_y - 2 && bullet_y < fighter_screen_y + 6) {
-                
-                fighters[f].status = 0;
-                fighters[f].is_exploding = true; // Start explosion sequenc
-                active_fighter_count--;
-                
-                // Award points based on current level
-                *player_score_out += 1;
-                *game_score_out += game_level;
-                
-                // Track fighter kills
-                extern int16_t fighters_killed;
-                fighters_killed++;
-                
-                return true;
-            }
-        }
+    uint8_t f = find_fighter_hit(bullet_x, bullet_y);
+    if (f == FGRID_EMPTY) {
+        return false;
     }
-    return false;
+
+    fighters[f].status = 0;
+    start_fighter_explosion(f);
+    active_fighter_count--;
+    
+    // Award points based on current level
+    *player_score_out += 1;
+    *game_score_out += game_level;
+    
+    // Track fighter kills
+    extern int16_t fighters_killed;
+    fighters_killed++;
+    
+    return true;
 }
 
 void decrement_ebullet_cooldown(void)
@@ -6,13 +6,14 @@
 #include "constants.h"
 #include "input.h"
 #include "music.h"
+#include "palette.h"
+#include "overlay.h"
 #include <stdio.h>
 #include <string.h>
 #include <rp6502.h>
 
 // Forward declarations for graphics functions
 extern void draw_text(int16_t x, int16_t y, const char* text, uint8_t color);
-extern void clear_rect(int16_t x, int16_t y, int16_t width, int16_t height);
 
 // High score data
 static HighScore high_scores[MAX_HIGH_SCORES];
@@ -111,25 +112,17 @@ void insert_high_score(int8_t position, const char* name, int16_t score)
  */
 void draw_high_scores(void)
 {
-    const uint8_t color_cycle[] = {0xE3, 0x1F, 0xFF, 0xF8, 0x3F, 0x07, 0xC7}; // yellow, blue, white, red, green, cyan, magenta
-    const uint8_t color_cycle_len = sizeof(color_cycle) / sizeof(color_cycle[0]);
     const uint16_t start_x = 210;
     const uint16_t start_y = 40;
 
-    // Animate color based on vsync/frame (arcade effect)
-    uint8_t frame = RIA.vsync;
+    // Colours come from the PAL_BAND_SCORES palette band (rows, then the
+    // heading), which the title screen cycles through the rainbow
+    draw_text(start_x + 23 , start_y + 3, "HIGH SCORES", PAL_BAND_SCORES + MAX_HIGH_SCORES);
 
-    // Draw title with animated color
-    uint8_t title_color = color_cycle[(frame / 8) % color_cycle_len];
-    draw_text(start_x + 23 , start_y + 3, "HIGH SCORES", title_color);
-
-    // Draw each score with animated color cycling
+    // Draw each score
     for (uint8_t i = 0; i < MAX_HIGH_SCORES; i++) {
         uint16_t y = start_y + 15 + (i * 8);
-        // uint8_t row_color = color_cycle[(frame / 8 + i) % color_cycle_len];
-        uint8_t base_idx = 32;
-        uint8_t offset = (frame + (i * 10)) % 224; // Speed and spacing
-        uint8_t row_color = base_idx + offset;
+        uint8_t row_color = PAL_BAND_SCORES + i;
 
         // Draw rank number
         char rank[3];
@@ -165,8 +158,8 @@ void get_player_initials(char* name)
 {
     const uint8_t yellow_color = 0xE3;
     const uint8_t white_color = 0xFF;
-    const uint16_t center_x = 100;
-    const uint16_t center_y = 100;
+    const uint8_t row = overlay_row_at(85);
+    const uint8_t col = OVERLAY_COLS / 2 - 2;
     
     // Default Name
     name[0] = 'A';
@@ -177,41 +170,19 @@ void get_player_initials(char* name)
     uint8_t current_char = 0;   // Editing index 0-2
     uint8_t vsync_last = RIA.vsync;
     
-    // Input Edge Detection States
-    bool up_was_pressed = false;
-    bool down_was_pressed = false;
-    bool fire_was_pressed = false;
-    
     // Visual States
     uint8_t blink_counter = 0;
     bool blink_state = false;
     
     // Draw UI
-    draw_text(center_x - 20, center_y - 15, "NEW HIGH SCORE!", yellow_color);
-    draw_text(center_x - 20, center_y, "ENTER INITIALS:", yellow_color);
+    overlay_text_centered(row, "NEW HIGH SCORE!", yellow_color);
+    overlay_text_centered(row + 2, "ENTER INITIALS:", yellow_color);
     
     printf("\nNEW HIGH SCORE! Enter your initials\n");
     
     // ---------------------------------------------------------
-    // PHASE 1: Wait for Release (Debounce)
-    // Wait until FIRE is NOT pressed to prevent accidental input
-    // ---------------------------------------------------------
-    while (true) {
-        if (RIA.vsync == vsync_last)
-            continue;
-        vsync_last = RIA.vsync;
-        
-        handle_input();
-        update_music();
-        
-        // Check if FIRE is released
-        if (!is_action_pressed(0, ACTION_FIRE)) {
-            break;
-        }
-    }
-    
-    // ---------------------------------------------------------
-    // PHASE 2: Entry Loop
+    // Entry Loop: each action steps once per press, so the FIRE
+    // that closed the game over screen doesn't confirm a letter
     // ---------------------------------------------------------
     while (current_char < 3) {
         if (RIA.vsync == vsync_last)
@@ -219,7 +190,6 @@ void get_player_initials(char* name)
         vsync_last = RIA.vsync;
         
         handle_input();
-        update_music();
         
         // --- VISUALS ---
         
@@ -230,10 +200,7 @@ void get_player_initials(char* name)
             blink_state = !blink_state;
         }
         
-        // Clear the name area to prevent artifacts
-        clear_rect(center_x + 10, center_y + 15, 32, 12);
-        
-        // Draw the 3 characters
+        // Draw the 3 characters, spaced out; the cells are simply rewritten
         for (uint8_t i = 0; i < 3; i++) {
             char letter[2] = {name[i], '\0'};
             uint8_t color = yellow_color;
@@ -243,42 +210,36 @@ void get_player_initials(char* name)
                 color = white_color;
             }
             
-            draw_text(center_x + 10 + (i * 8), center_y + 15, letter, color);
+            overlay_text(col + i * 2, row + 4, letter, color);
         }
         
         // Draw Underscore under current char
-        char underscore[2] = "_";
-        draw_text(center_x + 10 + (current_char * 8), center_y + 20, underscore, yellow_color);
+        overlay_clear_rows(row + 5, 1);
+        overlay_text(col + current_char * 2, row + 5, "_", yellow_color);
         
         // --- INPUT HANDLING ---
         
         // 1. UP Input (Thrust Action)
-        bool up_now = is_action_pressed(0, ACTION_THRUST);
-        if (up_now && !up_was_pressed) {
+        if (is_action_just_pressed(0, ACTION_THRUST)) {
             name[current_char]++;
             if (name[current_char] > 'Z') name[current_char] = 'A';
         }
-        up_was_pressed = up_now;
         
         // 2. DOWN Input (Reverse Thrust Action)
-        bool down_now = is_action_pressed(0, ACTION_REVERSE_THRUST);
-        if (down_now && !down_was_pressed) {
+        if (is_action_just_pressed(0, ACTION_REVERSE_THRUST)) {
             name[current_char]--;
             if (name[current_char] < 'A') name[current_char] = 'Z';
         }
-        down_was_pressed = down_now;
         
         // 3. CONFIRM Input (Fire Action)
-        bool fire_now = is_action_pressed(0, ACTION_FIRE);
-        if (fire_now && !fire_was_pressed) {
+        if (is_action_just_pressed(0, ACTION_FIRE)) {
             // Advance to next character
             current_char++;
         }
-        fire_was_pressed = fire_now;
     }
     
     printf("Initials entered: %s\n", name);
     
     // Clear the entry screen area before returning
-    clear_rect(center_x - 20, center_y - 15, 130, 40);
+    overlay_clear_rows(row, 6);
 }
@@ -17,21 +17,6 @@ extern int16_t game_level;
 extern void draw_text(int16_t x, int16_t y, const char* text, uint8_t color);
 extern void clear_rect(int16_t x, int16_t y, int16_t width, int16_t height);
 
-// Forward declare internal helper function
-static inline void set(int16_t x, int16_t y, uint8_t color);
-
-/**
- * Set a pixel at (x, y) to the given color
- */
-static inline void set(int16_t x, int16_t y, uint8_t color)
-{
-    if (x >= 0 && x < 320 && y >= 0 && y < 180) {
-        RIA.addr0 = x + (SCREEN_WIDTH * y);
-        RIA.step0 = 1;
-        RIA.rw0 = color;
-    }
-}
-
 // Old pixel-based bar drawing functions removed — HUD now uses text-plane block bars.
 
 /**
@@ -19,6 +19,47 @@ bool handled_key = false;
 // Button mapping storage
 ButtonMapping button_mappings[GAMEPAD_COUNT][ACTION_COUNT];
 
+// Per-frame action snapshot (see input.h)
+uint8_t action_held[GAMEPAD_COUNT];
+uint8_t action_pressed[GAMEPAD_COUNT];
+uint8_t action_released[GAMEPAD_COUNT];
+
+// A mapping compiled for handle_input(): the keystates byte and bit, and
+// the gamepad_t byte and mask (a zero mask never matches)
+typedef struct {
+    uint8_t key_byte;
+    uint8_t key_mask;
+    uint8_t pad_field;
+    uint8_t pad_mask;
+} ActionBinding;
+
+static ActionBinding bindings[GAMEPAD_COUNT][ACTION_COUNT];
+
+/**
+ * Rebuild a player's compiled bindings after its mappings change
+ */
+static void compile_mappings(uint8_t player_id)
+{
+    for (uint8_t a = 0; a < ACTION_COUNT; a++) {
+        const ButtonMapping *m = &button_mappings[player_id][a];
+        ActionBinding *b = &bindings[player_id][a];
+
+        // Keyboard (player 0 only for now)
+        b->key_byte = m->keyboard_key >> 3;
+        b->key_mask = player_id == 0 ? 1 << (m->keyboard_key & 7) : 0;
+
+        // dpad, sticks, btn0 and btn1 are the first bytes of gamepad_t; a
+        // bad field (from JOYSTICK.DAT) reads dpad with a mask that never matches
+        if (m->gamepad_button <= GP_FIELD_BTN1) {
+            b->pad_field = m->gamepad_button;
+            b->pad_mask = m->gamepad_mask;
+        } else {
+            b->pad_field = GP_FIELD_DPAD;
+            b->pad_mask = 0;
+        }
+    }
+}
+
 /**
  * Read keyboard and gamepad input
  */
@@ -46,7 +87,23 @@ void handle_input(void)
         gamepad[i].l2 = RIA.rw0;
         gamepad[i].r2 = RIA.rw0;
     }
-    
+
+    // Resolve every action once; callers test bits from here on
+    for (uint8_t p = 0; p < GAMEPAD_COUNT; p++) {
+        const uint8_t *pad = (const uint8_t *)&gamepad[p];
+        bool connected = pad[GP_FIELD_DPAD] & GP_CONNECTED;
+        uint8_t held = 0;
+        for (uint8_t a = 0; a < ACTION_COUNT; a++) {
+            const ActionBinding *b = &bindings[p][a];
+            if ((keystates[b->key_byte] & b->key_mask) ||
+                (connected && (pad[b->pad_field] & b->pad_mask))) {
+                held |= ACTION_BIT(a);
+            }
+        }
+        action_pressed[p] = held & ~action_held[p];
+        action_released[p] = action_held[p] & ~held;
+        action_held[p] = held;
+    }
 }
 
 /**
@@ -104,41 +161,8 @@ void reset_button_mappings(uint8_t player_id)
     button_mappings[player_id][ACTION_PAUSE].keyboard_key = KEY_ENTER;
     button_mappings[player_id][ACTION_PAUSE].gamepad_button = GP_FIELD_BTN1; // btn1 field
     button_mappings[player_id][ACTION_PAUSE].gamepad_mask = GP_BTN_START;
-}
 
-/**
- * Check if a game action is active for a specific player
- */
-bool is_action_pressed(uint8_t player_id, GameAction action)
-{
-    if (player_id >= GAMEPAD_COUNT || action >= ACTION_COUNT) {
-        return false;
-    }
-    
-    ButtonMapping* mapping = &button_mappings[player_id][action];
-    
-    // Check keyboard (player 0 only for now)
-    if (player_id == 0) {
-        if (key(mapping->keyboard_key)) {
-            return true;
-        }
-    }
-    
-    // Only check gamepad if one is connected
-    if (!(gamepad[player_id].dpad & GP_CONNECTED)) {
-        return false;
-    }
-    
-    // Check gamepad
-    uint8_t gamepad_value = 0;
-    switch (mapping->gamepad_button) {
-        case 0: gamepad_value = gamepad[player_id].dpad; break;
-        case 1: gamepad_value = gamepad[player_id].sticks; break;
-        case 2: gamepad_value = gamepad[player_id].btn0; break;
-        case 3: gamepad_value = gamepad[player_id].btn1; break;
-    }
-    
-    return (gamepad_value & mapping->gamepad_mask) != 0;
+    compile_mappings(player_id);
 }
 
 /**
@@ -154,6 +178,7 @@ void set_button_mapping(uint8_t player_id, GameAction action,
     button_mappings[player_id][action].keyboard_key = keyboard_key;
     button_mappings[player_id][action].gamepad_button = gamepad_button;
     button_mappings[player_id][action].gamepad_mask = gamepad_mask;
+    compile_mappings(player_id);
 }
 
 /**
@@ -233,6 +258,7 @@ bool load_joystick_config(void)
         button_mappings[0][action].gamepad_button = file_mappings[i].field;
         button_mappings[0][action].gamepad_mask = file_mappings[i].mask;
     }
+    compile_mappings(0);
     
     return true;
 }
@@ -295,9 +321,6 @@ void init_input_system_test(void)
 
     uint8_t vsync_last_test = RIA.vsync;
 
-    bool action_pressed[ACTION_COUNT];
-    for (uint8_t i = 0; i < ACTION_COUNT; i++) action_pressed[i] = false;
-
     const char *action_names[ACTION_COUNT] = {
         "THRUST",
         "REVERSE_THRUST",
@@ -313,44 +336,17 @@ void init_input_system_test(void)
             continue;
         vsync_last_test = RIA.vsync;
 
-        // Read gamepad data only
-        RIA.addr0 = GAMEPAD_INPUT;
-        RIA.step0 = 1;
-        for (uint8_t i = 0; i < GAMEPAD_COUNT; i++) {
-            gamepad[i].dpad = RIA.rw0;
-            gamepad[i].sticks = RIA.rw0;
-            gamepad[i].btn0 = RIA.rw0;
-            gamepad[i].btn1 = RIA.rw0;
-            gamepad[i].lx = RIA.rw0;
-            gamepad[i].ly = RIA.rw0;
-            gamepad[i].rx = RIA.rw0;
-            gamepad[i].ry = RIA.rw0;
-            gamepad[i].l2 = RIA.rw0;
-            gamepad[i].r2 = RIA.rw0;
-        }
+        handle_input();
 
-        // Check each mapped action for player 0 and report events
+        // Report each mapped action's edges for player 0
         for (uint8_t action = 0; action < ACTION_COUNT; action++) {
-            ButtonMapping *m = &button_mappings[0][action];
-            uint8_t value = 0;
-            switch (m->gamepad_button) {
-                case 0: value = gamepad[0].dpad; break;
-                case 1: value = gamepad[0].sticks; break;
-                case 2: value = gamepad[0].btn0; break;
-                case 3: value = gamepad[0].btn1; break;
-                default: value = 0; break;
-            }
-
-            bool now = (value & m->gamepad_mask) != 0;
-            if (now && !action_pressed[action]) {
-                action_pressed[action] = true;
+            if (is_action_just_pressed(0, action)) {
                 printf("Action %s pressed\n", action_names[action]);
                 if (action == ACTION_PAUSE) {
                     printf("PAUSE action pressed — exiting input test.\n");
                     return;
                 }
-            } else if (!now && action_pressed[action]) {
-                action_pressed[action] = false;
+            } else if (is_action_just_released(0, action)) {
                 printf("Action %s released\n", action_names[action]);
             }
         }
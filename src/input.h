@@ -72,6 +72,37 @@ typedef struct {
 // Button mapping arrays (one set per player/gamepad)
 extern ButtonMapping button_mappings[GAMEPAD_COUNT][ACTION_COUNT];
 
+// ============================================================================
+// ACTION SNAPSHOT
+// ============================================================================
+
+// handle_input() resolves every mapping once per frame into one bit per
+// action (ACTION_COUNT must stay <= 8). Everything else tests these bits,
+// so each action reads the same way in every loop; the edge masks are
+// relative to the previous handle_input() call.
+#define ACTION_BIT(action)  ((uint8_t)(1 << (action)))
+
+extern uint8_t action_held[GAMEPAD_COUNT];      // Down this frame
+extern uint8_t action_pressed[GAMEPAD_COUNT];   // Went down this frame
+extern uint8_t action_released[GAMEPAD_COUNT];  // Went up this frame
+
+// Check if a game action is active for a specific player
+static inline bool is_action_pressed(uint8_t player_id, GameAction action)
+{
+    return action_held[player_id] & ACTION_BIT(action);
+}
+
+// Check if a game action went down / up since the last handle_input()
+static inline bool is_action_just_pressed(uint8_t player_id, GameAction action)
+{
+    return action_pressed[player_id] & ACTION_BIT(action);
+}
+
+static inline bool is_action_just_released(uint8_t player_id, GameAction action)
+{
+    return action_released[player_id] & ACTION_BIT(action);
+}
+
 // ============================================================================
 // FUNCTION DECLARATIONS
 // ============================================================================
@@ -84,12 +115,9 @@ void init_input_system(void);
 void init_input_system_test(void);
 #endif
 
-// Read keyboard and gamepad input
+// Read keyboard and gamepad input and update the action snapshot
 void handle_input(void);
 
-// Check if a game action is active for a specific player
-bool is_action_pressed(uint8_t player_id, GameAction action);
-
 // Set button mapping for a specific action
 void set_button_mapping(uint8_t player_id, GameAction action, 
                        uint8_t keyboard_key, uint8_t gamepad_button, uint8_t gamepad_mask);
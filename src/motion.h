@@ -0,0 +1,54 @@
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <stdint.h>
+
+/**
+ * motion.h - Shared sub-pixel motion integrator
+ *
+ * Velocities are Q8.8: the high byte is signed whole pixels per frame and
+ * the low byte is 1/256ths. Positions stay plain int16_t pixels with a
+ * separate uint8_t fraction, so a step is one 8-bit add whose carry goes
+ * into the integer part - no shifts, multiplies or divides. Movement
+ * rounds toward negative infinity, like the old `>> n` remainder code.
+ */
+
+// Q8.8 velocity in pixels per frame
+typedef int16_t q88_t;
+
+// Velocity in 1/2^shift pixel units (the old `>> shift` code) to Q8.8
+#define Q88_FROM_SHIFT(v, shift) ((q88_t)((v) * (1 << (8 - (shift)))))
+
+/**
+ * Add vel to a position fraction; returns the whole pixels to move
+ */
+static inline int16_t motion_advance(uint8_t *frac, q88_t vel)
+{
+    uint16_t sum = (uint16_t)*frac + (uint8_t)vel;
+    *frac = (uint8_t)sum;
+    return (int8_t)((uint16_t)vel >> 8) + (int16_t)(sum >> 8);
+}
+
+/**
+ * Move one axis by vel; returns the whole pixels moved
+ */
+static inline int16_t motion_step(int16_t *pos, uint8_t *frac, q88_t vel)
+{
+    int16_t whole = motion_advance(frac, vel);
+    *pos += whole;
+    return whole;
+}
+
+/**
+ * Wrap a position into [lo, hi] by one world span (hi - lo)
+ */
+static inline void motion_wrap(int16_t *pos, int16_t lo, int16_t hi)
+{
+    if (*pos < lo) {
+        *pos += hi - lo;
+    } else if (*pos > hi) {
+        *pos -= hi - lo;
+    }
+}
+
+#endif // MOTION_H
@@ -1,5 +1,9 @@
 #include "music.h"
+#include "music_songs.h"
 #include "constants.h"
+#include "psg.h"
+#include "music_stream.h"
+#include "audio.h"
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -9,428 +13,260 @@
 // CONSTANTS
 // ============================================================================
 
-// Music channels (4-7, leaving 0-3 for sound effects)
-#define MUSIC_CHANNEL_START 4
+// Music voices (PSG channels are lent by psg.c and may be taken back)
 #define MUSIC_CHANNEL_COUNT 4
 
 // Tempo: 120 BPM = 2 beats per second = 1 beat per 30 frames (at 60 FPS)
 // This value decreases with each level to speed up the music
 #define DEFAULT_FRAMES_PER_BEAT 15
 #define MIN_FRAMES_PER_BEAT 5
-static int frames_per_beat = DEFAULT_FRAMES_PER_BEAT;
-
-// Waveforms
-#define WAVE_SQUARE 1
-#define WAVE_TRIANGLE 3
-#define WAVE_SAWTOOTH 2
-#define WAVE_NOISE 4
-
-// Instrument types
-#define INSTRUMENT_NORMAL 0
-#define INSTRUMENT_KICK 1
-#define INSTRUMENT_HIHAT 2
+static uint8_t frames_per_beat = DEFAULT_FRAMES_PER_BEAT;  // Audio tick's copy
+static uint8_t tempo = DEFAULT_FRAMES_PER_BEAT;            // Game's copy
+
+// Release a gate this many frames before its note's rows are up
+#define RELEASE_FRAMES 3
+
+// Event stream (see music.h)
+#define EV_NOTE         0
+#define EV_TRIG         1
+#define EV_LEN          2
+#define EV_PATCH        3
+#define EV_OFF          4
+#define OP_WAIT         0x40
+#define OP_CALL         0x41
+#define OP_RET          0x42
+#define OP_JUMP         0x43
+#define OP_END          0x44
+#define OP_WAIT_SHORT   0x80
+
+#define CALL_DEPTH      2
 
 // ============================================================================
-// MUSIC DATA - Simple Melody for Title Screen
+// MODULE STATE
 // ============================================================================
 
+static const MusicSong *song = NULL;
+static const uint8_t *pc;                       // Next event
+static const uint8_t *call_stack[CALL_DEPTH];
+static uint8_t call_depth = 0;
+static uint16_t wait_frames = 0;                // Frames until the next events
 
-// A direct translation of the Furnance tracker snippet with the correct arpeggio logic.
-
-// --- Kick Drum (Track 0) ---
-// Plays a C3 kick on specific rows. A tracker row is typically a 16th note.
-static const Note title_kick[] = {
-    // This pattern is directly from Track 0 in your snippet.
-    {NOTE_C3, 1}, {NOTE_REST, 5}, // 00: Kick, followed by rests
-    {NOTE_C3, 1}, {NOTE_REST, 9}, // 06: Kick
-    {NOTE_C3, 1}, {NOTE_REST, 5}, // 10: Kick
-    {NOTE_C3, 1}, {NOTE_REST, 3}, // 16: Kick
-    {NOTE_C3, 1}, {NOTE_REST, 5}, // 1A: From your snippet, C3 04 78 on row 1A
-    {NOTE_C3, 1}, {NOTE_REST, 3}, // 20: Kick
-    {NOTE_C3, 1}, {NOTE_REST, 5}, // 26: Kick
-    {NOTE_C3, 1}, {NOTE_REST, 9}, // 30: Kick
-    {NOTE_C3, 1}, {NOTE_REST, 5}, // 36: Kick
-    {NOTE_C3, 1}, {NOTE_REST, 5}, // 3A: From your snippet, C3 04 78 on row 3A
-    
-    {0, 0}  // End marker
-};
-
-
-// --- Hi-Hat (Track 1) ---
-// Plays a C3 hi-hat on specific off-beats.
-static const Note title_hihat[] = {
-    // This syncopated pattern is directly from Track 1 in your snippet.
-    {NOTE_REST, 4}, {NOTE_C6, 1}, {NOTE_REST, 7}, // 04: Hat
-    {NOTE_C6, 1},   {NOTE_REST, 7},             // 0C: Hat
-    {NOTE_C6, 1},   {NOTE_REST, 7},             // 14: Hat
-    {NOTE_C6, 1},   {NOTE_REST, 7},             // 1C: Hat
-    {NOTE_C6, 1},   {NOTE_REST, 7},             // 24: Hat
-    {NOTE_C6, 1},   {NOTE_REST, 7},             // 2C: Hat
-    {NOTE_C6, 1},   {NOTE_REST, 7},             // 34: Hat
-    {NOTE_C6, 1},   {NOTE_REST, 7},             // 3C: Hat
-
-    {0, 0}  // End marker
-};
-
-
-// --- Bassline (Track 4) ---
-// A continuous 8th-note octave-hopping arpeggio.
-// It plays C for the first half, then switches to G in the second half.
-static const Note title_bass[] = {
-    // Rows 00-1F: Arpeggio on C2
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1}, // Beat 1 & 2
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1}, // Beat 3 & 4
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1}, // ...repeats for 32 rows
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1},
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1},
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1},
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1},
-    {NOTE_C2, 1}, {NOTE_C3, 1}, {NOTE_C2, 1}, {NOTE_C3, 1},
-
-    // Rows 20-3F: Arpeggio on G1 (Note change detected at row 0x20)
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1}, // Beat 1 & 2
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1}, // Beat 3 & 4
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1}, // ...repeats for 32 rows
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1},
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1},
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1},
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1},
-    {NOTE_G2, 1}, {NOTE_G3, 1}, {NOTE_G2, 1}, {NOTE_G3, 1},
-
-    {0, 0}  // End marker
-};
-
-// Main melody with faster notes and more rhythmic interest.
-static const Note end_melody[] = {
-    // Measure 1
-    {NOTE_G4, 1}, {NOTE_C5, 1}, {NOTE_E5, 1}, {NOTE_G5, 1},
-    {NOTE_F5, 1}, {NOTE_E5, 1}, {NOTE_D5, 1}, {NOTE_C5, 1},
-
-    // Measure 2
-    {NOTE_G4, 1}, {NOTE_B4, 1}, {NOTE_D5, 1}, {NOTE_G5, 1},
-    {NOTE_F5, 1}, {NOTE_E5, 1}, {NOTE_D5, 1}, {NOTE_B4, 1},
-
-    // Measure 3
-    {NOTE_F4, 1}, {NOTE_A4, 1}, {NOTE_C5, 1}, {NOTE_F5, 1},
-    {NOTE_E5, 1}, {NOTE_D5, 1}, {NOTE_C5, 1}, {NOTE_A4, 1},
-
-    // Measure 4 - A classic resolving pattern
-    {NOTE_G4, 1}, {NOTE_B4, 1}, {NOTE_D5, 1}, {NOTE_F5, 1},
-    {NOTE_E5, 2}, {NOTE_C5, 2}, // End on a strong, held note
-
-    {0, 0}  // End marker
-};
-
-// A driving, arpeggiated bass line that follows the chords.
-static const Note end_bass[] = {
-    // Measure 1: C-major arpeggio
-    {NOTE_C3, 1}, {NOTE_G3, 1}, {NOTE_C4, 1}, {NOTE_G3, 1},
-    {NOTE_C3, 1}, {NOTE_G3, 1}, {NOTE_C4, 1}, {NOTE_G3, 1},
-
-    // Measure 2: G-major arpeggio
-    {NOTE_G3, 1}, {NOTE_D4, 1}, {NOTE_G4, 1}, {NOTE_D4, 1},
-    {NOTE_G3, 1}, {NOTE_D4, 1}, {NOTE_G4, 1}, {NOTE_D4, 1},
-
-    // Measure 3: F-major arpeggio
-    {NOTE_F3, 1}, {NOTE_C4, 1}, {NOTE_F4, 1}, {NOTE_C4, 1},
-    {NOTE_F3, 1}, {NOTE_C4, 1}, {NOTE_F4, 1}, {NOTE_C4, 1},
-
-    // Measure 4: G-major leading back to C
-    {NOTE_G3, 1}, {NOTE_D4, 1}, {NOTE_G4, 1}, {NOTE_D4, 1},
-    {NOTE_C3, 1}, {NOTE_G3, 1}, {NOTE_C4, 1}, {NOTE_G3, 1}, // Quick turnaround
-
-    {0, 0}  // End marker
-};
-
-// A classic "four-on-the-floor" kick drum pattern for high energy.
-static const Note end_kick[] = {
-    // Measures 1-4 (pattern repeats)
-    {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2},
-    {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2},
-    {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2},
-    {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2}, {NOTE_C3, 2},
-
-    {0, 0}  // End marker
-};
-
-// Constant eighth-note hi-hats to provide a sense of speed.
-static const Note end_hihat[] = {
-    // Measures 1-4 (pattern repeats)
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-    {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1}, {NOTE_C6, 1},
-
-    {0, 0}  // End marker
-};
-
-// ============================================================================
-// MODULE STATE
-// ============================================================================
+static uint8_t gate_rows[MUSIC_CHANNEL_COUNT];  // LEN of each voice
+static uint16_t gate_frames[MUSIC_CHANNEL_COUNT]; // Frames until release (0: held)
 
-typedef struct {
-    const Note* sequence;   // Note sequence to play
-    uint8_t position;       // Current position in sequence
-    uint8_t frames_left;    // Frames left in current note
-    uint8_t channel;        // PSG channel for this track
-    uint8_t instrument;     // Instrument type
-    bool active;            // Is this track active
-} MusicTrack;
+// What each voice has set, to replay onto a new channel after losing one
+static uint8_t voice_channel[MUSIC_CHANNEL_COUNT];  // PSG channel, or PSG_VOICE_NONE
+static uint8_t voice_tag[MUSIC_CHANNEL_COUNT];      // psg_voice_tag() when taken
+static uint16_t voice_freq[MUSIC_CHANNEL_COUNT];
+static uint8_t voice_patch[MUSIC_CHANNEL_COUNT][4];
 
-static MusicTrack tracks[MUSIC_CHANNEL_COUNT];
 static bool music_playing = false;
-static uint16_t master_loop_frames = 0;  // Total frames in one loop
-static uint16_t current_frame = 0;        // Current frame in the loop
+
+const char *title_music_stream = MUSIC_STREAM_TITLE;
 
 // ============================================================================
 // INTERNAL FUNCTIONS
 // ============================================================================
 
 /**
- * Set a note on a PSG channel
+ * Channel a voice plays on; takes a free one (and sets it up) if a sound
+ * effect took the last. PSG_VOICE_NONE while none can be had.
  */
-static void set_note(uint8_t channel, uint16_t freq, uint8_t instrument)
+static uint8_t channel_of(uint8_t voice)
 {
-    if (channel < MUSIC_CHANNEL_START || channel >= MUSIC_CHANNEL_START + MUSIC_CHANNEL_COUNT) {
-        return;
+    uint8_t ch = voice_channel[voice];
+    if (ch != PSG_VOICE_NONE && psg_voice_tag(ch) == voice_tag[voice]) {
+        return ch;
     }
-    
-    uint16_t psg_addr = PSG_XRAM_ADDR + (channel * 8);
-    
-    if (freq == 0) {
-        // Rest - gate off
-        RIA.addr0 = psg_addr + 6;  // pan_gate offset
-        RIA.rw0 = 0x00;
-        return;
+
+    ch = psg_voice_alloc(PSG_PRIO_MUSIC, 0);
+    voice_channel[voice] = ch;
+    if (ch != PSG_VOICE_NONE) {
+        voice_tag[voice] = psg_voice_tag(ch);
+        psg_set_freq(ch, voice_freq[voice]);
+        for (uint8_t n = 0; n < 4; n++) {
+            psg_write(ch, PSG_REG_DUTY + n, voice_patch[voice][n]);
+        }
     }
-    
-    // Set frequency (Hz * 3)
-    uint16_t freq_val = freq * 3;
-    RIA.addr0 = psg_addr;
-    RIA.step0 = 1;
-    RIA.rw0 = freq_val & 0xFF;          // freq low byte
-    RIA.rw0 = (freq_val >> 8) & 0xFF;   // freq high byte
-    
-    // Configure based on instrument type
-    if (instrument == INSTRUMENT_HIHAT) {
-    // Closed Hi-hat: Noise with a very fast attack and a quick decay to silence.
-        RIA.rw0 = 255;                      // Duty cycle (not used for noise)
-        RIA.rw0 = (4 << 4) | 0;           // vol_attack: Loudest volume (0), fastest attack (0)
-        RIA.rw0 = (15 << 4) | 2;          // vol_decay: Sustain at silence (15), fast decay rate (2)
-        RIA.rw0 = (WAVE_NOISE << 4) | 2;  // wave_release: Noise waveform, fast release rate (2)
-        RIA.step0 = 0;                    // Frequency (not critical for noise)
-        RIA.rw0 = 0x01;
-    } else if (instrument == INSTRUMENT_KICK) {
-        // Kick drum - noise wave with punch and sustain
-        RIA.rw0 = 128;            // duty cycle (lower for tighter sound)
-        RIA.rw0 = (0 << 4) | 0;           // vol_attack: Loudest volume (0), fastest attack (0)
-        RIA.rw0 = (15 << 4) | 7;          // vol_decay: Sustain at silence (15), medium decay (~240ms)
-        RIA.rw0 = (WAVE_TRIANGLE << 4) | 0;  // wave_release (noise, release 0)
-        RIA.step0 = 0;
-        RIA.rw0 = 0x01;         // pan center, gate on
-    } else {
-        // Normal note - bass uses triangle wave on channel 5
-        // Note: Since we call start_music(NULL, title_bass, NULL, NULL),
-        // bass is the only active track and uses channel 5
-        uint8_t waveform = WAVE_TRIANGLE;  // Always triangle for bass-only music
-        
-        RIA.rw0 = 64;          // Set duty cycle (50%)
-        RIA.rw0 = (0 << 4) | 1; // Set volume (0 = LOUDEST) and attack (1 = fast)
-        RIA.rw0 = (10 << 4) | 2; // Set decay volume (10 = loud sustain) and decay (2)
-        RIA.rw0 = (waveform << 4) | 3; // Set waveform and release (3)
-        RIA.step0 = 0;
-        RIA.rw0 = 0x01;         // Set pan (center) and gate (on)
+    return ch;
+}
+
+/**
+ * Gate a voice off, if it still has a channel
+ */
+static void gate_off(uint8_t voice)
+{
+    uint8_t ch = voice_channel[voice];
+    if (ch != PSG_VOICE_NONE && psg_voice_tag(ch) == voice_tag[voice]) {
+        psg_gate(ch, false);
     }
+    gate_frames[voice] = 0;
 }
 
 /**
- * Stop a note on a channel
+ * Gate a voice on and time its release from the voice's LEN
  */
-static void stop_note(uint8_t channel)
+static void gate_on(uint8_t voice)
 {
-    if (channel < MUSIC_CHANNEL_START || channel >= MUSIC_CHANNEL_START + MUSIC_CHANNEL_COUNT) {
+    uint8_t ch = channel_of(voice);
+    if (ch == PSG_VOICE_NONE) {
         return;
     }
-    
-    uint16_t psg_addr = PSG_XRAM_ADDR + (channel * 8) + 6;  // pan_gate offset
-    RIA.addr0 = psg_addr;
-    RIA.rw0 = 0x00;  // Gate off
+    psg_gate(ch, true);
+    uint16_t frames = gate_rows[voice] * frames_per_beat;
+    gate_frames[voice] = frames > RELEASE_FRAMES ? frames - RELEASE_FRAMES : 0;
 }
 
 /**
- * Initialize a music track
+ * Give every voice's channel back
  */
-static void init_track(uint8_t track_idx, const Note* sequence, uint8_t channel, uint8_t instrument)
+static void release_voices(void)
 {
-    if (track_idx >= MUSIC_CHANNEL_COUNT) return;
-    
-    tracks[track_idx].sequence = sequence;
-    tracks[track_idx].position = 0;
-    tracks[track_idx].frames_left = 0;
-    tracks[track_idx].channel = channel;
-    tracks[track_idx].instrument = instrument;
-    tracks[track_idx].active = true;
+    for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
+        uint8_t ch = voice_channel[i];
+        if (ch != PSG_VOICE_NONE && psg_voice_tag(ch) == voice_tag[i]) {
+            psg_voice_release(ch);
+        }
+        voice_channel[i] = PSG_VOICE_NONE;
+        gate_frames[i] = 0;
+    }
 }
 
 /**
- * Update a single music track
+ * Run one voice event; returns the byte after it
  */
-static void update_track(MusicTrack* track)
+static const uint8_t *voice_event(uint8_t op, const uint8_t *p)
 {
-    if (!track->active || !track->sequence) return;
-    
-    // Release note a few frames before the end for decay
-    if (track->frames_left == 3) {
-        stop_note(track->channel);
-    }
-    
-    // Decrement frame counter
-    if (track->frames_left > 0) {
-        track->frames_left--;
-        return;
+    uint8_t voice = op & 3;
+    uint8_t ch;
+
+    switch (op >> 2) {
+    case EV_NOTE:
+        voice_freq[voice] = song->freqs[*p++];
+        ch = channel_of(voice);
+        if (ch != PSG_VOICE_NONE) {
+            psg_set_freq(ch, voice_freq[voice]);
+        }
+        gate_on(voice);
+        break;
+    case EV_TRIG:
+        gate_on(voice);
+        break;
+    case EV_LEN:
+        gate_rows[voice] = *p++;
+        break;
+    case EV_PATCH:
+        for (uint8_t n = 0; n < 4; n++) {
+            voice_patch[voice][n] = *p++;
+        }
+        ch = channel_of(voice);
+        if (ch != PSG_VOICE_NONE) {
+            for (uint8_t n = 0; n < 4; n++) {
+                psg_write(ch, PSG_REG_DUTY + n, voice_patch[voice][n]);
+            }
+        }
+        break;
+    default:
+        gate_off(voice);
+        break;
     }
-    
-    // Get next note
-    const Note* current = &track->sequence[track->position];
-    
-    // Check for end of sequence
-    if (current->freq == 0 && current->duration == 0) {
-        // Loop back to beginning
-        track->position = 0;
-        current = &track->sequence[0];
+    return p;
+}
+
+/**
+ * Run events up to the next wait (or the end of the song)
+ */
+static void run_events(void)
+{
+    const uint8_t *p = pc;
+    for (;;) {
+        uint8_t op = *p++;
+
+        if (op >= OP_WAIT_SHORT || op == OP_WAIT) {
+            uint16_t rows;
+            if (op == OP_WAIT) {
+                rows = 0;
+                uint8_t shift = 0, b;
+                do {
+                    b = *p++;
+                    rows |= (uint16_t)(b & 0x7F) << shift;
+                    shift += 7;
+                } while (b & 0x80);
+            } else {
+                rows = op - OP_WAIT_SHORT + 1;
+            }
+            wait_frames = rows * frames_per_beat;
+            pc = p;
+            return;
+        }
+        if (op < OP_WAIT) {
+            p = voice_event(op, p);
+            continue;
+        }
+
+        switch (op) {
+        case OP_CALL:
+            if (call_depth < CALL_DEPTH) {
+                call_stack[call_depth++] = p + 2;
+            }
+            p = song->events + (p[0] | (p[1] << 8));
+            break;
+        case OP_RET:
+            p = call_depth ? call_stack[--call_depth] : song->events;
+            break;
+        case OP_JUMP:
+            p = song->events + (p[0] | (p[1] << 8));
+            break;
+        default:    // OP_END or a bad byte
+            music_halt();
+            return;
+        }
     }
-    
-    // Play the note
-    set_note(track->channel, current->freq, track->instrument);
-    
-    // Set duration (convert beats to frames)
-    track->frames_left = current->duration * frames_per_beat;
-    
-    // Move to next note
-    track->position++;
 }
 
 // ============================================================================
-// PUBLIC FUNCTIONS
+// GAME SIDE
 // ============================================================================
 
 void init_music(void)
 {
-    // Clear all music channels
     for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
-        tracks[i].active = false;
-        stop_note(MUSIC_CHANNEL_START + i);
+        voice_channel[i] = PSG_VOICE_NONE;
+        gate_frames[i] = 0;
     }
-    
+
+    song = NULL;
     music_playing = false;
-    current_frame = 0;
 }
 
-void start_music(const Note* melody, const Note* bass, const Note* kick, const Note* hihat)
+void start_music(const MusicSong *new_song)
 {
-    // Initialize melody track on channel 4 (normal instrument - square wave)
-    if (melody) {
-        init_track(0, melody, MUSIC_CHANNEL_START, INSTRUMENT_NORMAL);
-    }
-    
-    // Initialize bass track on channel 5 (normal instrument - triangle wave)
-    if (bass) {
-        init_track(1, bass, MUSIC_CHANNEL_START + 1, INSTRUMENT_NORMAL);
-    }
-    
-    // Initialize kick drum track on channel 6
-    if (kick) {
-        init_track(2, kick, MUSIC_CHANNEL_START + 2, INSTRUMENT_KICK);
-    }
-    
-    // Initialize hi-hat track on channel 7
-    if (hihat) {
-        init_track(3, hihat, MUSIC_CHANNEL_START + 3, INSTRUMENT_HIHAT);
-    }
-    
-    // Calculate total duration of the loop (from melody track, or first non-null track)
-    master_loop_frames = 0;
-    const Note* reference_track = melody ? melody : (bass ? bass : (kick ? kick : hihat));
-    if (reference_track) {
-        const Note* note = reference_track;
-        while (note->freq != 0 || note->duration != 0) {
-            master_loop_frames += note->duration * frames_per_beat;
-            note++;
-        }
-    }
-    
-    music_playing = true;
-    current_frame = 0;
-    
-    // Immediately play the first notes of all tracks to ensure sync
-    for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
-        if (tracks[i].active && tracks[i].sequence) {
-            const Note* first_note = &tracks[i].sequence[0];
-            set_note(tracks[i].channel, first_note->freq, tracks[i].instrument);
-            tracks[i].frames_left = first_note->duration * frames_per_beat;
-            tracks[i].position = 1;  // Move to next note for subsequent updates
-        }
-    }
+    music_stream_close();
+    audio_send(AUDIO_CMD_SONG, 0, new_song);
 }
 
 void start_title_music(void)
 {
-    start_music(NULL, title_bass, NULL, NULL);
+    // The full track streams from storage; the short loop is the fallback
+    if (!music_stream_start(title_music_stream)) {
+        start_music(&SONG_TITLE);
+    }
 }
 
 void start_gameplay_music(void)
 {
-    start_music(NULL, title_bass, NULL, NULL);
+    start_music(&SONG_TITLE);
 }
 
 void start_end_music(void)
 {
-    start_music(end_melody, end_bass, end_kick, end_hihat);
+    start_music(&SONG_END);
 }
 
 void stop_music(void)
 {
-    music_playing = false;
-    
-    // Stop all music channels
-    for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
-        tracks[i].active = false;
-        stop_note(MUSIC_CHANNEL_START + i);
-    }
-}
-
-void update_music(void)
-{
-    if (!music_playing) return;
-    
-    // Check if we've completed a full loop cycle
-    if (current_frame >= master_loop_frames) {
-        // Reset all tracks to beginning simultaneously
-        current_frame = 0;
-        for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
-            if (tracks[i].active && tracks[i].sequence) {
-                // Immediately play first note of the loop
-                const Note* first_note = &tracks[i].sequence[0];
-                set_note(tracks[i].channel, first_note->freq, tracks[i].instrument);
-                tracks[i].frames_left = first_note->duration * frames_per_beat;
-                tracks[i].position = 1;  // Move to next note for subsequent updates
-            }
-        }
-        // Skip update_track this frame since we just started the notes
-        current_frame++;
-        return;
-    }
-    
-    // Update all active tracks
-    for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
-        update_track(&tracks[i]);
-    }
-    
-    current_frame++;
+    music_stream_close();
+    audio_send(AUDIO_CMD_STOP, 0, NULL);
 }
 
 // bool is_music_playing(void)
@@ -440,12 +276,78 @@ void update_music(void)
 
 void increase_music_tempo(void)
 {
-    if (frames_per_beat > MIN_FRAMES_PER_BEAT) {
-        frames_per_beat--;
+    if (tempo > MIN_FRAMES_PER_BEAT) {
+        tempo--;
+        audio_send(AUDIO_CMD_TEMPO, tempo, NULL);
     }
 }
 
 void reset_music_tempo(void)
 {
-    frames_per_beat = DEFAULT_FRAMES_PER_BEAT;
+    tempo = DEFAULT_FRAMES_PER_BEAT;
+    audio_send(AUDIO_CMD_TEMPO, tempo, NULL);
+}
+
+// ============================================================================
+// AUDIO TICK SIDE
+// ============================================================================
+
+void music_play(const MusicSong *new_song)
+{
+    music_stream_end();
+    release_voices();
+
+    song = new_song;
+    pc = song->events;
+    call_depth = 0;
+    for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
+        gate_rows[i] = 0;
+    }
+    music_playing = true;
+
+    // Play the first row now so every voice starts together
+    run_events();
+}
+
+void music_play_stream(uint8_t at)
+{
+    release_voices();
+    music_stream_begin(at);
+    song = NULL;
+    music_playing = true;
+}
+
+void music_halt(void)
+{
+    music_playing = false;
+    music_stream_end();
+    release_voices();
+}
+
+void music_set_tempo(uint8_t frames)
+{
+    frames_per_beat = frames;
+}
+
+void update_music(void)
+{
+    if (!music_playing) return;
+
+    if (!song) {
+        music_stream_update();
+        music_playing = music_stream_active();
+        return;
+    }
+
+    for (uint8_t i = 0; i < MUSIC_CHANNEL_COUNT; i++) {
+        if (gate_frames[i] && --gate_frames[i] == 0) {
+            gate_off(i);
+        }
+    }
+
+    if (wait_frames > 1) {
+        wait_frames--;
+        return;
+    }
+    run_events();
 }
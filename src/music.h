@@ -7,78 +7,42 @@
 /**
  * music.h - Music playback system for title screen
  * 
- * Uses PSG channels 4-7 (channels 0-3 reserved for sound effects)
- * Implements a simple note sequencer with tempo control
- */
-
-// Music notes (frequency values in Hz)
-typedef enum {
-    NOTE_REST = 0,
-    NOTE_C2 = 65,
-    NOTE_CS2 = 69,
-    NOTE_D2 = 73,
-    NOTE_DS2 = 78,
-    NOTE_E2 = 82,
-    NOTE_F2 = 87,
-    NOTE_FS2 = 93,
-    NOTE_G2 = 98,
-    NOTE_GS2 = 104,
-    NOTE_A2 = 110,
-    NOTE_AS2 = 117,
-    NOTE_B2 = 123,
-    NOTE_C3 = 131,
-    NOTE_CS3 = 139,
-    NOTE_D3 = 147,
-    NOTE_DS3 = 156,
-    NOTE_E3 = 165,
-    NOTE_F3 = 175,
-    NOTE_FS3 = 185,
-    NOTE_G3 = 196,
-    NOTE_GS3 = 208,
-    NOTE_A3 = 220,
-    NOTE_AS3 = 233,
-    NOTE_B3 = 247,
-    NOTE_C4 = 262,
-    NOTE_CS4 = 277,
-    NOTE_D4 = 294,
-    NOTE_DS4 = 311,
-    NOTE_E4 = 330,
-    NOTE_F4 = 349,
-    NOTE_FS4 = 370,
-    NOTE_G4 = 392,
-    NOTE_GS4 = 415,
-    NOTE_A4 = 440,
-    NOTE_AS4 = 466,
-    NOTE_B4 = 494,
-    NOTE_C5 = 523,
-    NOTE_CS5 = 554,
-    NOTE_D5 = 587,
-    NOTE_DS5 = 622,
-    NOTE_E5 = 659,
-    NOTE_F5 = 698,
-    NOTE_FS5 = 740,
-    NOTE_G5 = 784,
-    NOTE_GS5 = 831,
-    NOTE_A5 = 880,
-    NOTE_AS5 = 932,
-    NOTE_B5 = 988,
-    NOTE_C6 = 1047,
-    NOTE_CS6 = 1109,
-    NOTE_D6 = 1175,
-    NOTE_DS6 = 1245,
-    NOTE_E6 = 1319,
-    NOTE_F6 = 1397,
-    NOTE_FS6 = 1480,
-    NOTE_G6 = 1568,
-    NOTE_GS6 = 1661,
-    NOTE_A6 = 1760
-} MusicNote;
-
-// Note structure for sequencer
+ * Plays compiled event streams with tempo control. Each of the four
+ * voices borrows a PSG channel from psg.h at music priority; a sound
+ * effect can take it, and the voice picks up a free channel at its next
+ * note.
+ *
+ * The calls below post commands to the vsync audio tick (audio.h), which
+ * owns the sequencer; the ones under "Audio tick side" are what it runs.
+ */
+
+/*
+ * Songs are event streams compiled from the tracker exports in music/ by
+ * tools/furnace_to_c.py --songs (into music_songs.h). Time is counted in
+ * rows of frames_per_beat frames; a voice is one of the four music parts.
+ * Events only carry what changed:
+ *
+ *   0x00-0x3F  voice event, (kind << 2) | voice
+ *      kind 0  NOTE i        frequency word i of the song's table, gate on
+ *      kind 1  TRIG          gate on again at the voice's frequency
+ *      kind 2  LEN n         later notes hold the gate n rows (0: until OFF)
+ *      kind 3  PATCH d a v w duty, vol_attack, vol_decay, wave_release
+ *      kind 4  OFF           gate off
+ *   0x40 WAIT n              n rows, n a varint (7 bits a byte, low first)
+ *   0x41 CALL lo hi          run the events at that offset up to RET
+ *   0x42 RET
+ *   0x43 JUMP lo hi          go on from that offset (loops the song)
+ *   0x44 END                 stop
+ *   0x80-0xFF                WAIT 1-128 rows
+ *
+ * A gate is released a few frames before its note's rows are up, so
+ * back-to-back notes on a voice stay separate.
+ */
+
 typedef struct {
-    uint16_t freq;      // Frequency in Hz (0 = rest)
-    uint8_t duration;   // Duration in beats (at 120 BPM, 1 beat = 30 frames)
-} Note;
+    const uint16_t *freqs;      // PSG frequency words (Hz * 3)
+    const uint8_t *events;
+} MusicSong;
 
 /**
  * Initialize the music system
@@ -87,14 +51,13 @@ typedef struct {
 void init_music(void);
 
 /**
- * Start playing music with custom tracks
- * Pass NULL for any track to skip it
- * @param melody Melody note sequence (plays on channel 4 with square wave)
- * @param bass Bass note sequence (plays on channel 5 with triangle wave)
- * @param kick Kick drum sequence (plays on channel 6)
- * @param hihat Hi-hat sequence (plays on channel 7)
+ * Start playing a song from its first event
  */
-void start_music(const Note* melody, const Note* bass, const Note* kick, const Note* hihat);
+void start_music(const MusicSong *song);
+
+// Register log the title music streams from (see music_stream.h); the
+// built-in title song plays if it can't be opened
+extern const char *title_music_stream;
 
 /**
  * Start playing the title screen music
@@ -119,12 +82,6 @@ void start_end_music(void);
  */
 void stop_music(void);
 
-/**
- * Update music playback - call once per frame
- * Handles tempo timing and note progression
- */
-void update_music(void);
-
 /**
  * Check if music is currently playing
  */
@@ -142,4 +99,34 @@ void increase_music_tempo(void);
  */
 void reset_music_tempo(void);
 
+// ----------------------------------------------------------------------------
+// Audio tick side
+// ----------------------------------------------------------------------------
+
+/**
+ * Stop whatever plays and start a song from its first event
+ */
+void music_play(const MusicSong *song);
+
+/**
+ * Stop whatever plays and start the register log buffered from ring
+ * position `at` (music_stream.h)
+ */
+void music_play_stream(uint8_t at);
+
+/**
+ * Stop the music and give its channels back
+ */
+void music_halt(void);
+
+/**
+ * Set the row length in frames
+ */
+void music_set_tempo(uint8_t frames_per_beat);
+
+/**
+ * Step the music by one frame: tempo timing and note progression
+ */
+void update_music(void);
+
 #endif // MUSIC_H
@@ -0,0 +1,54 @@
+// Generated by tools/furnace_to_c.py from music/*.txt - do not edit
+#ifndef MUSIC_SONGS_H
+#define MUSIC_SONGS_H
+
+#include <stdint.h>
+#include "music.h"
+
+// title.txt: 105 bytes of events, 4 notes
+static const uint16_t title_freqs[] = {
+    0x00C3, 0x0189, 0x0126, 0x024C,
+};
+static const uint8_t title_events[] = {
+    0x0D, 0x40, 0x01, 0xA2, 0x33, 0x09, 0x01, 0x01, 0x00, 0x80, 0x01, 0x01,
+    0x80, 0x01, 0x00, 0x80, 0x01, 0x01, 0x80, 0x01, 0x00, 0x80, 0x01, 0x01,
+    0x80, 0x01, 0x00, 0x80, 0x01, 0x01, 0x80, 0x41, 0x37, 0x00, 0x41, 0x37,
+    0x00, 0x41, 0x37, 0x00, 0x41, 0x50, 0x00, 0x41, 0x50, 0x00, 0x41, 0x50,
+    0x00, 0x41, 0x50, 0x00, 0x43, 0x00, 0x00, 0x01, 0x00, 0x80, 0x01, 0x01,
+    0x80, 0x01, 0x00, 0x80, 0x01, 0x01, 0x80, 0x01, 0x00, 0x80, 0x01, 0x01,
+    0x80, 0x01, 0x00, 0x80, 0x01, 0x01, 0x80, 0x42, 0x01, 0x02, 0x80, 0x01,
+    0x03, 0x80, 0x01, 0x02, 0x80, 0x01, 0x03, 0x80, 0x01, 0x02, 0x80, 0x01,
+    0x03, 0x80, 0x01, 0x02, 0x80, 0x01, 0x03, 0x80, 0x42,
+};
+static const MusicSong SONG_TITLE = { title_freqs, title_events };
+
+// end.txt: 238 bytes of events, 15 notes
+static const uint16_t end_freqs[] = {
+    0x0498, 0x0189, 0x0C45, 0x0621, 0x024C, 0x07B9, 0x0312, 0x0930,
+    0x082E, 0x06E1, 0x05CA, 0x0372, 0x0417, 0x020D, 0x0528,
+};
+static const uint8_t end_events[] = {
+    0x0C, 0x40, 0x01, 0xA2, 0x33, 0x08, 0x01, 0x00, 0x00, 0x0D, 0x40, 0x01,
+    0xA2, 0x33, 0x09, 0x01, 0x01, 0x01, 0x0E, 0x80, 0x00, 0xF7, 0x30, 0x0A,
+    0x02, 0x02, 0x01, 0x0F, 0xFF, 0x40, 0xF2, 0x42, 0x0B, 0x01, 0x03, 0x02,
+    0x80, 0x00, 0x03, 0x01, 0x04, 0x07, 0x80, 0x00, 0x05, 0x01, 0x06, 0x06,
+    0x07, 0x80, 0x00, 0x07, 0x01, 0x04, 0x07, 0x80, 0x00, 0x08, 0x01, 0x01,
+    0x06, 0x07, 0x80, 0x00, 0x05, 0x01, 0x04, 0x07, 0x80, 0x00, 0x09, 0x01,
+    0x06, 0x06, 0x07, 0x80, 0x00, 0x03, 0x01, 0x04, 0x07, 0x80, 0x00, 0x00,
+    0x05, 0x06, 0x07, 0x80, 0x00, 0x0A, 0x01, 0x0B, 0x07, 0x80, 0x00, 0x09,
+    0x01, 0x00, 0x06, 0x07, 0x80, 0x00, 0x07, 0x01, 0x0B, 0x07, 0x80, 0x00,
+    0x08, 0x01, 0x04, 0x06, 0x07, 0x80, 0x00, 0x05, 0x01, 0x0B, 0x07, 0x80,
+    0x00, 0x09, 0x01, 0x00, 0x06, 0x07, 0x80, 0x00, 0x0A, 0x01, 0x0B, 0x07,
+    0x80, 0x00, 0x0C, 0x01, 0x0D, 0x06, 0x07, 0x80, 0x00, 0x0E, 0x01, 0x06,
+    0x07, 0x80, 0x00, 0x03, 0x01, 0x0C, 0x06, 0x07, 0x80, 0x00, 0x08, 0x01,
+    0x06, 0x07, 0x80, 0x00, 0x05, 0x01, 0x0D, 0x06, 0x07, 0x80, 0x00, 0x09,
+    0x01, 0x06, 0x07, 0x80, 0x00, 0x03, 0x01, 0x0C, 0x06, 0x07, 0x80, 0x00,
+    0x0E, 0x01, 0x06, 0x07, 0x80, 0x00, 0x00, 0x01, 0x04, 0x06, 0x07, 0x80,
+    0x00, 0x0A, 0x01, 0x0B, 0x07, 0x80, 0x00, 0x09, 0x01, 0x00, 0x06, 0x07,
+    0x80, 0x00, 0x08, 0x01, 0x0B, 0x07, 0x80, 0x08, 0x02, 0x00, 0x05, 0x01,
+    0x01, 0x06, 0x07, 0x80, 0x01, 0x04, 0x07, 0x80, 0x00, 0x03, 0x01, 0x06,
+    0x06, 0x07, 0x80, 0x01, 0x04, 0x07, 0x80, 0x43, 0x00, 0x00,
+};
+static const MusicSong SONG_END = { end_freqs, end_events };
+
+#endif // MUSIC_SONGS_H
@@ -0,0 +1,284 @@
+/*
+ * music_stream.c - PSG register logs streamed from storage
+ *
+ * The reader (the game) and the player (the audio tick) share a byte
+ * ring with byte-wide positions, so each side's position is written in
+ * one store and the other side always sees a whole value. One byte is
+ * kept free to tell a full ring from an empty one.
+ *
+ * music_stream_fill() only reads whole chunks into free space that
+ * doesn't wrap, so on the Picocomputer each top-up is one read() of
+ * MUSIC_STREAM_CHUNK bytes; at the end of the file it seeks back to the
+ * loop point. The player never consumes half an event: if the ring runs
+ * dry mid-event it picks up again next frame.
+ */
+
+#include <rp6502.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "psg.h"
+#include "audio.h"
+#include "music_stream.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define LOG_HEADER_BYTES    12
+#define LOG_VERSION         1
+#define LOG_CHANNELS        8
+
+#define OP_WAIT             0x40
+#define OP_WAIT_SHORT       0x80
+
+#if MUSIC_STREAM_RING != 256
+#error "music_stream.c wraps ring positions as uint8_t"
+#endif
+
+// Keeps the compiler from moving ring accesses across a position update
+#define barrier()           __asm__ volatile ("" ::: "memory")
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static uint8_t ring[MUSIC_STREAM_RING];
+
+// Game side
+static int fd = -1;
+static uint32_t loop_offset = 0;
+static volatile bool at_end = false;        // File read to the end, no loop
+static volatile uint8_t ring_head = 0;      // Next byte written
+
+// Audio tick side
+static volatile uint8_t ring_tail = 0;      // Next byte played
+static bool playing = false;
+static uint16_t wait_frames = 0;
+
+// Register image of each log channel, to set up a new PSG channel after
+// a sound effect took the last one
+static uint8_t regs[LOG_CHANNELS][8];
+static uint8_t channel[LOG_CHANNELS];       // PSG channel, or PSG_VOICE_NONE
+static uint8_t channel_tag[LOG_CHANNELS];
+
+// ============================================================================
+// GAME SIDE
+// ============================================================================
+
+void music_stream_fill(void)
+{
+    if (fd < 0 || at_end) {
+        return;
+    }
+    uint8_t head = ring_head;
+    uint8_t room = MUSIC_STREAM_RING - 1 - (uint8_t)(head - ring_tail);
+    uint16_t n = MUSIC_STREAM_RING - head;          // Up to the wrap
+    if (room < MUSIC_STREAM_CHUNK) {
+        return;
+    }
+    if (n > MUSIC_STREAM_CHUNK) {
+        n = MUSIC_STREAM_CHUNK;
+    }
+
+    int got = read(fd, &ring[head], n);
+    if (got <= 0) {
+        // End of the log (or a read error): around again, or stop reading
+        if (got < 0 || !loop_offset || lseek(fd, loop_offset, SEEK_SET) < 0) {
+            at_end = true;
+        }
+        return;
+    }
+    barrier();
+    ring_head = head + got;
+}
+
+bool music_stream_start(const char *path)
+{
+    music_stream_close();
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    uint8_t header[LOG_HEADER_BYTES];
+    if (read(fd, header, LOG_HEADER_BYTES) != LOG_HEADER_BYTES ||
+        memcmp(header, "RPSG", 4) != 0 || header[4] != LOG_VERSION) {
+        printf("ERROR: %s is not a PSG register log\n", path);
+        music_stream_close();
+        return false;
+    }
+    loop_offset = header[8] | ((uint32_t)header[9] << 8) |
+                  ((uint32_t)header[10] << 16) | ((uint32_t)header[11] << 24);
+    at_end = false;
+
+    // Queued before any of the log is buffered: until the tick takes the
+    // command, the old log's player stops at the head it can see
+    if (!audio_send(AUDIO_CMD_STREAM, ring_head, NULL)) {
+        music_stream_close();
+        return false;
+    }
+    for (uint8_t n = MUSIC_STREAM_RING / MUSIC_STREAM_CHUNK; n > 0; n--) {
+        music_stream_fill();
+    }
+    return true;
+}
+
+void music_stream_close(void)
+{
+    if (fd < 0) {
+        return;
+    }
+    close(fd);
+    fd = -1;
+}
+
+// ============================================================================
+// AUDIO TICK SIDE
+// ============================================================================
+
+static uint8_t ring_peek(uint8_t k)
+{
+    return ring[(uint8_t)(ring_tail + k)];
+}
+
+/**
+ * PSG channel of a log channel, taking (and setting up) a free one if
+ * needed; PSG_VOICE_NONE while none can be had
+ */
+static uint8_t channel_of(uint8_t c)
+{
+    uint8_t ch = channel[c];
+    if (ch != PSG_VOICE_NONE && psg_voice_tag(ch) == channel_tag[c]) {
+        return ch;
+    }
+
+    ch = psg_voice_alloc(PSG_PRIO_MUSIC, 0);
+    channel[c] = ch;
+    if (ch != PSG_VOICE_NONE) {
+        channel_tag[c] = psg_voice_tag(ch);
+        for (uint8_t r = 0; r < PSG_REG_PAN_GATE; r++) {
+            psg_write(ch, r, regs[c][r]);
+        }
+        if (regs[c][PSG_REG_PAN_GATE] & 1) {
+            psg_gate(ch, true);
+        }
+    }
+    return ch;
+}
+
+static void apply_write(uint8_t op, uint8_t val)
+{
+    uint8_t c = op >> 3;
+    uint8_t r = op & 7;
+    regs[c][r] = val;
+
+    uint8_t ch = channel_of(c);
+    if (ch == PSG_VOICE_NONE) {
+        return;
+    }
+    if (r == PSG_REG_PAN_GATE) {
+        psg_gate(ch, val & 1);
+    } else {
+        psg_write(ch, r, val);
+    }
+}
+
+/**
+ * Bytes of the event at the ring's tail, or 0 if it isn't all buffered
+ */
+static uint8_t event_length(uint8_t used)
+{
+    if (used == 0) {
+        return 0;
+    }
+    uint8_t op = ring_peek(0);
+    if (op < OP_WAIT) {
+        return used >= 2 ? 2 : 0;
+    }
+    if (op != OP_WAIT) {
+        return 1;
+    }
+    for (uint8_t k = 1; k < used && k <= 3; k++) {
+        if (!(ring_peek(k) & 0x80)) {
+            return k + 1;
+        }
+    }
+    return 0;
+}
+
+void music_stream_begin(uint8_t at)
+{
+    music_stream_end();
+
+    memset(regs, 0, sizeof(regs));
+    memset(channel, PSG_VOICE_NONE, sizeof(channel));
+    ring_tail = at;
+    wait_frames = 0;
+    playing = true;
+}
+
+void music_stream_end(void)
+{
+    if (!playing) {
+        return;
+    }
+    for (uint8_t c = 0; c < LOG_CHANNELS; c++) {
+        uint8_t ch = channel[c];
+        if (ch != PSG_VOICE_NONE && psg_voice_tag(ch) == channel_tag[c]) {
+            psg_voice_release(ch);
+        }
+    }
+    playing = false;
+}
+
+bool music_stream_active(void)
+{
+    return playing;
+}
+
+void music_stream_update(void)
+{
+    if (!playing) {
+        return;
+    }
+    if (wait_frames > 1) {
+        wait_frames--;
+        return;
+    }
+    wait_frames = 0;
+
+    uint8_t used = ring_head - ring_tail;
+    for (;;) {
+        uint8_t len = event_length(used);
+        if (len == 0) {
+            if (at_end && used == 0) {
+                music_stream_end();     // Played out, no loop
+            }
+            break;                      // Starved: carry on next frame
+        }
+
+        uint8_t op = ring_peek(0);
+        if (op < OP_WAIT) {
+            apply_write(op, ring_peek(1));
+        } else if (op >= OP_WAIT_SHORT || op == OP_WAIT) {
+            uint16_t frames = op - OP_WAIT_SHORT + 1;
+            if (op == OP_WAIT) {
+                frames = 0;
+                for (uint8_t k = len - 1; k >= 1; k--) {
+                    frames = (frames << 7) | (ring_peek(k) & 0x7F);
+                }
+            }
+            wait_frames = frames;
+        }                               // Anything else is reserved
+        ring_tail = ring_tail + len;
+        used -= len;
+        if (wait_frames) {
+            break;
+        }
+    }
+}
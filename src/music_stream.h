@@ -0,0 +1,71 @@
+#ifndef MUSIC_STREAM_H
+#define MUSIC_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * music_stream.h - PSG register logs streamed from storage
+ *
+ * A register log (tools/parse_vgm.py) is a frame-timed list of PSG
+ * register writes: long tracks at full detail, far too big to sit in
+ * RAM. The file stays open and is read through a small ring buffer,
+ * topped up a chunk at a time while the game waits for vsync. Each audio
+ * tick applies the writes that are due, through the PSG shadow (psg.h)
+ * on channels borrowed at music priority.
+ *
+ * The game owns the file and the ring's head, the audio tick (audio.h)
+ * owns the player and the ring's tail; neither writes the other's side.
+ */
+
+#define MUSIC_STREAM_RING   256     // Bytes buffered (byte-wide ring positions)
+#define MUSIC_STREAM_CHUNK  64      // Bytes per read
+
+// Title music log, packed into the ROM
+#define MUSIC_STREAM_TITLE  "ROM:title.psg"
+
+// ----------------------------------------------------------------------------
+// Game side
+// ----------------------------------------------------------------------------
+
+/**
+ * Open a register log, queue its start and fill the buffer; false (and
+ * nothing queued) if the file is missing or not a log
+ */
+bool music_stream_start(const char *path);
+
+/**
+ * Stop reading and close the file; the player is stopped with the music
+ */
+void music_stream_close(void);
+
+/**
+ * Read one chunk if the buffer has room; call while waiting for vsync
+ */
+void music_stream_fill(void);
+
+// ----------------------------------------------------------------------------
+// Audio tick side
+// ----------------------------------------------------------------------------
+
+/**
+ * Start playing the log whose bytes begin at ring position `at`
+ */
+void music_stream_begin(uint8_t at);
+
+/**
+ * Stop playing and give the channels back
+ */
+void music_stream_end(void);
+
+/**
+ * True while a log is playing
+ */
+bool music_stream_active(void);
+
+/**
+ * Apply this frame's register writes
+ */
+void music_stream_update(void);
+
+#endif // MUSIC_STREAM_H
@@ -0,0 +1,101 @@
+/*
+ * overlay.c - Gameplay message text on a Mode 1 text plane
+ *
+ * The plane shares plane 2 with the HUD: the HUD's Mode 1 program covers
+ * the scanlines of its own rows and this one covers the rest. Cells are
+ * 3 bytes like the HUD's (glyph, foreground, background) and every write
+ * streams a run of cells through RIA.rw0 after one address load.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <rp6502.h>
+#include "constants.h"
+#include "palette.h"
+#include "overlay.h"
+
+#define OVERLAY_CELL_BYTES  3
+#define OVERLAY_MODE_ATTR   3       // Mode 1 attributes: 8x8 font, 8bpp colour cells
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+uint8_t overlay_row_at(int16_t y)
+{
+    if (y < OVERLAY_Y) {
+        return 0;
+    }
+    y = (y - OVERLAY_Y) >> 3;
+    return y < OVERLAY_ROWS ? y : OVERLAY_ROWS - 1;
+}
+
+void overlay_init(void)
+{
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, x_wrap, false);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, y_wrap, false);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, x_pos_px, 0);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, y_pos_px, SCREEN_HEIGHT);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, width_chars, OVERLAY_COLS);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, height_chars, OVERLAY_ROWS);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, xram_data_ptr, OVERLAY_DATA);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, xram_palette_ptr, PALETTE_ADDR);
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, xram_font_ptr, 0xFFFF);
+
+    // Plane 2 below the HUD rows
+    xregn(1, 0, 1, 6, 1, OVERLAY_MODE_ATTR, OVERLAY_CONFIG, 2, HUD_SCANLINES, SCREEN_HEIGHT);
+}
+
+void overlay_show(bool show)
+{
+    // The buffer shares XRAM with the top bitmap rows, so it holds
+    // garbage outside gameplay; hidden means parked below the screen
+    if (show) {
+        overlay_clear();
+    }
+    xram0_struct_set(OVERLAY_CONFIG, vga_mode1_config_t, y_pos_px,
+                     show ? OVERLAY_Y : SCREEN_HEIGHT);
+}
+
+void overlay_text(uint8_t col, uint8_t row, const char *text, uint8_t colour)
+{
+    if (row >= OVERLAY_ROWS) {
+        return;
+    }
+    RIA.addr0 = OVERLAY_DATA + (row * OVERLAY_COLS + col) * OVERLAY_CELL_BYTES;
+    RIA.step0 = 1;
+    for (; *text && col < OVERLAY_COLS; text++, col++) {
+        RIA.rw0 = *text;
+        RIA.rw0 = colour;
+        RIA.rw0 = 0x00;     // Palette entry 0: transparent
+    }
+}
+
+void overlay_text_centered(uint8_t row, const char *text, uint8_t colour)
+{
+    size_t len = strlen(text);
+    overlay_text(len < OVERLAY_COLS ? (OVERLAY_COLS - len) / 2 : 0, row, text, colour);
+}
+
+void overlay_clear_rows(uint8_t row, uint8_t count)
+{
+    if (row >= OVERLAY_ROWS) {
+        return;
+    }
+    if (count > OVERLAY_ROWS - row) {
+        count = OVERLAY_ROWS - row;
+    }
+    RIA.addr0 = OVERLAY_DATA + row * OVERLAY_COLS * OVERLAY_CELL_BYTES;
+    RIA.step0 = 1;
+    for (uint16_t n = count * OVERLAY_COLS; n > 0; n--) {
+        RIA.rw0 = ' ';
+        RIA.rw0 = 0x00;
+        RIA.rw0 = 0x00;
+    }
+}
+
+void overlay_clear(void)
+{
+    overlay_clear_rows(0, OVERLAY_ROWS);
+}
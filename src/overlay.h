@@ -0,0 +1,61 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * overlay.h - Gameplay message text on a Mode 1 text plane
+ *
+ * Pause, level-up, demo, crash and game over messages used to be plotted
+ * as 3x5 pixel glyphs into the bitmap and erased again with a rectangle
+ * fill. They are now character cells (glyph, foreground, background) on
+ * a 40x20 text plane over the playfield: a message is a few dozen byte
+ * writes and is erased by blanking its cells.
+ *
+ * Foreground colours are bitmap palette indices, so the palette bands
+ * (pause letters, demo banner, game over) keep cycling. The buffer lives
+ * in the bitmap rows hidden under the HUD (see PLAYFIELD_TOP), so the
+ * overlay only exists during gameplay.
+ */
+
+#define OVERLAY_COLS    40
+#define OVERLAY_ROWS    20
+#define OVERLAY_Y       20      // Screen y of row 0; rows are 8 pixels
+
+/**
+ * Row under screen y (clamped to the overlay)
+ */
+uint8_t overlay_row_at(int16_t y);
+
+/**
+ * Write the plane config; call once at startup
+ */
+void overlay_init(void);
+
+/**
+ * Show the plane (and blank it) or hide it
+ */
+void overlay_show(bool show);
+
+/**
+ * Write a string from cell (col, row); text past the right edge is dropped
+ */
+void overlay_text(uint8_t col, uint8_t row, const char *text, uint8_t colour);
+
+/**
+ * Write a string centred on a row
+ */
+void overlay_text_centered(uint8_t row, const char *text, uint8_t colour);
+
+/**
+ * Blank `count` rows starting at `row`
+ */
+void overlay_clear_rows(uint8_t row, uint8_t count);
+
+/**
+ * Blank the whole overlay
+ */
+void overlay_clear(void);
+
+#endif // OVERLAY_H
@@ -0,0 +1,141 @@
+/*
+ * palette.c - Palette animation for the 8bpp bitmap
+ *
+ * Rainbow effects used to re-plot their pixels with a new colour index
+ * (every star every fourth frame, the high score table every 15 frames).
+ * Here each effect owns a band of palette indices and rewrites only the
+ * band's entries when its phase moves: port 1 reads the ring colour,
+ * port 0 streams the band with one address load.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <rp6502.h>
+#include "palette.h"
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct {
+    bool running;
+    uint8_t first;          // First palette index of the band
+    uint8_t count;          // Entries in the band
+    uint8_t ring_first;     // First palette index of the colour ring
+    uint8_t ring_len;
+    uint8_t spacing;        // Ring distance between neighbouring entries
+    uint8_t period;         // Frames per phase step
+    uint8_t timer;
+    uint8_t phase;
+    uint16_t saved[PAL_BAND_MAX];   // Band colours before the effect
+} pal_effect_t;
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static pal_effect_t effects[PAL_FX_COUNT];
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+/**
+ * Write the band for the effect's current phase
+ */
+static void write_band(const pal_effect_t *fx)
+{
+    uint8_t ring_pos = fx->phase;
+
+    RIA.addr0 = PALETTE_ADDR + fx->first * 2;
+    RIA.step0 = 1;
+    RIA.step1 = 1;
+    for (uint8_t k = 0; k < fx->count; k++) {
+        RIA.addr1 = PALETTE_ADDR + (fx->ring_first + ring_pos) * 2;
+        uint8_t lo = RIA.rw1;
+        uint8_t hi = RIA.rw1;
+        RIA.rw0 = lo;
+        RIA.rw0 = hi;
+
+        ring_pos += fx->spacing;
+        if (ring_pos >= fx->ring_len) {
+            ring_pos -= fx->ring_len;
+        }
+    }
+}
+
+void palette_effect_start(PaletteEffect fx, uint8_t first, uint8_t count, uint8_t ring_first,
+                          uint8_t ring_len, uint8_t spacing, uint8_t period)
+{
+    pal_effect_t *e = &effects[fx];
+
+    if (count > PAL_BAND_MAX) {
+        printf("ERROR: palette band of %u entries, max is %u\n", count, PAL_BAND_MAX);
+        count = PAL_BAND_MAX;
+    }
+
+    // Keep the colours saved on the first start so a restart can't
+    // capture the effect's own output
+    if (e->running && (e->first != first || e->count != count)) {
+        palette_effect_stop(fx);
+    }
+    if (!e->running) {
+        RIA.addr0 = PALETTE_ADDR + first * 2;
+        RIA.step0 = 1;
+        for (uint8_t k = 0; k < count; k++) {
+            uint8_t lo = RIA.rw0;
+            uint8_t hi = RIA.rw0;
+            e->saved[k] = lo | (hi << 8);
+        }
+    }
+
+    e->running = true;
+    e->first = first;
+    e->count = count;
+    e->ring_first = ring_first;
+    e->ring_len = ring_len ? ring_len : 1;
+    e->spacing = spacing % e->ring_len;
+    e->period = period ? period : 1;
+    e->timer = e->period;
+    e->phase = 0;
+    write_band(e);
+}
+
+void palette_effect_stop(PaletteEffect fx)
+{
+    pal_effect_t *e = &effects[fx];
+    if (!e->running) {
+        return;
+    }
+    e->running = false;
+
+    RIA.addr0 = PALETTE_ADDR + e->first * 2;
+    RIA.step0 = 1;
+    for (uint8_t k = 0; k < e->count; k++) {
+        RIA.rw0 = e->saved[k] & 0xFF;
+        RIA.rw0 = e->saved[k] >> 8;
+    }
+}
+
+void palette_stop_all(void)
+{
+    for (uint8_t i = PAL_FX_COUNT; i-- > 0; ) {
+        palette_effect_stop((PaletteEffect)i);
+    }
+}
+
+void update_palette(void)
+{
+    for (uint8_t i = 0; i < PAL_FX_COUNT; i++) {
+        pal_effect_t *e = &effects[i];
+        if (!e->running || --e->timer) {
+            continue;
+        }
+        e->timer = e->period;
+        if (++e->phase >= e->ring_len) {
+            e->phase = 0;
+        }
+        write_band(e);
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <stdint.h>
+
+/**
+ * palette.h - Palette animation for the 8bpp bitmap
+ *
+ * Colour-cycling effects draw their pixels once with indices from a
+ * reserved band; the engine then animates the band's 16-bit palette
+ * entries, so the pixels change colour without touching the bitmap.
+ *
+ * Entry k of a band shows ring colour (phase + k * spacing) % ring_len,
+ * where the ring is a run of existing palette entries (normally the
+ * rainbow at PAL_RAINBOW_FIRST) and the phase advances by one every
+ * `period` frames. The band's original colours are restored on stop.
+ */
+
+#define PALETTE_ADDR        0xF000   // 256 entries, 2 bytes each
+#define PAL_RAINBOW_FIRST   32       // Rainbow ramp, indices 32-255
+#define PAL_RAINBOW_LEN     224
+
+// Reserved bands. The title image only uses indices 1-15, so gameplay
+// effects take those; the title and game over screens use 16-31. Bands
+// that overlap (the logo colour and the pause letters) are never live at
+// the same time.
+#define PAL_BAND_STARS      1        // 8 entries (1-8)
+#define PAL_STARS_LEN       8
+#define PAL_BAND_PAUSE      9        // 6 entries (9-14), one per letter
+#define PAL_BAND_DEMO       15       // 1 entry
+#define PAL_INDEX_LOGO      11       // Title image colour cycled on the title screen
+#define PAL_BAND_SCORES     16       // 11 entries (16-26): 10 rows + heading
+#define PAL_INDEX_PRESS     27       // "PRESS START"
+#define PAL_BAND_GAME_OVER  28       // 2 entries: "GAME OVER", "PRESS FIRE"
+
+// Palette effects (one band each)
+typedef enum {
+    PAL_FX_STARS = 0,
+    PAL_FX_PAUSE,
+    PAL_FX_DEMO,
+    PAL_FX_LOGO,
+    PAL_FX_SCORES,
+    PAL_FX_PRESS,
+    PAL_FX_GAME_OVER,
+    PAL_FX_COUNT
+} PaletteEffect;
+
+// Most entries one band can animate
+#define PAL_BAND_MAX        16
+
+/**
+ * Start (or retune) an effect on palette indices [first, first + count)
+ */
+void palette_effect_start(PaletteEffect fx, uint8_t first, uint8_t count, uint8_t ring_first,
+                          uint8_t ring_len, uint8_t spacing, uint8_t period);
+
+/**
+ * Stop an effect and put its band's original colours back
+ */
+void palette_effect_stop(PaletteEffect fx);
+
+/**
+ * Stop every running effect
+ */
+void palette_stop_all(void);
+
+/**
+ * Advance running effects; call once per frame, in vblank
+ */
+void update_palette(void);
+
+#endif // PALETTE_H
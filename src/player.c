@@ -10,6 +10,13 @@
 #include <stdbool.h>
 #include <stdio.h> // added for printf debugging
 #include "explosions.h"
+#include "direction.h"
+#include "motion.h"
+#include "sprite_shadow.h"
+#include "camera.h"
+#ifdef PREROTATED_SHIP
+#include "splash_screen.h"
+#endif
 
 // ============================================================================
 // TYPES
@@ -32,7 +39,6 @@ extern unsigned BULLET_CONFIG;
 
 // Bullet array from main
 extern Bullet bullets[MAX_BULLETS];
-extern uint8_t current_bullet_index;
 
 // World scrolling state (modified by player movement)
 extern int16_t scroll_dx, scroll_dy;
@@ -53,9 +59,10 @@ int16_t player_vy_applied = 0;
 
 // Player internal state
 static int16_t player_vx = 0, player_vy = 0;
-static int16_t player_x_rem = 0, player_y_rem = 0;
+static uint8_t player_x_frac = 0, player_y_frac = 0;  // Sub-pixel position (see motion.h)
 static int16_t player_rotation = 0;
 static int16_t player_rotation_frame = 0;
+static int16_t sprite_rotation = -1;   // Rotation the sprite config shows (-1: none yet)
 static int16_t player_thrust_x = 0;
 static int16_t player_thrust_y = 0;
 static int16_t player_thrust_delay = 0;
@@ -114,10 +121,11 @@ void init_player(void)
     player_vy = 0;
     player_vx_applied = 0;
     player_vy_applied = 0;
-    player_x_rem = 0;
-    player_y_rem = 0;
+    player_x_frac = 0;
+    player_y_frac = 0;
     player_rotation = 0;
     player_rotation_frame = 0;
+    sprite_rotation = -1;
     player_thrust_x = 0;
     player_thrust_y = 0;
     player_thrust_delay = 0;
@@ -125,6 +133,8 @@ void init_player(void)
     bullet_cooldown = 0;
     player_is_dying = false;
     death_timer = 0;
+    camera_x = 0;
+    camera_y = 0;
 }
 
 void trigger_player_death(void) {
@@ -142,7 +152,7 @@ void trigger_player_death(void) {
     draw_explosion_flash(death_x, death_y, 12, 8, 192);
     
     // Hide the player sprite immediately
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, -100);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, -100);
 }
 
 void reset_player_position(void)
@@ -155,8 +165,8 @@ void reset_player_position(void)
     player_thrust_y = 0;
     
     // Update sprite position
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, x_pos_px, player_x);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, player_y);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, x_pos_px, player_x);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, player_y);
 }
 
 void update_player(bool demomode)
@@ -182,9 +192,7 @@ void update_player(bool demomode)
             for (int i = 0; i < 3; i++) {
                 int16_t dot_x = death_x + (int16_t)random(0, 4) - 2;
                 int16_t dot_y = death_y + (int16_t)random(0, 4) - 2;
-                if (dot_x >= 0 && dot_x < SCREEN_WIDTH && dot_y >= 0 && dot_y < SCREEN_HEIGHT) {
-                    set(dot_x, dot_y, trail_color);
-                }
+                raster_pixel(dot_x, dot_y, trail_color);
             }
         }
         
@@ -204,7 +212,7 @@ void update_player(bool demomode)
             // Randomize location around the frozen death position
             int16_t ex = death_x + (int16_t)random(0, 40) - 20;
             int16_t ey = death_y + (int16_t)random(0, 40) - 20;
-            start_explosion(ex, ey);
+            start_explosion(world_x(ex), world_y(ey));
         }
 
         // When timer hits 0, trigger the actual Game Over
@@ -227,21 +235,12 @@ void update_player(bool demomode)
                 // Compute vector from player to screen center.
                 int16_t cx = SCREEN_WIDTH_D2;
                 int16_t cy = SCREEN_HEIGHT_D2;
-                int32_t dx = (int32_t)cx - (int32_t)player_x;
-                int32_t dy = (int32_t)cy - (int32_t)player_y;
-
-                // Find best rotation index pointing toward center by maximizing dot(thrust_vector, center_vector)
-                int best_rot = 0;
-                int32_t best_dot = INT32_MIN;
-                for (int r = 0; r < SHIP_ROTATION_STEPS; r++) {
-                    int32_t tvx = - (int32_t)sin_fix[r];
-                    int32_t tvy = - (int32_t)cos_fix[r];
-                    int32_t dot = tvx * dx + tvy * dy;
-                    if (dot > best_dot) {
-                        best_dot = dot;
-                        best_rot = r;
-                    }
-                }
+                int16_t dx = cx - player_x;
+                int16_t dy = cy - player_y;
+
+                // Find best rotation index pointing toward center by maximizing dot(thrust_vector, center_vector).
+                // Thrust is (-sin, -cos), so that dot is (-dy) * cos + (-dx) * sin.
+                int best_rot = direction_from_vector(-dy, -dx);
 
                 int diff = rotation_diff(player_rotation, best_rot);
 
@@ -305,15 +304,16 @@ void update_player(bool demomode)
             // Compute vector to screen center
             int16_t cx = SCREEN_WIDTH_D2;
             int16_t cy = SCREEN_HEIGHT_D2;
-            int32_t dx = (int32_t)cx - (int32_t)player_x;
-            int32_t dy = (int32_t)cy - (int32_t)player_y;
+            int16_t dx = cx - player_x;
+            int16_t dy = cy - player_y;
 
             // Current facing thrust vector
-            int32_t tvx = - (int32_t)sin_fix[player_rotation];
-            int32_t tvy = - (int32_t)cos_fix[player_rotation];
+            int16_t tvx = -sin_fix[player_rotation];
+            int16_t tvy = -cos_fix[player_rotation];
 
-            // Dot product: positive means facing toward center
-            int64_t dot = (int64_t)tvx * dx + (int64_t)tvy * dy;
+            // Dot product: positive means facing toward center (screen-sized
+            // offsets times 255 fit comfortably in 32 bits)
+            int32_t dot = (int32_t)tvx * dx + (int32_t)tvy * dy;
 
             // Base thrust probability
             uint16_t base_prob = 80; // percent
@@ -368,11 +368,9 @@ void update_player(bool demomode)
     int16_t total_vx = player_vx + player_thrust_x;
     int16_t total_vy = player_vy + player_thrust_y;
     
-    player_vx_applied = (total_vx + player_x_rem) >> 9;
-    player_vy_applied = (total_vy + player_y_rem) >> 9;
-    
-    player_x_rem = total_vx + player_x_rem - (player_vx_applied << 9);
-    player_y_rem = total_vy + player_y_rem - (player_vy_applied << 9);
+    // Velocities are in 1/512 pixel units; halve to Q8.8
+    player_vx_applied = motion_advance(&player_x_frac, total_vx >> 1);
+    player_vy_applied = motion_advance(&player_y_frac, total_vy >> 1);
     
     // Apply friction when not thrusting
     if (!thrust) {
@@ -414,33 +412,49 @@ void update_player(bool demomode)
         scroll_dy = new_y - player_y;
     }
 
+    // The world stays put; the camera follows the scroll (wrapping with
+    // the 16-bit world)
+    camera_x = world_x(scroll_dx);
+    camera_y = world_y(scroll_dy);
+
     // printf("Player position: x=%d, y=%d\n", player_x, player_y);
 }
 
 void update_player_sprite(void)
 {
     // Update sprite position
-    RIA.step0 = sizeof(vga_mode4_asprite_t);
-    RIA.step1 = sizeof(vga_mode4_asprite_t);
-    RIA.addr0 = SPACECRAFT_CONFIG + 12;
-    RIA.addr1 = SPACECRAFT_CONFIG + 13;
-    
-    RIA.rw0 = player_x & 0xFF;
-    RIA.rw1 = (player_x >> 8) & 0xFF;
-    
-    RIA.addr0 = SPACECRAFT_CONFIG + 14;
-    RIA.addr1 = SPACECRAFT_CONFIG + 15;
-    RIA.rw0 = player_y & 0xFF;
-    RIA.rw1 = (player_y >> 8) & 0xFF;
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, x_pos_px, player_x);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, player_y);
     
+    // Rotation only changes every SHIP_ROT_SPEED frames at most
+    if (player_rotation == sprite_rotation) {
+        return;
+    }
+    sprite_rotation = player_rotation;
+
+#ifdef PREROTATED_SHIP
+    // Pick the pre-rotated frame; the transform stays at identity
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, xram_sprite_ptr,
+                      SHIP_FRAMES_DATA + player_rotation * SHIP_FRAME_BYTES);
+#else
     // Update rotation transform matrix
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[0],  cos_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[1], -sin_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[2],  t2_fix4[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[3],  sin_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[4],  cos_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[5],  t2_fix4[SHIP_ROTATION_MAX - player_rotation + 1]);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[0],  cos_fix[player_rotation]);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[1], -sin_fix[player_rotation]);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[2],  t2_fix4[player_rotation]);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[3],  sin_fix[player_rotation]);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[4],  cos_fix[player_rotation]);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[5],  t2_fix4[SHIP_ROTATION_MAX - player_rotation + 1]);
+#endif
+}
+
+#ifdef PREROTATED_SHIP
+void load_ship_frames(void)
+{
+    // The frames live in bitmap rows above the playfield, which the title
+    // image overwrites, so they are reloaded for every game
+    load_rom_to_xram("ROM:ship_rot.bin", SHIP_FRAMES_DATA, SHIP_ROTATION_STEPS * SHIP_FRAME_BYTES);
 }
+#endif
 
 void fire_bullet(void)
 {
@@ -448,27 +462,20 @@ void fire_bullet(void)
         return;
     }
     
-    if (bullets[current_bullet_index].status < 0) {
-        bullets[current_bullet_index].status = player_rotation;
-        bullets[current_bullet_index].x = player_x + 4;
-        bullets[current_bullet_index].y = player_y + 4;
-        bullets[current_bullet_index].vx_rem = 0;
-        bullets[current_bullet_index].vy_rem = 0;
-        
-        // Increment active bullet count
-        active_bullet_count++;
+    uint8_t slot = pool_alloc(&bullet_pool);
+    if (slot != POOL_NONE) {
+        bullets[slot].status = player_rotation;
+        bullets[slot].x = player_x + 4;
+        bullets[slot].y = player_y + 4;
+        bullets[slot].x_frac = 0;
+        bullets[slot].y_frac = 0;
         
-        unsigned ptr = BULLET_CONFIG + current_bullet_index * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, bullets[current_bullet_index].x);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, bullets[current_bullet_index].y);
+        unsigned ptr = BULLET_CONFIG + slot * sizeof(vga_mode4_sprite_t);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, bullets[slot].x);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, bullets[slot].y);
         
         play_sound(SFX_TYPE_PLAYER_FIRE, 110, PSG_WAVE_SQUARE, 0, 3, 4, 2);
         
-        current_bullet_index++;
-        if (current_bullet_index >= MAX_BULLETS) {
-            current_bullet_index = 0;
-        }
-        
         bullet_cooldown = BULLET_COOLDOWN;
     }
 }
@@ -33,6 +33,14 @@ void update_player(bool demomode);
  */
 void update_player_sprite(void);
 
+#ifdef PREROTATED_SHIP
+/**
+ * Load the 24 pre-rotated ship frames into SHIP_FRAMES_DATA; call once
+ * the gameplay playfield is set up
+ */
+void load_ship_frames(void);
+#endif
+
 /**
  * Fire a bullet from the player ship
  */
@@ -0,0 +1,59 @@
+/*
+ * pool.c - Fixed-capacity slot pools
+ *
+ * Spawning used to scan each entity array for an inactive slot and every
+ * update loop tested an active flag per slot. Pools keep a free list and
+ * a dense live list instead, so both spawn and despawn are constant time
+ * and loops only touch live objects.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "pool.h"
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void pool_init(pool_t *pool, uint8_t capacity)
+{
+    if (capacity > POOL_MAX_SLOTS) {
+        printf("ERROR: pool of %u slots, max is %u\n", capacity, POOL_MAX_SLOTS);
+        capacity = POOL_MAX_SLOTS;
+    }
+    pool->capacity = capacity;
+    pool->count = 0;
+
+    // Chain in ascending order so the first spawns get the low slots
+    for (uint8_t i = 0; i < capacity; i++) {
+        pool->link[i] = i + 1;
+    }
+    if (capacity > 0) {
+        pool->link[capacity - 1] = POOL_NONE;
+    }
+    pool->free_head = capacity > 0 ? 0 : POOL_NONE;
+}
+
+uint8_t pool_alloc(pool_t *pool)
+{
+    uint8_t slot = pool->free_head;
+    if (slot == POOL_NONE) {
+        return POOL_NONE;
+    }
+    pool->free_head = pool->link[slot];
+    pool->link[slot] = pool->count;
+    pool->live[pool->count++] = slot;
+    return slot;
+}
+
+void pool_free(pool_t *pool, uint8_t slot)
+{
+    // Move the last live slot into the hole
+    uint8_t pos = pool->link[slot];
+    uint8_t last = pool->live[--pool->count];
+    pool->live[pos] = last;
+    pool->link[last] = pos;
+
+    pool->link[slot] = pool->free_head;
+    pool->free_head = slot;
+}
@@ -0,0 +1,52 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+
+/**
+ * pool.h - Fixed-capacity slot pools with O(1) spawn and despawn
+ *
+ * A pool hands out slot indices into an entity array the caller owns
+ * (the slot number also picks the entity's sprite config). Free slots are
+ * chained through link[] (intrusive free list); live slots are packed in
+ * live[] and their link[] entry holds their position there, so a despawn
+ * is a swap with the last live entry.
+ *
+ * Update loops walk live[] from the end down:
+ *
+ *     for (uint8_t k = pool.count; k-- > 0; ) {
+ *         uint8_t i = pool.live[k];
+ *         ...
+ *     }
+ *
+ * so freeing the current slot is safe (the entry swapped into k was
+ * already visited) and slots spawned during the loop wait a frame.
+ */
+
+#define POOL_MAX_SLOTS 16
+#define POOL_NONE      0xFF
+
+typedef struct {
+    uint8_t capacity;
+    uint8_t count;                   // Live slots
+    uint8_t free_head;               // First free slot or POOL_NONE
+    uint8_t live[POOL_MAX_SLOTS];    // Dense list of live slots
+    uint8_t link[POOL_MAX_SLOTS];    // Free: next free slot; live: index in live[]
+} pool_t;
+
+/**
+ * Mark every slot free (capacity is clamped to POOL_MAX_SLOTS)
+ */
+void pool_init(pool_t *pool, uint8_t capacity);
+
+/**
+ * Take a free slot; returns POOL_NONE if the pool is full
+ */
+uint8_t pool_alloc(pool_t *pool);
+
+/**
+ * Return a live slot to the free list
+ */
+void pool_free(pool_t *pool, uint8_t slot);
+
+#endif // POOL_H
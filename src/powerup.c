@@ -4,6 +4,8 @@
 #include "powerup.h"
 #include "player.h"
 #include "sbullets.h"
+#include "sprite_shadow.h"
+#include "camera.h"
 
 powerup_t powerup = { .active = false, .timer = 0 };
 
@@ -13,8 +15,8 @@ void render_powerup(void)
     if (powerup.active == false) {
         return;
     }
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, powerup.x);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, powerup.y);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, screen_x(powerup.x));
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, screen_y(powerup.y));
 
     return;
 }
@@ -27,17 +29,17 @@ void update_powerup(void)
 
     // Update power-up position
     powerup.y += powerup.vy;
-    powerup.x -= scroll_dx;
-    powerup.y -= scroll_dy;
 
-    // Check for collision with player (simple bounding box)
-    if ((powerup.x < player_x + 16) && (powerup.x + 8 > player_x) &&
-        (powerup.y < player_y + 16) && (powerup.y + 8 > player_y)) {
+    // Check for collision with player (simple bounding box, screen space)
+    int16_t sx = screen_x(powerup.x);
+    int16_t sy = screen_y(powerup.y);
+    if ((sx < player_x + 16) && (sx + 8 > player_x) &&
+        (sy < player_y + 16) && (sy + 8 > player_y)) {
         // Player collected power-up
         powerup.active = false;
         // Move power-up sprite offscreen
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
+        sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
 
         sbullet_cooldown -= SBULLET_COOLDOWN_DECREASE;
         if (sbullet_cooldown < SBULLET_COOLDOWN_MIN) {
@@ -56,7 +58,7 @@ void update_powerup(void)
     if (powerup.timer <= 0) {
         powerup.active = false;
         // Move power-up sprite offscreen
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
+        sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
     }
 }
@@ -11,7 +11,7 @@ extern unsigned POWERUP_CONFIG;        //Power-up sprite config address
 // Power-up structure definition
 typedef struct {
 	bool active;
-	int x, y;
+	int x, y;       // World position (see camera.h)
 	int vy;
     int timer;
 } powerup_t;
@@ -0,0 +1,283 @@
+/*
+ * profiler.c - On-target frame budget profiler (ENABLE_PROFILER builds)
+ *
+ * Times each stage of the gameplay loop with VIA timer 1 running free at
+ * PHI2, keeps min/avg/max per stage, counts frames that overran vsync,
+ * and shows the live numbers as bars on the HUD text plane.
+ *
+ * Timer 1 is only 16 bits (8.2 ms at 8 MHz), so it is folded into a
+ * 32-bit cycle clock at every marker; a single stretch between two
+ * markers longer than 65536 cycles would alias.
+ */
+
+#ifdef PROFILER
+
+#include <rp6502.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "profiler.h"
+#include "constants.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define PROFILER_PHI2_KHZ       8000UL
+#define PROFILER_FRAME_CYCLES   (PROFILER_PHI2_KHZ * 1000UL / 60UL)
+#define PROFILER_REFRESH_FRAMES 30      // Overlay redraw interval
+#define PROFILER_BAR_CHARS      8       // Each block is 1/8 of the frame
+
+#define PROF_FRAME              PROF_STAGE_COUNT    // Whole-frame stat slot
+
+#define TEXT_FG                 0xE0
+#define TEXT_BG                 0x00
+#define BAR_BG                  0x10
+#define BAR_EMPTY               0x08    // Grey
+#define BAR_OK                  0x0A    // Green:  max < 25% of frame
+#define BAR_WARN                0x0B    // Yellow: max < 50% of frame
+#define BAR_HOT                 0x09    // Red
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+    uint16_t count;
+} prof_stat_t;
+
+// ============================================================================
+// EXTERNAL DEPENDENCIES
+// ============================================================================
+
+extern unsigned text_message_addr;
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static const char stage_labels[PROF_STAGE_COUNT][5] = {
+    "INPT", "FGHT", "BLTS", "EBLT", "ASTR", "EXPL", "RNDR", "HUD "
+};
+
+static prof_stat_t stats[PROF_STAGE_COUNT + 1];
+static uint32_t stage_start[PROF_STAGE_COUNT];
+static uint32_t frame_start;
+static uint32_t clock32;
+static uint16_t last_tick;
+static uint8_t frame_vsync;
+static uint16_t frames_profiled;
+static uint16_t dropped_frames;
+static uint8_t refresh_counter;
+
+// ============================================================================
+// TIMING
+// ============================================================================
+
+/**
+ * Read timer 1 as an up-counter. The high byte is read on both sides of
+ * the low byte so a borrow between the two reads can't tear the value.
+ */
+static uint16_t read_timer(void)
+{
+    uint8_t hi = VIA.t1_hi;
+    uint8_t lo = VIA.t1_lo;
+    uint8_t hi2 = VIA.t1_hi;
+    if (hi != hi2) {
+        lo = VIA.t1_lo;
+        hi = hi2;
+    }
+    return (uint16_t)~((hi << 8) | lo);
+}
+
+static uint32_t prof_clock(void)
+{
+    uint16_t now = read_timer();
+    clock32 += (uint16_t)(now - last_tick);
+    last_tick = now;
+    return clock32;
+}
+
+static void record(uint8_t slot, uint32_t cycles)
+{
+    prof_stat_t *s = &stats[slot];
+    if (s->count == 0 || cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    // Halve the running totals before they overflow; keeps the average
+    if (s->count == 0xFFFF || s->sum > 0x7FFFFFFFUL - cycles) {
+        s->sum >>= 1;
+        s->count >>= 1;
+    }
+    s->sum += cycles;
+    s->count++;
+}
+
+static uint32_t stat_avg(const prof_stat_t *s)
+{
+    return s->count ? s->sum / s->count : 0;
+}
+
+static uint16_t percent_of_frame(uint32_t cycles)
+{
+    uint32_t pct = cycles * 100UL / PROFILER_FRAME_CYCLES;
+    return pct > 999 ? 999 : (uint16_t)pct;
+}
+
+// ============================================================================
+// OVERLAY
+// ============================================================================
+
+static void put_char(char c, uint8_t fg, uint8_t bg)
+{
+    RIA.rw0 = c;
+    RIA.rw0 = fg;
+    RIA.rw0 = bg;
+}
+
+static void put_number(uint16_t value, uint8_t digits)
+{
+    char buf[5];
+    for (int8_t i = digits - 1; i >= 0; i--) {
+        buf[i] = '0' + value % 10;
+        value /= 10;
+    }
+    for (uint8_t i = 0; i < digits; i++) {
+        put_char(buf[i], TEXT_FG, TEXT_BG);
+    }
+}
+
+/**
+ * One 18-char cell: "LABL ######## MAX" - bar is the average share of
+ * the frame, the number is the worst frame in percent.
+ */
+static void draw_stage_cell(uint8_t stage)
+{
+    const prof_stat_t *s = &stats[stage];
+    uint16_t max_pct = percent_of_frame(s->max);
+    uint16_t filled = percent_of_frame(stat_avg(s)) * PROFILER_BAR_CHARS / 100;
+    uint8_t colour = max_pct < 25 ? BAR_OK : (max_pct < 50 ? BAR_WARN : BAR_HOT);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        put_char(stage_labels[stage][i], TEXT_FG, TEXT_BG);
+    }
+    put_char(' ', TEXT_FG, TEXT_BG);
+    for (uint8_t i = 0; i < PROFILER_BAR_CHARS; i++) {
+        put_char(0xDB, i < filled ? colour : BAR_EMPTY, BAR_BG);
+    }
+    put_char(' ', TEXT_FG, TEXT_BG);
+    put_number(max_pct, 3);
+    put_char(' ', TEXT_FG, TEXT_BG);
+}
+
+static void draw_overlay(void)
+{
+    RIA.step0 = 1;
+
+    // Row 1 around "LEVEL XX": average frame load and dropped frames
+    RIA.addr0 = text_message_addr + MESSAGE_WIDTH * 3;
+    put_char('F', TEXT_FG, TEXT_BG);
+    put_char('R', TEXT_FG, TEXT_BG);
+    put_char('M', TEXT_FG, TEXT_BG);
+    put_char(' ', TEXT_FG, TEXT_BG);
+    put_number(percent_of_frame(stat_avg(&stats[PROF_FRAME])), 3);
+    put_char('%', TEXT_FG, TEXT_BG);
+
+    RIA.addr0 = text_message_addr + (MESSAGE_WIDTH * 2 - 10) * 3;
+    put_char('D', TEXT_FG, TEXT_BG);
+    put_char('R', TEXT_FG, TEXT_BG);
+    put_char('O', TEXT_FG, TEXT_BG);
+    put_char('P', TEXT_FG, TEXT_BG);
+    put_char(' ', TEXT_FG, TEXT_BG);
+    put_number(dropped_frames, 5);
+
+    // Rows 2+: two stages per row
+    RIA.addr0 = text_message_addr + MESSAGE_WIDTH * 2 * 3;
+    for (uint8_t stage = 0; stage < PROF_STAGE_COUNT; stage++) {
+        draw_stage_cell(stage);
+    }
+}
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void profiler_init(void)
+{
+    // Timer 1 continuous, PB7 output off, reload 0xFFFF
+    VIA.acr = (VIA.acr & 0x3F) | 0x40;
+    VIA.t1l_lo = 0xFF;
+    VIA.t1l_hi = 0xFF;
+    VIA.t1_lo = 0xFF;
+    VIA.t1_hi = 0xFF;
+
+    for (uint8_t i = 0; i <= PROF_STAGE_COUNT; i++) {
+        stats[i].min = 0;
+        stats[i].max = 0;
+        stats[i].sum = 0;
+        stats[i].count = 0;
+    }
+    frames_profiled = 0;
+    dropped_frames = 0;
+    refresh_counter = 0;
+    clock32 = 0;
+    last_tick = read_timer();
+}
+
+void profiler_frame_begin(void)
+{
+    frame_vsync = RIA.vsync;
+    frame_start = prof_clock();
+}
+
+void profiler_frame_end(void)
+{
+    record(PROF_FRAME, prof_clock() - frame_start);
+    if (RIA.vsync != frame_vsync) {
+        dropped_frames++;
+    }
+    frames_profiled++;
+
+    if (++refresh_counter >= PROFILER_REFRESH_FRAMES) {
+        refresh_counter = 0;
+        draw_overlay();
+    }
+}
+
+void profiler_begin(ProfStage stage)
+{
+    stage_start[stage] = prof_clock();
+}
+
+void profiler_end(ProfStage stage)
+{
+    record(stage, prof_clock() - stage_start[stage]);
+}
+
+void profiler_dump(void)
+{
+    FILE *fp = fopen(PROFILER_FILE, "w");
+    if (!fp) {
+        printf("Could not write %s\n", PROFILER_FILE);
+        return;
+    }
+
+    fprintf(fp, "RPMegaFighter frame profile (PHI2 %lu kHz, %lu cycles/frame)\n",
+            PROFILER_PHI2_KHZ, PROFILER_FRAME_CYCLES);
+    fprintf(fp, "frames %u, dropped %u\n\n", frames_profiled, dropped_frames);
+    fprintf(fp, "stage      min      avg      max  avg%%  max%%\n");
+    for (uint8_t i = 0; i <= PROF_STAGE_COUNT; i++) {
+        const prof_stat_t *s = &stats[i];
+        uint32_t avg = stat_avg(s);
+        fprintf(fp, "%-5s %8lu %8lu %8lu  %4u  %4u\n",
+                i == PROF_FRAME ? "FRAME" : stage_labels[i],
+                (unsigned long)s->min, (unsigned long)avg, (unsigned long)s->max,
+                percent_of_frame(avg), percent_of_frame(s->max));
+    }
+    fclose(fp);
+    printf("Profile written to %s\n", PROFILER_FILE);
+}
+
+#endif // PROFILER
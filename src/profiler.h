@@ -0,0 +1,60 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+// Gameplay loop stages timed by the profiler (ENABLE_PROFILER builds)
+typedef enum {
+    PROF_INPUT = 0,     // handle_input
+    PROF_FIGHTERS,      // update_fighters
+    PROF_BULLETS,       // update_bullets + update_sbullets
+    PROF_EBULLETS,      // update_ebullets
+    PROF_ASTEROIDS,     // update_asteroids
+    PROF_EXPLOSIONS,    // update_explosions
+    PROF_RENDER,        // render_game
+    PROF_HUD,           // draw_hud
+    PROF_STAGE_COUNT
+} ProfStage;
+
+#ifdef PROFILER
+
+#define PROFILER_FILE "PROFILE.TXT"
+
+/**
+ * Start VIA timer 1 free-running at PHI2 and clear all statistics
+ */
+void profiler_init(void);
+
+/**
+ * Mark the start of a gameplay frame (call right after the vsync wait)
+ */
+void profiler_frame_begin(void);
+
+/**
+ * Mark the end of a gameplay frame; counts a dropped frame if RIA.vsync
+ * moved on while the frame was running, and refreshes the overlay
+ */
+void profiler_frame_end(void);
+
+/**
+ * Begin/end timing one stage of the current frame
+ */
+void profiler_begin(ProfStage stage);
+void profiler_end(ProfStage stage);
+
+/**
+ * Write min/avg/max per stage and the dropped frame count to PROFILER_FILE
+ */
+void profiler_dump(void);
+
+#define PROFILE_BEGIN(stage) profiler_begin(stage)
+#define PROFILE_END(stage)   profiler_end(stage)
+
+#else
+
+#define PROFILE_BEGIN(stage)
+#define PROFILE_END(stage)
+
+#endif // PROFILER
+
+#endif // PROFILER_H
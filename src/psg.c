@@ -0,0 +1,217 @@
+/*
+ * psg.c - PSG register shadow and voice allocator
+ *
+ * Each channel keeps a dirty mask of its 8 register bytes; the flush
+ * streams from the first dirty byte to the last with one address load.
+ * A retrigger is spread over two flushes (gate off, then on), since one
+ * flush would only ever send the final value. The flush runs in the
+ * audio tick (audio.c), so it writes through portal 1.
+ */
+
+#include <rp6502.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "constants.h"
+#include "psg.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define PSG_REGS        8                       // Bytes per channel
+#define GATE_ON         0x01                    // Pan center, gate on
+#define OWNER_FREE      0xFF
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct {
+    uint8_t prio;       // PsgPriority, or OWNER_FREE
+    uint8_t frames;     // Frames left (0: held)
+    uint8_t tag;        // Bumped on every alloc
+    uint16_t started;   // Frame count when taken or freed (age)
+} psg_voice_t;
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static uint8_t shadow[PSG_CHANNELS * PSG_REGS];
+static uint8_t dirty[PSG_CHANNELS];             // Bit r: register r changed
+static uint8_t gate_live = 0;                   // Bit ch: gate on in XRAM
+static uint8_t retrigger = 0;                   // Bit ch: release before next gate on
+static psg_voice_t voices[PSG_CHANNELS];
+static uint16_t frame = 0;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void psg_init(void)
+{
+    xregn(0, 1, 0x00, 1, PSG_XRAM_ADDR);
+
+    memset(shadow, 0, sizeof(shadow));
+    memset(dirty, 0, sizeof(dirty));
+    gate_live = 0;
+    retrigger = 0;
+    for (uint8_t ch = 0; ch < PSG_CHANNELS; ch++) {
+        voices[ch].prio = OWNER_FREE;
+        voices[ch].frames = 0;
+    }
+
+    RIA.addr0 = PSG_XRAM_ADDR;
+    RIA.step0 = 1;
+    for (uint8_t i = 0; i < sizeof(shadow); i++) {
+        RIA.rw0 = 0;
+    }
+}
+
+void psg_write(uint8_t ch, uint8_t reg, uint8_t val)
+{
+    uint8_t *b = &shadow[ch * PSG_REGS + reg];
+    if (*b != val) {
+        *b = val;
+        dirty[ch] |= 1 << reg;
+    }
+}
+
+void psg_set_freq(uint8_t ch, uint16_t word)
+{
+    psg_write(ch, PSG_REG_FREQ, word & 0xFF);
+    psg_write(ch, PSG_REG_FREQ + 1, word >> 8);
+}
+
+void psg_gate(uint8_t ch, bool on)
+{
+    if (on && (gate_live & (1 << ch))) {
+        retrigger |= 1 << ch;
+    }
+    psg_write(ch, PSG_REG_PAN_GATE, on ? GATE_ON : 0x00);
+    if (on) {
+        dirty[ch] |= 1 << PSG_REG_PAN_GATE;
+    }
+}
+
+/**
+ * Free channel idle the longest (its release has run the furthest)
+ */
+static uint8_t oldest_free(void)
+{
+    uint8_t best = PSG_VOICE_NONE;
+    uint16_t best_age = 0;
+    for (uint8_t ch = 0; ch < PSG_CHANNELS; ch++) {
+        uint16_t age = frame - voices[ch].started;
+        if (voices[ch].prio == OWNER_FREE && (best == PSG_VOICE_NONE || age > best_age)) {
+            best = ch;
+            best_age = age;
+        }
+    }
+    return best;
+}
+
+/**
+ * Lowest priority, then oldest, voice that `prio` may cut short
+ */
+static uint8_t weakest_voice(PsgPriority prio)
+{
+    uint8_t best = PSG_VOICE_NONE;
+    uint8_t best_prio = 0;
+    uint16_t best_age = 0;
+    for (uint8_t ch = 0; ch < PSG_CHANNELS; ch++) {
+        const psg_voice_t *v = &voices[ch];
+        if (v->prio > prio || (v->prio == prio && v->frames == 0)) {
+            continue;
+        }
+        uint16_t age = frame - v->started;
+        if (best == PSG_VOICE_NONE || v->prio < best_prio ||
+            (v->prio == best_prio && age > best_age)) {
+            best = ch;
+            best_prio = v->prio;
+            best_age = age;
+        }
+    }
+    return best;
+}
+
+uint8_t psg_voice_alloc(PsgPriority prio, uint8_t frames)
+{
+    uint8_t ch = oldest_free();
+    if (ch == PSG_VOICE_NONE) {
+        ch = weakest_voice(prio);
+        if (ch == PSG_VOICE_NONE) {
+            return PSG_VOICE_NONE;
+        }
+    }
+
+    psg_voice_t *v = &voices[ch];
+    v->prio = prio;
+    v->frames = frames;
+    v->tag++;
+    v->started = frame;
+    return ch;
+}
+
+uint8_t psg_voice_tag(uint8_t ch)
+{
+    return voices[ch].tag;
+}
+
+void psg_voice_release(uint8_t ch)
+{
+    if (voices[ch].prio == OWNER_FREE) {
+        return;
+    }
+    psg_gate(ch, false);
+    voices[ch].prio = OWNER_FREE;
+    voices[ch].frames = 0;
+    voices[ch].tag++;
+    voices[ch].started = frame;
+}
+
+void psg_flush(void)
+{
+    frame++;
+    for (uint8_t ch = 0; ch < PSG_CHANNELS; ch++) {
+        psg_voice_t *v = &voices[ch];
+        if (v->frames && --v->frames == 0) {
+            psg_voice_release(ch);
+        }
+
+        uint8_t mask = dirty[ch];
+        if (!mask) {
+            continue;
+        }
+
+        uint8_t first = 0, last = PSG_REGS - 1;
+        while (!(mask & (1 << first))) first++;
+        while (!(mask & (1 << last))) last--;
+
+        const uint8_t *regs = &shadow[ch * PSG_REGS];
+        uint8_t bit = 1 << ch;
+        RIA.addr1 = PSG_XRAM_ADDR + ch * PSG_REGS + first;
+        RIA.step1 = 1;
+        for (uint8_t r = first; r <= last; r++) {
+            uint8_t val = regs[r];
+            if (r == PSG_REG_PAN_GATE && (retrigger & bit)) {
+                val &= ~GATE_ON;        // Off now, on next flush
+            }
+            RIA.rw1 = val;
+        }
+        dirty[ch] = 0;
+
+        if (mask & (1 << PSG_REG_PAN_GATE)) {
+            if (retrigger & bit) {
+                retrigger &= ~bit;
+                gate_live &= ~bit;
+                dirty[ch] = 1 << PSG_REG_PAN_GATE;
+            } else if (regs[PSG_REG_PAN_GATE] & GATE_ON) {
+                gate_live |= bit;
+            } else {
+                gate_live &= ~bit;
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef PSG_H
+#define PSG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * psg.h - PSG register shadow and voice allocator
+ *
+ * Sound effects and music used to write whole 8-byte channel blocks
+ * straight to XRAM, and each owned a fixed set of channels. Writes now go
+ * to a RAM copy of the 64 register bytes; psg_flush() sends only the
+ * changed bytes, once per frame.
+ *
+ * Channels are handed out as voices from all eight by priority. A free
+ * channel is taken first; otherwise the lowest priority voice is taken,
+ * the oldest first. A timed voice (a sound effect) can be cut short by an
+ * equal or higher priority; a held voice (a music part) only by a higher
+ * one, so music yields to sound effects when the channels run out.
+ *
+ * After audio_init() everything here belongs to the vsync audio tick
+ * (audio.h); the game goes through play_sound() and the music calls.
+ */
+
+#define PSG_CHANNELS    8
+#define PSG_VOICE_NONE  0xFF
+
+// Registers of a channel
+#define PSG_REG_FREQ            0   // 16-bit, Hz * 3
+#define PSG_REG_DUTY            2
+#define PSG_REG_VOL_ATTACK      3
+#define PSG_REG_VOL_DECAY       4
+#define PSG_REG_WAVE_RELEASE    5
+#define PSG_REG_PAN_GATE        6
+
+typedef enum {
+    PSG_PRIO_MUSIC = 0,
+    PSG_PRIO_SFX_LOW,
+    PSG_PRIO_SFX,
+    PSG_PRIO_SFX_HIGH
+} PsgPriority;
+
+/**
+ * Point the PSG at PSG_XRAM_ADDR and silence every channel
+ */
+void psg_init(void);
+
+/**
+ * Set one register byte / the frequency word of a channel
+ */
+void psg_write(uint8_t ch, uint8_t reg, uint8_t val);
+void psg_set_freq(uint8_t ch, uint16_t word);
+
+/**
+ * Gate a channel on (pan center) or off. Gating on a channel whose gate is
+ * already on releases it for one frame first, so the envelope restarts.
+ */
+void psg_gate(uint8_t ch, bool on);
+
+/**
+ * Take a channel for a sound; frames is how long it plays before it is
+ * released and freed (0: held until psg_voice_release). Returns the
+ * channel, or PSG_VOICE_NONE if every voice outranks the request.
+ */
+uint8_t psg_voice_alloc(PsgPriority prio, uint8_t frames);
+
+/**
+ * Tag of the current owner of a channel; changes each time it is taken
+ */
+uint8_t psg_voice_tag(uint8_t ch);
+
+/**
+ * Gate a channel off and free it
+ */
+void psg_voice_release(uint8_t ch);
+
+/**
+ * Write changed registers to XRAM through portal 1 and time out finished
+ * voices; the audio tick calls this once per frame
+ */
+void psg_flush(void);
+
+#endif // PSG_H
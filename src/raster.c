@@ -0,0 +1,384 @@
+/*
+ * raster.c - Drawing primitives for the 320x180 8bpp bitmap
+ *
+ * Horizontal runs set RIA.step0 = 1 and stream through RIA.rw0 after a
+ * single address load. The step register is only 8 bits wide, so vertical
+ * runs and line steps move RIA.addr0 by a row with one add instead of
+ * recomputing x + SCREEN_WIDTH * y.
+ *
+ * In the LOWRES_BITMAP gameplay mode a byte holds two pixels (the left
+ * one in the high nibble). Runs stream whole bytes and only their odd
+ * ends, like single pixels, are read-modify-write. Each call repeats for
+ * every page in the current target.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <rp6502.h>
+#include "constants.h"
+#include "raster.h"
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+uint16_t raster_row[SCREEN_HEIGHT];
+int16_t raster_top = 0;
+uint8_t raster_back_page = 0;
+
+#define PLAYFIELD_ADDR      (PLAYFIELD_TOP * SCREEN_WIDTH)
+
+#ifdef LOWRES_BITMAP
+#define BITMAP_ATTR_4BPP    2       // Mode 3 colour depth attributes
+#define BITMAP_ATTR_8BPP    3
+
+static bool paged = false;                      // 4bpp gameplay mode is on
+static RasterTarget target = RASTER_BOTH;
+static uint8_t page_mask = 0x01;                // Bit p set: draw to page p
+#endif
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void raster_init(void)
+{
+    uint16_t addr = 0;
+    for (uint8_t y = 0; y < SCREEN_HEIGHT; y++) {
+        raster_row[y] = addr;
+        addr += SCREEN_WIDTH;
+    }
+}
+
+void raster_set_target(RasterTarget t)
+{
+#ifdef LOWRES_BITMAP
+    target = t;
+    if (!paged) {
+        page_mask = 0x01;
+    } else {
+        page_mask = t == RASTER_BACK ? 1 << raster_back_page : (1 << RASTER_PAGES) - 1;
+    }
+#else
+    (void)t;
+#endif
+}
+
+void raster_set_playfield(bool on)
+{
+    raster_top = on ? PLAYFIELD_TOP : 0;
+
+    // Blank everything, including the rows lent out during gameplay
+    RIA.addr0 = 0;
+    RIA.step0 = 1;
+    for (unsigned i = SCREEN_WIDTH * SCREEN_HEIGHT; i--;) {
+        RIA.rw0 = 0;
+    }
+
+    // Row raster_top is the first byte shown; at 4bpp it is also page 0
+    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, y_pos_px, raster_top);
+    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, height_px, SCREEN_HEIGHT - raster_top);
+    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, xram_data_ptr, raster_row[raster_top]);
+#ifdef LOWRES_BITMAP
+    paged = on;
+    raster_back_page = on ? 1 : 0;
+    raster_set_target(target);
+    xregn(1, 0, 1, 4, 3, on ? BITMAP_ATTR_4BPP : BITMAP_ATTR_8BPP, BITMAP_CONFIG, 1);
+#endif
+}
+
+void raster_flip(void)
+{
+#ifdef LOWRES_BITMAP
+    if (!paged) {
+        return;
+    }
+    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, xram_data_ptr,
+                     PLAYFIELD_ADDR + raster_back_page * RASTER_PAGE_BYTES);
+    raster_back_page ^= 1;
+    raster_set_target(target);
+#endif
+}
+
+#ifdef LOWRES_BITMAP
+/**
+ * Map an 8bpp colour to 4bpp: 0-15 are kept (the palette bands live
+ * there), anything higher folds into 1-15 so it never turns transparent
+ */
+static uint8_t fold_colour(uint8_t colour)
+{
+    return colour < 16 ? colour : 1 + colour % 15;
+}
+
+/**
+ * Set one nibble; `x` picks the half of the byte at `addr`
+ */
+static void put_nibble(uint16_t addr, int16_t x, uint8_t colour)
+{
+    RIA.addr0 = addr;
+    uint8_t pair = RIA.rw0;
+    RIA.addr0 = addr;
+    RIA.rw0 = (x & 1) ? (pair & 0xF0) | colour : (pair & 0x0F) | (colour << 4);
+}
+
+/**
+ * XRAM address of (0, 0) on a 4bpp page; the page itself starts at row
+ * PLAYFIELD_TOP, so the sum with a row offset wraps around to it
+ */
+static uint16_t page_origin(uint8_t page)
+{
+    return PLAYFIELD_ADDR + page * RASTER_PAGE_BYTES - PLAYFIELD_TOP * (SCREEN_WIDTH / 2);
+}
+
+/**
+ * Plot an on-screen pixel at 4bpp in every target page
+ */
+static void paged_pixel(int16_t x, int16_t y, uint8_t colour)
+{
+    uint16_t offset = (raster_row[y] >> 1) + (x >> 1);
+    for (uint8_t p = 0; p < RASTER_PAGES; p++) {
+        if (page_mask & (1 << p)) {
+            put_nibble(page_origin(p) + offset, x, colour);
+        }
+    }
+}
+
+/**
+ * Fill an on-screen run at 4bpp in every target page
+ */
+static void paged_hspan(int16_t x, int16_t y, int16_t width, uint8_t colour)
+{
+    uint8_t pair = colour | (colour << 4);
+    uint16_t offset = (raster_row[y] >> 1) + (x >> 1);
+
+    for (uint8_t p = 0; p < RASTER_PAGES; p++) {
+        if (!(page_mask & (1 << p))) {
+            continue;
+        }
+        uint16_t addr = page_origin(p) + offset;
+        int16_t left = x;
+        int16_t n = width;
+        if (left & 1) {
+            put_nibble(addr++, left++, colour);
+            n--;
+        }
+        RIA.addr0 = addr;
+        RIA.step0 = 1;
+        for (int16_t pairs = n >> 1; pairs > 0; pairs--) {
+            RIA.rw0 = pair;
+        }
+        if (n & 1) {
+            put_nibble(addr + (n >> 1), 0, colour);
+        }
+    }
+}
+
+void raster_pixel(int16_t x, int16_t y, uint8_t colour)
+{
+    if ((uint16_t)x >= SCREEN_WIDTH || y < raster_top || y >= SCREEN_HEIGHT) {
+        return;
+    }
+    if (paged) {
+        paged_pixel(x, y, fold_colour(colour));
+        return;
+    }
+    RIA.addr0 = raster_row[y] + x;
+    RIA.rw0 = colour;
+}
+#endif // LOWRES_BITMAP
+
+/**
+ * Clip the run [*start, *start + *len) to [first, limit); false if nothing is left
+ */
+static bool clip_run(int16_t *start, int16_t *len, int16_t first, int16_t limit)
+{
+    if (*start < first) {
+        *len -= first - *start;
+        *start = first;
+    }
+    if (*start + *len > limit) {
+        *len = limit - *start;
+    }
+    return *len > 0;
+}
+
+void raster_hspan(int16_t x, int16_t y, int16_t width, uint8_t colour)
+{
+    if (y < raster_top || y >= SCREEN_HEIGHT || !clip_run(&x, &width, 0, SCREEN_WIDTH)) {
+        return;
+    }
+#ifdef LOWRES_BITMAP
+    if (paged) {
+        paged_hspan(x, y, width, fold_colour(colour));
+        return;
+    }
+#endif
+    RIA.addr0 = raster_row[y] + x;
+    RIA.step0 = 1;
+    while (width--) {
+        RIA.rw0 = colour;
+    }
+}
+
+void raster_hcopy(int16_t x, int16_t y, const uint8_t *src, int16_t width)
+{
+    int16_t x0 = x;
+    if (y < raster_top || y >= SCREEN_HEIGHT || !clip_run(&x, &width, 0, SCREEN_WIDTH)) {
+        return;
+    }
+    src += x - x0;
+#ifdef LOWRES_BITMAP
+    if (paged) {
+        while (width--) {
+            paged_pixel(x++, y, fold_colour(*src++));
+        }
+        return;
+    }
+#endif
+    RIA.addr0 = raster_row[y] + x;
+    RIA.step0 = 1;
+    while (width--) {
+        RIA.rw0 = *src++;
+    }
+}
+
+void raster_vspan(int16_t x, int16_t y, int16_t height, uint8_t colour)
+{
+    if ((uint16_t)x >= SCREEN_WIDTH || !clip_run(&y, &height, raster_top, SCREEN_HEIGHT)) {
+        return;
+    }
+#ifdef LOWRES_BITMAP
+    if (paged) {
+        colour = fold_colour(colour);
+        while (height--) {
+            paged_pixel(x, y++, colour);
+        }
+        return;
+    }
+#endif
+    uint16_t addr = raster_row[y] + x;
+    while (height--) {
+        RIA.addr0 = addr;
+        RIA.rw0 = colour;
+        addr += SCREEN_WIDTH;
+    }
+}
+
+void raster_fill_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint8_t colour)
+{
+    if (!clip_run(&x, &width, 0, SCREEN_WIDTH) ||
+        !clip_run(&y, &height, raster_top, SCREEN_HEIGHT)) {
+        return;
+    }
+#ifdef LOWRES_BITMAP
+    if (paged) {
+        colour = fold_colour(colour);
+        for (int16_t row = y; row < y + height; row++) {
+            paged_hspan(x, row, width, colour);
+        }
+        return;
+    }
+#endif
+    RIA.step0 = 1;
+    for (int16_t row = y; row < y + height; row++) {
+        RIA.addr0 = raster_row[row] + x;
+        for (int16_t n = width; n > 0; n--) {
+            RIA.rw0 = colour;
+        }
+    }
+}
+
+void raster_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t colour)
+{
+    // Nothing to draw if both ends are off the same edge
+    if ((x0 < 0 && x1 < 0) || (x0 >= SCREEN_WIDTH && x1 >= SCREEN_WIDTH) ||
+        (y0 < raster_top && y1 < raster_top) || (y0 >= SCREEN_HEIGHT && y1 >= SCREEN_HEIGHT)) {
+        return;
+    }
+
+    int16_t dx = abs(x1 - x0);
+    int16_t dy = -abs(y1 - y0);
+    int16_t sx = x0 < x1 ? 1 : -1;
+    int16_t sy = y0 < y1 ? 1 : -1;
+    int16_t row_step = y0 < y1 ? SCREEN_WIDTH : -SCREEN_WIDTH;
+    int16_t err = dx + dy;
+
+    // Address of (x0, y0) even when it is off screen; it is only used once
+    // the walk is inside the bitmap, where it is exact
+    uint16_t addr = (uint16_t)x0 + (uint16_t)y0 * SCREEN_WIDTH;
+
+#ifdef LOWRES_BITMAP
+    if (paged) {
+        colour = fold_colour(colour);
+    }
+#endif
+
+    while (true) {
+        if ((uint16_t)x0 < SCREEN_WIDTH && y0 >= raster_top && y0 < SCREEN_HEIGHT) {
+#ifdef LOWRES_BITMAP
+            if (paged) {
+                paged_pixel(x0, y0, colour);
+            } else
+#endif
+            {
+                RIA.addr0 = addr;
+                RIA.rw0 = colour;
+            }
+        }
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int16_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+            addr += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+            addr += row_step;
+        }
+    }
+}
+
+void raster_glyph(int16_t x, int16_t y, const uint8_t *rows, uint8_t width, uint8_t height,
+                  uint8_t colour)
+{
+    // Partly off screen (or 4bpp): plot what is visible pixel by pixel
+    bool slow = x < 0 || x + width > SCREEN_WIDTH || y < raster_top || y + height > SCREEN_HEIGHT;
+#ifdef LOWRES_BITMAP
+    slow = slow || paged;
+#endif
+    if (slow) {
+        for (uint8_t row = 0; row < height; row++) {
+            uint8_t bits = rows[row];
+            for (uint8_t col = 0; col < width; col++) {
+                if (bits & (1 << (width - 1 - col))) {
+                    raster_pixel(x + col, y + row, colour);
+                }
+            }
+        }
+        return;
+    }
+
+    // One address load per row; a dummy read steps over clear pixels
+    uint8_t used = (1 << width) - 1;
+    RIA.step0 = 1;
+    for (uint8_t row = 0; row < height; row++) {
+        uint8_t bits = rows[row] & used;
+        if (!bits) {
+            continue;
+        }
+        RIA.addr0 = raster_row[y + row] + x;
+        for (uint8_t mask = 1 << (width - 1); bits; mask >>= 1) {
+            if (bits & mask) {
+                RIA.rw0 = colour;
+                bits &= ~mask;
+            } else {
+                (void)RIA.rw0;
+            }
+        }
+    }
+}
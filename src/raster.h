@@ -0,0 +1,118 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <rp6502.h>
+#include "constants.h"
+
+/**
+ * raster.h - Drawing primitives for the 320x180 8bpp bitmap
+ *
+ * Plotting used to work out x + SCREEN_WIDTH * y (a 16-bit multiply on
+ * the 6502) and reload RIA.addr0 for every pixel. Row addresses now come
+ * from a table, and runs of pixels are streamed through RIA.rw0 with one
+ * address load per run. Everything clips to the screen.
+ *
+ * During gameplay only rows PLAYFIELD_TOP and below are shown and drawn;
+ * the XRAM of the rows above holds the message overlay. With
+ * LOWRES_BITMAP the gameplay bitmap is also 4bpp with two pages: one is
+ * shown while the other (the back page) is drawn, and raster_flip()
+ * swaps them at vsync. Outside gameplay the bitmap is the full 8bpp one.
+ */
+
+#ifdef LOWRES_BITMAP
+#define RASTER_PAGES        2
+#define RASTER_PAGE_BYTES   (SCREEN_WIDTH / 2 * (SCREEN_HEIGHT - PLAYFIELD_TOP))  // 27040
+#else
+#define RASTER_PAGES        1
+#endif
+
+// Pages a draw call writes to
+typedef enum {
+    RASTER_BOTH = 0,    // Persistent drawing (text, effects): every page
+    RASTER_BACK         // Per-frame drawing: only the page shown next
+} RasterTarget;
+
+// Page RASTER_BACK draws to (always 0 with a single page)
+extern uint8_t raster_back_page;
+
+// XRAM address of the first pixel of each row (filled by raster_init)
+extern uint16_t raster_row[SCREEN_HEIGHT];
+
+// First row drawing reaches (PLAYFIELD_TOP during gameplay, else 0)
+extern int16_t raster_top;
+
+/**
+ * Build the row address table; call once before drawing
+ */
+void raster_init(void);
+
+/**
+ * Switch the bitmap between the full 8bpp screen (title, splash) and the
+ * gameplay playfield below PLAYFIELD_TOP (4bpp double-buffered with
+ * LOWRES_BITMAP). The whole bitmap area is cleared either way.
+ */
+void raster_set_playfield(bool on);
+
+/**
+ * Choose which pages the drawing calls write to (RASTER_BOTH by default)
+ */
+void raster_set_target(RasterTarget target);
+
+/**
+ * Show the back page and start drawing the other one; call in vblank
+ */
+void raster_flip(void);
+
+#ifdef LOWRES_BITMAP
+/**
+ * Plot a single pixel (clipped). At 4bpp colours above 15 fold into 1-15.
+ */
+void raster_pixel(int16_t x, int16_t y, uint8_t colour);
+#else
+/**
+ * Plot a single pixel (clipped)
+ */
+static inline void raster_pixel(int16_t x, int16_t y, uint8_t colour)
+{
+    if ((uint16_t)x < SCREEN_WIDTH && y >= raster_top && y < SCREEN_HEIGHT) {
+        RIA.addr0 = raster_row[y] + x;
+        RIA.rw0 = colour;
+    }
+}
+#endif
+
+/**
+ * Fill `width` pixels rightward from (x, y)
+ */
+void raster_hspan(int16_t x, int16_t y, int16_t width, uint8_t colour);
+
+/**
+ * Copy `width` pixels from `src` to the row starting at (x, y)
+ */
+void raster_hcopy(int16_t x, int16_t y, const uint8_t *src, int16_t width);
+
+/**
+ * Fill `height` pixels downward from (x, y)
+ */
+void raster_vspan(int16_t x, int16_t y, int16_t height, uint8_t colour);
+
+/**
+ * Fill a rectangle, one address load per row
+ */
+void raster_fill_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint8_t colour);
+
+/**
+ * Draw a line from (x0, y0) to (x1, y1) with Bresenham's algorithm
+ */
+void raster_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t colour);
+
+/**
+ * Draw a 1bpp glyph of up to 8 pixels wide: one byte per row, the
+ * leftmost pixel in bit (width - 1). Clear bits are left untouched.
+ */
+void raster_glyph(int16_t x, int16_t y, const uint8_t *rows, uint8_t width, uint8_t height,
+                  uint8_t colour);
+
+#endif // RASTER_H
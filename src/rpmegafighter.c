@@ -23,6 +23,7 @@
 #include "bullets.h"
 #include "sbullets.h"
 #include "sound.h"
+#include "audio.h"
 #include "music.h"
 #include "bkgstars.h"
 #include "pause.h"
@@ -35,6 +36,14 @@
 #include "splash_screen.h"
 #include "asteroids.h"
 #include "explosions.h"
+#include "profiler.h"
+#include "sprite_shadow.h"
+#include "sprite_mux.h"
+#include "scheduler.h"
+#include "camera.h"
+#include "palette.h"
+#include "overlay.h"
+#include "anim.h"
 
 // ============================================================================
 // XRAM MEMORY CONFIGURATION ADDRESSES
@@ -42,6 +51,7 @@
 
 unsigned BITMAP_CONFIG;         // Bitmap Config 
 unsigned SPACECRAFT_CONFIG;     // Spacecraft Sprite Config - Affine 
+unsigned SPRITE_LIST_CONFIG;    // Shared slots of the regular sprite list (see sprite_mux.h)
 unsigned EARTH_CONFIG;          // Earth Sprite Config - Standard 
 unsigned ASTEROID_L_CONFIG;     //Asteroid L Sprite Config - Affine
 unsigned STATION_CONFIG;        // Enemy station sprite config
@@ -87,7 +97,11 @@ extern int16_t player_vx_applied, player_vy_applied;
 int16_t scroll_dx = 0;
 int16_t scroll_dy = 0;
 
-// Earth background sprite
+// World position of the screen's top-left pixel (see camera.h)
+int16_t camera_x = 0;
+int16_t camera_y = 0;
+
+// Earth background sprite (world coordinates)
 int16_t earth_x = 0;
 int16_t earth_y = 0;
 
@@ -134,10 +148,20 @@ static void init_graphics(void)
     
     // Enable Mode 3 bitmap (4-bit color)
     xregn(1, 0, 1, 4, 3, 3, BITMAP_CONFIG, 1);
+    raster_init();
     
     // Set up player spacecraft sprite (VGA Mode 4 - affine sprite with rotation)
     SPACECRAFT_CONFIG = BITMAP_CONFIG + sizeof(vga_mode3_config_t);
     
+#ifdef PREROTATED_SHIP
+    // Identity transform; rotation picks one of the pre-rotated frames
+    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[0], 0x0100);  // cos = 1.0
+    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[1], 0);
+    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[2], 0);
+    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[3], 0);
+    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[4], 0x0100);  // cos = 1.0
+    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[5], 0);
+#else
     // Initialize rotation transform matrix (identity at rotation 0)
     int16_t initial_rotation = get_player_rotation();
     xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[0],  cos_fix[initial_rotation]);
@@ -146,6 +170,7 @@ static void init_graphics(void)
     xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[3],  sin_fix[initial_rotation]);
     xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[4],  cos_fix[initial_rotation]);
     xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[5],  t2_fix4[SHIP_ROTATION_MAX - initial_rotation + 1]);
+#endif
     
     // Set sprite position and properties
     xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, x_pos_px, -100); //player_x);
@@ -188,107 +213,113 @@ static void init_graphics(void)
     xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, y_pos_px, earth_y);
     xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, EARTH_DATA);
     xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, log_size, 5);  // 32x32 sprite (2^5)
+    // No opacity metadata: the firmware documents no layout for it yet
     xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
 
+    // Regular sprites share the slots of one Mode 4 list after Earth; each
+    // type gets a group of sprite_mux entries (RAM only) to write instead
+    SPRITE_LIST_CONFIG = EARTH_CONFIG + sizeof(vga_mode4_sprite_t);
+    sprite_mux_init(SPRITE_LIST_CONFIG, 1);
+
     // Set up fighter sprites (VGA Mode 4 - regular sprites)
-    FIGHTER_CONFIG = EARTH_CONFIG +  sizeof(vga_mode4_sprite_t);
+    FIGHTER_CONFIG = sprite_mux_group(MAX_FIGHTERS, SPRITE_PRIO_NORMAL);
 
     for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
         unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
         
         // Initialize sprite configuration
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, FIGHTER_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 2);  // 4x4 sprite (2^2)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, FIGHTER_DATA);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 2);  // 4x4 sprite (2^2)
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
     }
     
     // Set up enemy bullet sprites (VGA Mode 4 - regular sprites)
-    EBULLET_CONFIG = FIGHTER_CONFIG + MAX_FIGHTERS * sizeof(vga_mode4_sprite_t);
+    EBULLET_CONFIG = sprite_mux_group(MAX_EBULLETS, SPRITE_PRIO_HIGH);
     
     for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
         unsigned ptr = EBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
         
         // Initialize sprite configuration  
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, EBULLET_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 1);  // 2x2 sprite (2^1)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);  // Match fighter config
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, EBULLET_DATA);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 1);  // 2x2 sprite (2^1)
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);  // Match fighter config
     }
     
     // Set up player bullet sprites (VGA Mode 4 - regular sprites)
-    BULLET_CONFIG = EBULLET_CONFIG + MAX_EBULLETS * sizeof(vga_mode4_sprite_t);
+    BULLET_CONFIG = sprite_mux_group(MAX_BULLETS, SPRITE_PRIO_HIGH);
     
     for (uint8_t i = 0; i < MAX_BULLETS; i++) {
         unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
         
         // Initialize sprite configuration  
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, BULLET_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 1);  // 2x2 sprite (2^1)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, BULLET_DATA);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 1);  // 2x2 sprite (2^1)
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
     }
     
     // Set up super bullet sprites (VGA Mode 4 - regular sprites)
-    SBULLET_CONFIG = BULLET_CONFIG + MAX_BULLETS * sizeof(vga_mode4_sprite_t);
+    SBULLET_CONFIG = sprite_mux_group(MAX_SBULLETS, SPRITE_PRIO_HIGH);
     
     for (uint8_t i = 0; i < MAX_SBULLETS; i++) {
         unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
         
         // Initialize sprite configuration  
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, SBULLET_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 2);  // 4x4 sprite (2^2)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, SBULLET_DATA);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 2);  // 4x4 sprite (2^2)
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
     }
 
     // Initialize power-up sprite (VGA Mode 4 - regular sprite)
-    POWERUP_CONFIG = SBULLET_CONFIG + MAX_SBULLETS * sizeof(vga_mode4_sprite_t);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, POWERUP_DATA);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
-
-    BOMBER_CONFIG = POWERUP_CONFIG + sizeof(vga_mode4_sprite_t);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, BOMBER_DATA);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
-
-    ASTEROID_M_CONFIG = BOMBER_CONFIG + sizeof(vga_mode4_sprite_t);
+    POWERUP_CONFIG = sprite_mux_group(1, SPRITE_PRIO_HIGH);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, POWERUP_DATA);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
+
+    BOMBER_CONFIG = sprite_mux_group(1, SPRITE_PRIO_HIGH);
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, BOMBER_DATA);
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
+
+    ASTEROID_M_CONFIG = sprite_mux_group(COUNT_ASTEROID_M, SPRITE_PRIO_NORMAL);
     for (uint8_t i = 0; i < COUNT_ASTEROID_M; i++) {
         unsigned ptr = ASTEROID_M_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_M_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 4);  // 16x16 sprite (2^4)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_M_DATA);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 4);  // 16x16 sprite (2^4)
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
     }
         
-    ASTEROID_S_CONFIG = ASTEROID_M_CONFIG + COUNT_ASTEROID_M * sizeof(vga_mode4_sprite_t);
+    ASTEROID_S_CONFIG = sprite_mux_group(COUNT_ASTEROID_S, SPRITE_PRIO_NORMAL);
     for (uint8_t i = 0; i < COUNT_ASTEROID_S; i++) {
         unsigned ptr = ASTEROID_S_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_S_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_S_DATA);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
     }
 
-    EXPLOSION_CONFIG = ASTEROID_S_CONFIG + COUNT_ASTEROID_S * sizeof(vga_mode4_sprite_t);
+    EXPLOSION_CONFIG = sprite_mux_group(MAX_EXPLOSIONS, SPRITE_PRIO_LOW);
     for (uint8_t i = 0; i < MAX_EXPLOSIONS; i++) {
         unsigned ptr = EXPLOSION_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, EXPLOSION_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 4);  // 16x16 sprite (2^4)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, EXPLOSION_DATA);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, log_size, 4);  // 16x16 sprite (2^4)
+        sprite_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
     }
 
     // Enable sprite modes:
@@ -296,9 +327,7 @@ static void init_graphics(void)
     xregn(1, 0, 1, 7, 4, 1, SPACECRAFT_CONFIG, 1 + COUNT_ASTEROID_L, 2, 10, 180);
     // First enable Earth sprite (background layer)
     xregn(1, 0, 1, 5, 4, 0, EARTH_CONFIG, 1, 0);
-    // Finally enable regular sprites (fighters + ebullets + bullets + sbullets + power ups + bomber + 2 x asteroids) - all regular sprites in one call
-    xregn(1, 0, 1, 5, 4, 0, FIGHTER_CONFIG, MAX_FIGHTERS + MAX_EBULLETS + MAX_BULLETS + 
-        MAX_SBULLETS + 2 + COUNT_ASTEROID_M + COUNT_ASTEROID_S + MAX_EXPLOSIONS, 1);
+    // The regular sprite list was enabled by sprite_mux_init()
 
 
 
@@ -310,9 +339,16 @@ static void init_graphics(void)
 
     // Enable text mode for on-screen messages
 
-    TEXT_CONFIG = EXPLOSION_CONFIG + MAX_EXPLOSIONS * sizeof(vga_mode4_sprite_t); // 0xEC32; //Config address for text mode
+    TEXT_CONFIG = SPRITE_LIST_CONFIG + SPRITE_SLOTS * sizeof(vga_mode4_sprite_t); //Config address for text mode
     // Place text message data immediately after text config entries
     text_message_addr = TEXT_CONFIG + NTEXT * sizeof(vga_mode1_config_t); // 0xEC42; // address to store text message
+#ifdef PROFILER
+    // Profiler rows don't fit before the gamepad area; use the free space above the sprites
+    text_message_addr = PROFILER_TEXT_ADDR;
+#endif
+
+    // Sprite configs are complete; from here on they are written through the shadow
+    sprite_shadow_init(SPACECRAFT_CONFIG, SPRITE_LIST_CONFIG - SPACECRAFT_CONFIG);
 
     // Debug: print config addresses and sizes to help diagnose overlaps
     printf("Config addresses:\n");
@@ -320,6 +356,7 @@ static void init_graphics(void)
     printf("  SPACECRAFT_CONFIG=0x%X\n", SPACECRAFT_CONFIG);
     printf("  ASTEROID_L_CONFIG=0x%X\n", ASTEROID_L_CONFIG);
     printf("  EARTH_CONFIG=0x%X\n", EARTH_CONFIG);
+    printf("  SPRITE_LIST_CONFIG=0x%X (%u slots)\n", SPRITE_LIST_CONFIG, SPRITE_SLOTS);
     printf("  FIGHTER_CONFIG=0x%X\n", FIGHTER_CONFIG);
     printf("  EBULLET_CONFIG=0x%X\n", EBULLET_CONFIG);
     printf("  BULLET_CONFIG=0x%X\n", BULLET_CONFIG);
@@ -334,6 +371,9 @@ static void init_graphics(void)
     const unsigned bytes_per_char = 3; // we write 3 bytes per character into text RAM
     unsigned text_storage_end = text_message_addr + MESSAGE_LENGTH * bytes_per_char;
     printf("  text_storage_end=0x%X\n", text_storage_end);
+    if (text_message_addr < OVERLAY_CONFIG && text_storage_end > OVERLAY_CONFIG) {
+        printf("ERROR: text storage overlaps the overlay config at 0x%X\n", OVERLAY_CONFIG);
+    }
     printf("  GAME_PAD_CONFIG=0x%X\n", GAMEPAD_INPUT);
     printf("  KEYBOARD_CONFIG=0x%X\n", KEYBOARD_INPUT);
     printf("  PSG_CONFIG=0x%X\n", PSG_XRAM_ADDR);
@@ -356,8 +396,9 @@ static void init_graphics(void)
         xram0_struct_set(ptr, vga_mode1_config_t, xram_font_ptr, 0xFFFF);
     }
 
-    // 4 parameters: text mode, 8-bit, config, plane
-    xregn(1, 0, 1, 4, 1, 3, TEXT_CONFIG, 2);
+    // 6 parameters: text mode, 8-bit, config, plane, HUD scanlines
+    xregn(1, 0, 1, 6, 1, 3, TEXT_CONFIG, 2, 0, HUD_SCANLINES);
+    overlay_init();
 
     // Build composed message layout:
     // [pad][player:3][sp][block1:8][sp][game:5][sp][block2:8][sp][enemy:3][pad]
@@ -469,21 +510,30 @@ static void init_game(void)
     // Initialize entity pools
     init_bullets();
     init_sbullets();
+    anim_init();
     init_fighters();
     init_asteroids();
+    raster_set_playfield(true);  // Bitmap below the HUD (4bpp double-buffered with LOWRES_BITMAP)
+    overlay_show(true);          // Message text in the rows it freed
+#ifdef PREROTATED_SHIP
+    load_ship_frames();          // Also kept in those rows
+#endif
     init_stars();
     init_explosions();
 
-    // Reset Earth position
-    earth_x = SCREEN_WIDTH / 2;
-    earth_y = SCREEN_HEIGHT / 2;
+    // Periodic jobs registered by the inits above
+    sched_report();
+
+    // Reset Earth position (init_player() re-centred the camera)
+    earth_x = world_x(SCREEN_WIDTH / 2);
+    earth_y = world_y(SCREEN_HEIGHT / 2);
 
     // Reset power-up state
     powerup.active = false;
     powerup.timer = 0;
     // If not already, move power-up sprite offscreen
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
 
     printf("Game initialized\n");
 }
@@ -496,12 +546,9 @@ void render_game(void)
     // Draw scrolling star background
     draw_stars(scroll_dx, scroll_dy);
     
-    // Update Earth sprite position based on scrolling with wrapping
-    earth_x -= scroll_dx;
-    earth_y -= scroll_dy;
-    
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, x_pos_px, earth_x);
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, y_pos_px, earth_y);
+    // Earth sits still in the world; only the camera moves
+    sprite_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, x_pos_px, screen_x(earth_x));
+    sprite_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, y_pos_px, screen_y(earth_y));
     
     // Update fighter sprite positions
     render_fighters();
@@ -519,12 +566,12 @@ void render_game(void)
 void hide_all_sprites(void)
 {
     // 1. Hide Player
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, -100);
+    sprite_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, -100);
 
     // 2. Hide Special Objects
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
-    // xram0_struct_set(MARKER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    sprite_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    // sprite_struct_set(MARKER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
 
     // 3. Hide Swarms
     // (We reuse the helpers you likely wrote for show_game_over, 
@@ -539,15 +586,17 @@ void hide_all_sprites(void)
     size_t sprite_size = sizeof(vga_mode4_sprite_t);
     for (uint8_t i = 0; i < MAX_BULLETS; i++) {
         unsigned ptr = BULLET_CONFIG + (i * sprite_size);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
     }
 
     // Reset Earth position
-    earth_x = SCREEN_WIDTH / 2;
-    earth_y = SCREEN_HEIGHT / 2;
+    earth_x = world_x(SCREEN_WIDTH / 2);
+    earth_y = world_y(SCREEN_HEIGHT / 2);
 
     init_explosions();
 
+    // Take effect now; the next screen may not flush for a while
+    sprite_shadow_flush();
 }
 
 // ============================================================================
@@ -572,6 +621,7 @@ int main(void)
     init_graphics();
     init_psg();
     init_music();
+    audio_init();
     
     // Load high scores from file
     load_high_scores();
@@ -584,6 +634,10 @@ int main(void)
 
     // Initialize input mappings (ensure `button_mappings` are set)
     init_input_system();  // new function to set up input mappings
+
+#ifdef PROFILER
+    profiler_init();
+#endif
     
     printf("\nControls:\n");
     printf("  Keyboard: Arrow keys to rotate/thrust, SPACE/SHIFT to fire\n");
@@ -607,6 +661,8 @@ int main(void)
         // Reset demo mode counter
         if (demo_mode_active) {
             demo_frames = 0;
+            palette_effect_start(PAL_FX_DEMO, PAL_BAND_DEMO, 1, PAL_RAINBOW_FIRST, PAL_RAINBOW_LEN,
+                                 0, 1);
         }
 
         // Initialize/reset game state
@@ -619,7 +675,6 @@ int main(void)
         
         // Gameplay loop
         game_over = false;
-        bool demo_input_was_pressed = false;
         // uint16_t game_frame = 0;
         while (!game_over) {
             // Wait for vertical sync (60 Hz)
@@ -627,8 +682,18 @@ int main(void)
                 continue;
             vsync_last = RIA.vsync;
 
+            // Commit last frame's sprite changes while the beam is in vblank
+            sprite_shadow_flush();
+            raster_flip();
+            update_palette();
+#ifdef PROFILER
+            profiler_frame_begin();
+#endif
+
             // Read input
+            PROFILE_BEGIN(PROF_INPUT);
             handle_input(); 
+            PROFILE_END(PROF_INPUT);
 
             // This prevents the START button from freezing the game during the demo
             if (!demo_mode_active) {
@@ -646,12 +711,8 @@ int main(void)
                 }
 
                 // B. Check for Exit Conditions
-                // Check Semantic Actions (FIRE or PAUSE/START)
-                bool input_pressed = is_action_pressed(0, ACTION_FIRE);
-
-                // C. Check for Button Release (Edge Detection)
-                // Only exit if input WAS pressed last frame and is NOT pressed now.
-                if (demo_input_was_pressed && !input_pressed) {
+                // Exit on the frame FIRE is released
+                if (is_action_just_released(0, ACTION_FIRE)) {
                     demo_mode_active = false;
                     game_over = true;
                     stop_music(); 
@@ -661,9 +722,6 @@ int main(void)
                     // the real game doesn't start immediately paused.
                     if (is_game_paused()) handle_pause_input();
                 }
-                
-                // Update history for the next frame
-                demo_input_was_pressed = input_pressed;
             }
             
             // Check for ESC key to exit
@@ -699,9 +757,6 @@ int main(void)
                 continue;
             }
             
-            // Update music
-            update_music();
-            
             // Update cooldown timers
             decrement_bullet_cooldown();
             decrement_ebullet_cooldown();
@@ -724,18 +779,29 @@ int main(void)
             
             // Update game logic
             update_player(demo_mode_active);
+            PROFILE_BEGIN(PROF_FIGHTERS);
             update_fighters();
+            PROFILE_END(PROF_FIGHTERS);
+            PROFILE_BEGIN(PROF_BULLETS);
             update_bullets();
             update_sbullets();
+            PROFILE_END(PROF_BULLETS);
+            PROFILE_BEGIN(PROF_EBULLETS);
             update_ebullets();
+            PROFILE_END(PROF_EBULLETS);
 
             // spawn_bomber(game_level);
             // update_bomber();  // New bomber update
             
             spawn_asteroid_wave(game_level);
+            PROFILE_BEGIN(PROF_ASTEROIDS);
             update_asteroids();
+            PROFILE_END(PROF_ASTEROIDS);
             
+            PROFILE_BEGIN(PROF_EXPLOSIONS);
             update_explosions();
+            animate_all();
+            PROFILE_END(PROF_EXPLOSIONS);
 
             // Only check if playing (not demo) and not already game over
             if (!demo_mode_active && !game_over) {
@@ -746,24 +812,21 @@ int main(void)
             update_powerup();
             
             // Render frame
+            PROFILE_BEGIN(PROF_RENDER);
             render_game();
+            PROFILE_END(PROF_RENDER);
+            PROFILE_BEGIN(PROF_HUD);
             draw_hud();
+            PROFILE_END(PROF_HUD);
 
             // Demo Overlay Rendering (Kept at bottom to draw on top)
             if (demo_mode_active) {
-                // Update demo text color and text only every 20 frames
-                if ((demo_frames % 20) == 0) {  
-                    // Use the new Rainbow Palette (Indices 32-255)
-                    // The spectrum has 224 colors.
-                    // Since this runs every 20 frames, the color index jumps by 20 each update,
-                    // creating a noticeable shift (like a slow strobe) rather than a smooth gradient.
-                    uint8_t demo_color = 32 + (demo_frames % 224);
-        
-                    draw_text(SCREEN_WIDTH / 2 - 23, 25, "DEMO MODE", demo_color);
-                    
-                    // "PRESS FIRE TO EXIT" is approx 72px wide. 
-                    // 160 (Center) - 36 (Half width) = 124. 
-                    draw_text(124, SCREEN_HEIGHT - 15, "PRESS FIRE TO EXIT", demo_color);
+                // Written once on the overlay; its palette entry cycles the
+                // rainbow every frame
+                if (demo_frames == 1) {
+                    overlay_text_centered(overlay_row_at(25), "DEMO MODE", PAL_BAND_DEMO);
+                    overlay_text_centered(overlay_row_at(SCREEN_HEIGHT - 15), "PRESS FIRE TO EXIT",
+                                          PAL_BAND_DEMO);
                 }
 
                 if (demo_frames >= DEMO_DURATION_FRAMES) {
@@ -774,6 +837,10 @@ int main(void)
                 }
             }
             
+#ifdef PROFILER
+            profiler_frame_end();
+#endif
+
             // Increment frame counter
             game_frame++;
             if (game_frame >= 60) {
@@ -816,7 +883,14 @@ int main(void)
             }
         }
     // Gameplay loop ended - will return to title screen
+#ifdef PROFILER
+        profiler_dump();
+#endif
         hide_all_sprites();
+        palette_stop_all();
+        overlay_show(false);
+        stop_stars();
+        raster_set_playfield(false);
         printf("Game/Demo Finished. Resetting...\n");
     }
     
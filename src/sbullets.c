@@ -4,6 +4,8 @@
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "sprite_shadow.h"
+#include "motion.h"
 
 // Get SHIP_ROTATION_STEPS from constants.h
 // (It's defined there as the number of rotation steps)
@@ -61,8 +63,8 @@ void move_sbullets_offscreen(void)
         if (sbullets[i].status >= 0) {
             sbullets[i].status = -1;
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
         }
     }
 }
@@ -73,8 +75,8 @@ void init_sbullets(void)
         sbullets[i].status = -1;
         sbullets[i].x = 0;
         sbullets[i].y = 0;
-        sbullets[i].vx_rem = 0;
-        sbullets[i].vy_rem = 0;
+        sbullets[i].x_frac = 0;
+        sbullets[i].y_frac = 0;
     }
     sbullet_cooldown_timer = 0;
     sbullet_lifetime_timer = 0;
@@ -113,15 +115,15 @@ bool fire_sbullet(uint8_t player_rotation)
     }
     sbullets[0].x = start_x;
     sbullets[0].y = start_y;
-    sbullets[0].vx_rem = 0;
-    sbullets[0].vy_rem = 0;
+    sbullets[0].x_frac = 0;
+    sbullets[0].y_frac = 0;
     
     // Center bullet (player rotation)
     sbullets[1].status = player_rotation;
     sbullets[1].x = start_x;
     sbullets[1].y = start_y;
-    sbullets[1].vx_rem = 0;
-    sbullets[1].vy_rem = 0;
+    sbullets[1].x_frac = 0;
+    sbullets[1].y_frac = 0;
     
     // Right bullet (rotation + 1)
     sbullets[2].status = player_rotation + 1;
@@ -130,8 +132,8 @@ bool fire_sbullet(uint8_t player_rotation)
     }
     sbullets[2].x = start_x;
     sbullets[2].y = start_y;
-    sbullets[2].vx_rem = 0;
-    sbullets[2].vy_rem = 0;
+    sbullets[2].x_frac = 0;
+    sbullets[2].y_frac = 0;
     
     // Play sound effect
     play_sound(SFX_TYPE_PLAYER_FIRE, 880, PSG_WAVE_SQUARE, 0, 3, 2, 3);
@@ -159,8 +161,8 @@ void update_sbullets(void)
             if (sbullets[i].status >= 0) {
                 sbullets[i].status = -1;
                 unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+                sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             }
         }
         sbullet_lifetime_timer = 0;
@@ -171,8 +173,8 @@ void update_sbullets(void)
         if (sbullets[i].status < 0) {
             // Move sprite offscreen when inactive
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             continue;
         }
         
@@ -181,39 +183,32 @@ void update_sbullets(void)
             // Hit a fighter - deactivate bullet
             // sbullets[i].status = -1;
             // unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            // xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            // xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            // sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            // sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
             continue;
         }
         
         // Calculate velocity based on stored direction
-        int16_t bvx_req = -sin_fix[sbullets[i].status];
-        int16_t bvy_req = -cos_fix[sbullets[i].status];
-        
-        // Apply velocity with remainder tracking (>>6 = divide by 64)
-        int16_t bvx_applied = (bvx_req + sbullets[i].vx_rem) >> SBULLET_SPEED_SHIFT;
-        int16_t bvy_applied = (bvy_req + sbullets[i].vy_rem) >> SBULLET_SPEED_SHIFT;
-        
-        sbullets[i].vx_rem = bvx_req + sbullets[i].vx_rem - (bvx_applied << SBULLET_SPEED_SHIFT);
-        sbullets[i].vy_rem = bvy_req + sbullets[i].vy_rem - (bvy_applied << SBULLET_SPEED_SHIFT);
+        q88_t bvx = Q88_FROM_SHIFT(-sin_fix[sbullets[i].status], SBULLET_SPEED_SHIFT);
+        q88_t bvy = Q88_FROM_SHIFT(-cos_fix[sbullets[i].status], SBULLET_SPEED_SHIFT);
         
         // Move bullet
-        sbullets[i].x += bvx_applied;
-        sbullets[i].y += bvy_applied;
+        motion_step(&sbullets[i].x, &sbullets[i].x_frac, bvx);
+        motion_step(&sbullets[i].y, &sbullets[i].y_frac, bvy);
         
         // Check if bullet is still on screen
         if (sbullets[i].x >= 0 && sbullets[i].x < SCREEN_WIDTH &&
             sbullets[i].y >= 0 && sbullets[i].y < SCREEN_HEIGHT) {
             // Update sprite position
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, sbullets[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, sbullets[i].y);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, sbullets[i].x);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, sbullets[i].y);
         } else {
             // Off screen - deactivate
             sbullets[i].status = -1;
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
+            sprite_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
         }
     }
 }
@@ -10,7 +10,7 @@
 #define SBULLET_COOLDOWN_MAX      120      // Frames between super bullet shots
 #define SBULLET_COOLDOWN_MIN       40      // Minimum cooldown for super bullets
 #define SBULLET_COOLDOWN_DECREASE  10      // Decrease per power-up
-#define SBULLET_SPEED_SHIFT         6      // Divide by 64 for bullet speed (~4 pixels/frame)
+#define SBULLET_SPEED_SHIFT         6      // Table value / 64 = pixels per frame (~4 pixels/frame)
 #define SBULLET_LIFETIME_FRAMES    20      // Lifetime of a super bullet in frames
 
 /**
@@ -24,7 +24,7 @@
 typedef struct {
     int16_t x, y;           // Position
     int16_t status;         // -1 = inactive, 0-23 = active with direction
-    int16_t vx_rem, vy_rem; // Velocity remainder for sub-pixel movement
+    uint8_t x_frac, y_frac; // Sub-pixel position (see motion.h)
 } SBullet;
 
 /**
@@ -0,0 +1,135 @@
+/*
+ * scheduler.c - Amortized periodic work
+ *
+ * Periodic work used to land on fixed frames (every fighter re-targeting
+ * on game_frame 0, all stars recolouring every fourth frame), so the
+ * worst frame was far heavier than the average. Jobs now register a
+ * period, an item count and a cost class; items are sliced across the
+ * period and each job gets the phase that keeps the heaviest frame of
+ * the SCHED_CYCLE-frame cycle lightest. Phases are planned once, at
+ * registration, so the per-frame cost is one add and one modulo.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "scheduler.h"
+
+// ============================================================================
+// TYPES
+// ============================================================================
+
+typedef struct {
+    uint8_t period;     // 0 = not registered
+    uint8_t items;
+    uint8_t cost;
+    uint8_t phase;
+} sched_job_t;
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static const char *const job_names[SCHED_JOB_COUNT] = {
+    "fighter retarget", "fighter rocks", "bullet rocks", "ebullet rocks"
+};
+
+static sched_job_t jobs[SCHED_JOB_COUNT];
+static uint16_t frame_load[SCHED_CYCLE];
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+/**
+ * Items of a job due in slot r (those with i % period == r)
+ */
+static uint8_t items_in_slot(const sched_job_t *j, uint8_t r)
+{
+    return r < j->items ? (j->items - 1 - r) / j->period + 1 : 0;
+}
+
+/**
+ * Add (sign 1) or remove (sign -1) a job's load from the plan
+ */
+static void apply_load(const sched_job_t *j, int8_t sign)
+{
+    uint8_t r = j->phase;
+    for (uint8_t f = 0; f < SCHED_CYCLE; f++) {
+        frame_load[f] += sign * j->cost * items_in_slot(j, r);
+        if (++r >= j->period) r = 0;
+    }
+}
+
+void sched_register(SchedJob job, uint8_t period, uint8_t items, SchedCost cost)
+{
+    sched_job_t *j = &jobs[job];
+
+    if (period == 0 || SCHED_CYCLE % period != 0) {
+        printf("ERROR: job period %u does not divide %u frames\n", period, SCHED_CYCLE);
+        period = 1;
+    }
+    if (j->period) {
+        apply_load(j, -1);
+    }
+    j->period = period;
+    j->items = items;
+    j->cost = cost;
+
+    // Try each phase: lowest peak wins, then the flattest spread
+    uint16_t best_peak = 0xFFFF;
+    uint32_t best_spread = 0xFFFFFFFFUL;
+    j->phase = 0;
+    for (uint8_t phase = 0; phase < period; phase++) {
+        uint16_t peak = 0;
+        uint32_t spread = 0;
+        uint8_t r = phase;
+        for (uint8_t f = 0; f < SCHED_CYCLE; f++) {
+            uint16_t load = frame_load[f] + cost * items_in_slot(j, r);
+            if (load > peak) peak = load;
+            spread += (uint32_t)load * load;
+            if (++r >= period) r = 0;
+        }
+        if (peak < best_peak || (peak == best_peak && spread < best_spread)) {
+            best_peak = peak;
+            best_spread = spread;
+            j->phase = phase;
+        }
+    }
+
+    apply_load(j, 1);
+}
+
+uint8_t sched_slot(SchedJob job, uint16_t frame)
+{
+    const sched_job_t *j = &jobs[job];
+    if (j->period <= 1) {
+        return 0;
+    }
+    return (frame + j->phase) % j->period;
+}
+
+uint16_t sched_frame_load(uint8_t frame)
+{
+    return frame < SCHED_CYCLE ? frame_load[frame] : 0;
+}
+
+void sched_report(void)
+{
+    uint16_t peak = 0;
+    uint16_t low = 0xFFFF;
+    uint16_t total = 0;
+    for (uint8_t f = 0; f < SCHED_CYCLE; f++) {
+        if (frame_load[f] > peak) peak = frame_load[f];
+        if (frame_load[f] < low) low = frame_load[f];
+        total += frame_load[f];
+    }
+
+    printf("Scheduler: frame load min %u avg %u.%02u max %u\n", low,
+           total / SCHED_CYCLE, (total % SCHED_CYCLE) * 100 / SCHED_CYCLE, peak);
+    for (uint8_t i = 0; i < SCHED_JOB_COUNT; i++) {
+        if (jobs[i].period) {
+            printf("  %-16s every %2u frames, %2u items, phase %u\n", job_names[i],
+                   jobs[i].period, jobs[i].items, jobs[i].phase);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// Length of the schedule in frames; every job period must divide it
+#define SCHED_CYCLE 60
+
+// Periodic jobs spread over the frame cycle by the scheduler
+typedef enum {
+    SCHED_FIGHTER_RETARGET = 0, // Fighter turns toward the player
+    SCHED_FIGHTER_ROCKS,        // Fighter vs asteroid collision
+    SCHED_BULLET_ROCKS,         // Player bullet vs asteroid collision
+    SCHED_EBULLET_ROCKS,        // Enemy bullet vs asteroid collision
+    SCHED_JOB_COUNT
+} SchedJob;
+
+// Relative cost of one item of a job, used to balance the frames
+typedef enum {
+    SCHED_COST_LIGHT  = 1,      // A few adds/compares
+    SCHED_COST_MEDIUM = 2,      // A short loop or a call
+    SCHED_COST_HEAVY  = 4       // A collision sweep
+} SchedCost;
+
+/**
+ * Register (or re-register) a job of `items` items, each run once every
+ * `period` frames, and pick the phase that keeps the heaviest frame of
+ * the cycle as light as possible
+ */
+void sched_register(SchedJob job, uint8_t period, uint8_t items, SchedCost cost);
+
+/**
+ * Slot of the job for this frame: item i is due when i % period == slot.
+ * `frame` is any counter advancing once per frame (e.g. game_frame).
+ */
+uint8_t sched_slot(SchedJob job, uint16_t frame);
+
+/**
+ * Planned load (sum of item costs) on one frame of the cycle
+ */
+uint16_t sched_frame_load(uint8_t frame);
+
+/**
+ * Print each job's phase and the peak/average planned frame load
+ */
+void sched_report(void);
+
+#endif // SCHEDULER_H
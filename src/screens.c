@@ -7,14 +7,19 @@
 #include <stdint.h>
 #include "powerup.h"
 #include "sbullets.h"
+#include "bullets.h"
 #include "input.h"
 #include "asteroids.h"
 #include "player.h"
 #include "bkgstars.h"
 #include "explosions.h"
+#include "sprite_shadow.h"
+#include "camera.h"
+#include "palette.h"
+#include "overlay.h"
+#include "anim.h"
 
 // External references
-extern void draw_text(int16_t x, int16_t y, const char* text, uint8_t color);
 extern void clear_rect(int16_t x, int16_t y, int16_t width, int16_t height);
 extern void move_fighters_offscreen(void);
 extern void move_ebullets_offscreen(void);
@@ -24,7 +29,6 @@ extern void get_player_initials(char* initials);
 extern void insert_high_score(int8_t position, const char* initials, int16_t score);
 extern void save_high_scores(void);
 extern void start_end_music(void);
-extern void update_music(void);
 extern void stop_music(void);
 extern void move_asteroids_offscreen(void);
 
@@ -37,15 +41,6 @@ extern int16_t fighters_killed;
 extern int16_t asteroids_destroyed;
 extern int16_t powerups_collected;
 
-// Bullet structure
-typedef struct {
-    int16_t x, y;
-    int16_t vx, vy;
-    int16_t status;
-} Bullet;
-
-extern Bullet bullets[];
-
 // extern gamepad_t gamepad[GAMEPAD_COUNT];
 extern uint8_t keystates[KEYBOARD_BYTES];
 
@@ -62,39 +57,23 @@ void show_level_up(void)
 {
     const uint8_t blue_color = 0x1F;
     const uint8_t white_color = 0xFF;
-    const uint16_t center_x = 120;
-    const uint16_t center_y = 80;
+    const uint8_t row = overlay_row_at(80);
         
     // Draw "LEVEL UP" message
-    draw_text(center_x, center_y, "LEVEL UP", blue_color);
+    overlay_text_centered(row, "LEVEL UP", blue_color);
     // Changed text to match the Action, not a specific button
-    draw_text(center_x - 45, center_y + 15, "PRESS FIRE TO CONTINUE", white_color);
+    overlay_text_centered(row + 2, "PRESS FIRE TO CONTINUE", white_color);
     
     printf("\n*** LEVEL UP! Now on level %d ***\n", game_level);
     
-    uint8_t vsync_last = RIA.vsync;
-    
-    // ---------------------------------------------------------
-    // PHASE 1: Wait for FIRE to be RELEASED
-    // (Prevents accidental skipping if button was held down)
-    // ---------------------------------------------------------
-    while (true) {
-        if (RIA.vsync == vsync_last)
-            continue;
-        vsync_last = RIA.vsync;
-        
-        // Update input state
-        handle_input();
+    // Show the frame that triggered the level up
+    sprite_shadow_flush();
 
-        // Break only when FIRE is NOT pressed
-        if (!is_action_pressed(0, ACTION_FIRE)) {
-            break;
-        }
-    }
+    uint8_t vsync_last = RIA.vsync;
     
     // ---------------------------------------------------------
-    // PHASE 2: Wait for FIRE to be PRESSED
-    // (The actual user interaction)
+    // PHASE 1: Wait for a new FIRE press
+    // (A FIRE still held from gameplay doesn't count)
     // ---------------------------------------------------------
     while (true) {
         if (RIA.vsync == vsync_last)
@@ -103,14 +82,14 @@ void show_level_up(void)
         
         handle_input();
         
-        // Break the moment FIRE is pressed
-        if (is_action_pressed(0, ACTION_FIRE)) {
+        // Break the moment FIRE goes down
+        if (is_action_just_pressed(0, ACTION_FIRE)) {
             break; 
         }
     }
 
     // ---------------------------------------------------------
-    // PHASE 3: Wait for FIRE to be RELEASED Again
+    // PHASE 2: Wait for FIRE to be RELEASED
     // (Prevents the ship from firing immediately when game resumes)
     // ---------------------------------------------------------
     while (true) {
@@ -126,7 +105,7 @@ void show_level_up(void)
     }
     
     // Clear the message area
-    clear_rect(center_x - 45, center_y, 150, 25);
+    overlay_clear_rows(row, 3);
 }
 
 /**
@@ -134,15 +113,9 @@ void show_level_up(void)
  */
 void show_game_over(void)
 {
-    const uint16_t center_x = 130;  // Better centered for text
-    uint16_t color_timer = 0;  // For rainbow cycling
-
-    // Clear crash text around player position (40x40 box centered on player)
-    // Player sprite is 8x8, so center is at player_x+4, player_y+4
-    // int16_t clear_x = player_x + 4 - 20;  // Center - half width
-    // int16_t clear_y = player_y + 4 - 20;  // Center - half height
-    // clear_rect(clear_x, clear_y, 60, 60);
-    clear_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT); // Clear entire screen for simplicity
+    // Clear the crash text and the death effects
+    overlay_clear();
+    clear_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
     draw_stars(1, 1); // Redraw stars in background
     
     // Start end music
@@ -155,20 +128,13 @@ void show_game_over(void)
     move_asteroids_offscreen();
     
     // Move all bullets offscreen
-    for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        if (bullets[i].status >= 0) {
-            unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            bullets[i].status = -1;
-        }
-    }
+    move_bullets_offscreen();
 
     // reset power-up state
     powerup.active = false;
     // Move power-up sprite offscreen
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
+    sprite_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
     
     // Reset player position to center
     reset_player_position();
@@ -192,7 +158,6 @@ void show_game_over(void)
     printf("Final Score: %d\n", game_score);
     
     uint8_t vsync_last = RIA.vsync;
-    bool fire_initially_released = false;
     
     unsigned timeout_frames = 30 * 60; // 30 seconds
     unsigned frame_count = 0;
@@ -201,54 +166,46 @@ void show_game_over(void)
     // Display statistics
     char stat_buf[32];
     snprintf(stat_buf, sizeof(stat_buf), "FIGHTERS KILLED: %d", fighters_killed);
-    draw_text(center_x - 12, 110, stat_buf, stats_color);
+    overlay_text_centered(overlay_row_at(110), stat_buf, stats_color);
     
     snprintf(stat_buf, sizeof(stat_buf), "ASTEROIDS DESTROYED: %d", asteroids_destroyed);
-    draw_text(center_x - 18, 125, stat_buf, stats_color);
+    overlay_text_centered(overlay_row_at(125), stat_buf, stats_color);
     
     snprintf(stat_buf, sizeof(stat_buf), "POWER-UPS COLLECTED: %d", powerups_collected);
-    draw_text(center_x - 18, 140, stat_buf, stats_color);
+    overlay_text_centered(overlay_row_at(140), stat_buf, stats_color);
 
+    // Rainbow text (similar to pause screen): drawn once, cycled in the
+    // palette, with the prompt half the rainbow away from the title
+    palette_effect_start(PAL_FX_GAME_OVER, PAL_BAND_GAME_OVER, 2, PAL_RAINBOW_FIRST,
+                         PAL_RAINBOW_LEN, PAL_RAINBOW_LEN / 2, 2);
+    overlay_text_centered(overlay_row_at(80), "GAME OVER", PAL_BAND_GAME_OVER);
+    overlay_text_centered(overlay_row_at(160), "PRESS FIRE TO CONTINUE", PAL_BAND_GAME_OVER + 1);
 
     while (frame_count < timeout_frames) {
         if (RIA.vsync == vsync_last)
             continue;
         vsync_last = RIA.vsync;
 
+        sprite_shadow_flush();
+        update_palette();
         frame_count++;
-        update_music();
         
         // Update explosions so they animate
         update_explosions();
+        animate_all();
         
         // Random explosions every few frames for visual effect
         if ((frame_count % 8) == 0) {  // Trigger every 8 frames
             int16_t exp_x = rand() % 160 + 160;
             int16_t exp_y = rand() % 90 + 90;
-            start_explosion(exp_x, exp_y);
+            start_explosion(world_x(exp_x), world_y(exp_y));
         }
         
-        // Rainbow color cycling (similar to pause screen)
-        color_timer++;
-        uint8_t game_over_color = 32 + ((color_timer / 2) % 224);
-        uint8_t continue_color = 32 + (((color_timer / 2) + 112) % 224);  // Offset for variety
-        
-        // Draw "GAME OVER" message with rainbow color
-        draw_text(center_x + 7, 80, "GAME OVER", game_over_color);
-        
-        draw_text(center_x - 20, 160, "PRESS FIRE TO CONTINUE", continue_color);
-        
         // Update inputs
         handle_input();
         
-        bool fire_pressed = is_action_pressed(0, ACTION_FIRE);
-        
-        // Logic: Wait for the button to be released at least once...
-        if (!fire_pressed) {
-            fire_initially_released = true;
-        } 
-        // ...then wait for it to be pressed again.
-        else if (fire_initially_released) {
+        // A new press continues; FIRE held since gameplay doesn't
+        if (is_action_just_pressed(0, ACTION_FIRE)) {
             printf("Fire button pressed - continuing...\n");
             break; // Exit loop
         }
@@ -267,6 +224,7 @@ void show_game_over(void)
     }
 
     stop_music();
+    palette_effect_stop(PAL_FX_GAME_OVER);
     
     // Fast Screen Clear (Wipe VRAM)
     RIA.addr0 = 0;
@@ -1,30 +1,27 @@
 #include "sound.h"
-#include "constants.h"
+#include "psg.h"
+#include "audio.h"
 #include <rp6502.h>
 #include <stdint.h>
 
 // ============================================================================
-// MODULE STATE
+// CONSTANTS
 // ============================================================================
 
-// Channel allocation (2 channels per effect type for round-robin)
-static uint8_t next_channel[SFX_TYPE_COUNT] = {0, 2};
+// Voice priority of each effect type
+static const uint8_t sfx_priority[SFX_TYPE_COUNT] = {
+    PSG_PRIO_SFX,       // SFX_TYPE_PLAYER_FIRE
+    PSG_PRIO_SFX_LOW,   // SFX_TYPE_ENEMY_FIRE
+    PSG_PRIO_SFX_HIGH,  // SFX_TYPE_HIT
+};
 
-// ============================================================================
-// INTERNAL FUNCTIONS
-// ============================================================================
-
-/**
- * Stop sound on a channel
- */
-static void stop_sound(uint8_t channel)
-{
-    if (channel > 7) return;
-    
-    uint16_t psg_addr = PSG_XRAM_ADDR + (channel * 8) + 6;  // pan_gate offset
-    RIA.addr0 = psg_addr;
-    RIA.rw0 = 0x00;  // Gate off (release)
-}
+// Envelope rates in frames (2 ms - 8 s attack, 6 ms - 24 s decay)
+static const uint8_t attack_frames[16] = {
+    1, 1, 1, 2, 3, 4, 5, 5, 6, 15, 30, 48, 60, 180, 255, 255
+};
+static const uint8_t decay_frames[16] = {
+    1, 2, 3, 5, 7, 11, 13, 15, 18, 45, 90, 144, 180, 255, 255, 255
+};
 
 // ============================================================================
 // PUBLIC FUNCTIONS
@@ -32,53 +29,51 @@ static void stop_sound(uint8_t channel)
 
 void init_psg(void)
 {
-    // Enable PSG at XRAM address PSG_XRAM_ADDR
-    xregn(0, 1, 0x00, 1, PSG_XRAM_ADDR);
-    
-    // Clear all 8 channels (64 bytes total)
-    RIA.addr0 = PSG_XRAM_ADDR;
-    RIA.step0 = 1;
-    for (uint8_t i = 0; i < 64; i++) {
-        RIA.rw0 = 0;
-    }
+    // Enable PSG at XRAM address PSG_XRAM_ADDR, all 8 channels silent
+    psg_init();
 }
 
 void play_sound(uint8_t sfx_type, uint16_t freq, uint8_t wave, 
                 uint8_t attack, uint8_t decay, uint8_t release, uint8_t volume)
+{
+    AudioCommand *cmd = audio_command(AUDIO_CMD_SFX);
+    if (!cmd) return;
+
+    cmd->arg[0] = sfx_type;
+    cmd->arg[1] = wave;
+    cmd->arg[2] = attack;
+    cmd->arg[3] = decay;
+    cmd->arg[4] = release;
+    cmd->arg[5] = volume;
+    cmd->word = freq;
+    audio_post();
+}
+
+void sound_start(uint8_t sfx_type, uint16_t freq, uint8_t wave,
+                 uint8_t attack, uint8_t decay, uint8_t release, uint8_t volume)
 {
     if (sfx_type >= SFX_TYPE_COUNT) return;
-    
-    // Get base channel for this effect type (each type has 2 channels)
-    uint8_t base_channel = sfx_type * 2;
-    uint8_t channel = base_channel + next_channel[sfx_type];
-    
-    // Release the previous sound on the old channel
-    uint8_t old_channel = base_channel + (1 - next_channel[sfx_type]);
-    stop_sound(old_channel);
-    
-    // Toggle to next channel for this effect type
-    next_channel[sfx_type] = 1 - next_channel[sfx_type];
-    
-    uint16_t psg_addr = PSG_XRAM_ADDR + (channel * 8);
-    
+
+    // Decay runs to silence, so the voice is done after attack + decay
+    uint16_t frames = attack_frames[attack & 0x0F] + decay_frames[decay & 0x0F];
+    uint8_t channel = psg_voice_alloc(sfx_priority[sfx_type], frames < 255 ? frames : 255);
+    if (channel == PSG_VOICE_NONE) return;
+
     // Set frequency (Hz * 3)
-    uint16_t freq_val = freq * 3;
-    RIA.addr0 = psg_addr;
-    RIA.rw0 = freq_val & 0xFF;          // freq low byte
-    RIA.rw0 = (freq_val >> 8) & 0xFF;   // freq high byte
+    psg_set_freq(channel, freq * 3);
     
     // Set duty cycle (50%)
-    RIA.rw0 = 128;
+    psg_write(channel, PSG_REG_DUTY, 128);
     
     // Set volume and attack
-    RIA.rw0 = (volume << 4) | (attack & 0x0F);
+    psg_write(channel, PSG_REG_VOL_ATTACK, (volume << 4) | (attack & 0x0F));
     
     // Set decay volume to 15 (silent) so sound fades naturally without sustain
-    RIA.rw0 = (15 << 4) | (decay & 0x0F);
+    psg_write(channel, PSG_REG_VOL_DECAY, (15 << 4) | (decay & 0x0F));
     
     // Set waveform and release
-    RIA.rw0 = (wave << 4) | (release & 0x0F);
+    psg_write(channel, PSG_REG_WAVE_RELEASE, (wave << 4) | (release & 0x0F));
     
-    // Set pan (center) and gate (on)
-    RIA.rw0 = 0x01;  // Center pan, gate on
+    // Center pan, gate on
+    psg_gate(channel, true);
 }
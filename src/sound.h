@@ -6,7 +6,8 @@
 /**
  * sound.h - PSG (Programmable Sound Generator) sound system
  * 
- * Manages 8-channel sound effects with round-robin allocation
+ * Sound effects take PSG voices by priority (see psg.h), so a burst of
+ * enemy fire can't cut off the player's own sounds
  */
 
 // Waveform types
@@ -18,12 +19,12 @@ typedef enum {
     PSG_WAVE_NOISE = 4
 } PSGWaveform;
 
-// Sound effect types (for round-robin channel allocation)
+// Sound effect types (each has a voice priority)
 typedef enum {
     SFX_TYPE_PLAYER_FIRE = 0,
     SFX_TYPE_ENEMY_FIRE = 1,
     SFX_TYPE_HIT = 2,
-    SFX_TYPE_COUNT = 2  // Only 2 types currently used
+    SFX_TYPE_COUNT
 } SFXType;
 
 /**
@@ -32,8 +33,9 @@ typedef enum {
 void init_psg(void);
 
 /**
- * Play a sound effect with round-robin channel allocation
- * @param sfx_type Sound effect type (determines channel allocation)
+ * Play a sound effect on a voice picked by the type's priority, from the
+ * next audio tick (audio.h)
+ * @param sfx_type Sound effect type (determines voice priority)
  * @param freq Frequency in Hz
  * @param wave Waveform type
  * @param attack Attack rate (0-15)
@@ -44,4 +46,10 @@ void init_psg(void);
 void play_sound(uint8_t sfx_type, uint16_t freq, uint8_t wave, 
                 uint8_t attack, uint8_t decay, uint8_t release, uint8_t volume);
 
+/**
+ * Audio tick side of play_sound(): take a voice and start the effect now
+ */
+void sound_start(uint8_t sfx_type, uint16_t freq, uint8_t wave,
+                 uint8_t attack, uint8_t decay, uint8_t release, uint8_t volume);
+
 #endif // SOUND_H
@@ -1,7 +1,9 @@
 #include <rp6502.h>
 #include <fcntl.h>
 
-static void load_rom_to_xram(const char *name, unsigned xaddr, unsigned total) {
+#include "splash_screen.h"
+
+void load_rom_to_xram(const char *name, unsigned xaddr, unsigned total) {
     int fd = open(name, O_RDONLY);
     if (fd < 0) return;
     const unsigned chunk = 16384;
@@ -3,4 +3,10 @@
 
 void show_splash_screen(void);
 
+/**
+ * Copy `total` bytes of a ROM asset (e.g. "ROM:title_screen.bin") into
+ * XRAM at xaddr; does nothing if the asset is missing
+ */
+void load_rom_to_xram(const char *name, unsigned xaddr, unsigned total);
+
 #endif // SPLASH_SCREEN_H
\ No newline at end of file
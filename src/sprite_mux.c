@@ -0,0 +1,231 @@
+/*
+ * sprite_mux.c - Shared hardware slots for the standard sprite list
+ *
+ * Each entity type used to own a fixed range of the Mode 4 list, sized for
+ * its own worst case, and parked its unused entries at y = -100. The
+ * entries now live in a RAM table; each flush packs the on-screen ones
+ * into the front of the hardware list. A slot is rewritten only when it
+ * gets a different entry or its entry changed, and back-to-back slots
+ * share one address load.
+ *
+ * Over budget, the cut is found without sorting: whole priority levels
+ * are taken while they fit, and the level that doesn't is split with a
+ * histogram of distances from the screen centre (32 pixel buckets).
+ */
+
+#include <rp6502.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "constants.h"
+#include "sprite_mux.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define SPRITE_BYTES    sizeof(vga_mode4_sprite_t)
+#define SLOT_NONE       0xFF    // Slot holds nothing the mux knows about
+#define DIST_SHIFT      5       // Distance bucket width: 32 pixels
+#define DIST_BUCKETS    16      // Covers the screen plus a 32x32 sprite
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static vga_mode4_sprite_t entries[SPRITE_MUX_MAX];
+static uint8_t priority[SPRITE_MUX_MAX];
+static uint8_t changed[SPRITE_MUX_MAX / 8];     // Entry written since the last flush
+static bool pick[SPRITE_MUX_MAX];               // Entry gets a slot this flush
+static uint8_t used = 0;                        // Entries in registered groups
+static bool any_changed = false;
+
+static unsigned slots_base = 0;                 // XRAM address of slot 0
+static uint8_t slots_plane = 0;
+static uint8_t slots_len = 0;                   // Length the plane was last given
+static uint8_t slot_src[SPRITE_SLOTS];          // Entry shown in each slot
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+/**
+ * Park slot 0 and show a one-entry list (the plane can't be empty)
+ */
+static void park_slot0(void)
+{
+    RIA.addr0 = slots_base + offsetof(vga_mode4_sprite_t, y_pos_px);
+    RIA.step0 = 1;
+    RIA.rw0 = (uint8_t)-100;
+    RIA.rw0 = 0xFF;
+    slot_src[0] = SLOT_NONE;
+}
+
+void sprite_mux_init(unsigned slots_addr, uint8_t plane)
+{
+    used = 0;
+    any_changed = false;
+    memset(changed, 0, sizeof(changed));
+    memset(slot_src, SLOT_NONE, sizeof(slot_src));
+
+    slots_base = slots_addr;
+    slots_plane = plane;
+    park_slot0();
+    slots_len = 1;
+    xregn(1, 0, 1, 5, 4, 0, slots_base, slots_len, slots_plane);
+}
+
+unsigned sprite_mux_group(uint8_t count, SpritePriority prio)
+{
+    if (count > SPRITE_MUX_MAX - used) {
+        printf("ERROR: sprite group of %u entries, only %u left\n", count, SPRITE_MUX_MAX - used);
+        count = SPRITE_MUX_MAX - used;
+    }
+    unsigned handle = SPRITE_MUX_HANDLES + used * SPRITE_BYTES;
+    for (uint8_t n = 0; n < count; n++, used++) {
+        entries[used].x_pos_px = -100;
+        entries[used].y_pos_px = -100;
+        priority[used] = prio;
+    }
+    return handle;
+}
+
+bool sprite_mux_owns(unsigned addr)
+{
+    return addr - SPRITE_MUX_HANDLES < used * SPRITE_BYTES;
+}
+
+void sprite_mux_set8(unsigned addr, uint8_t val)
+{
+    unsigned i = addr - SPRITE_MUX_HANDLES;
+    uint8_t *bytes = (uint8_t *)entries;
+    if (bytes[i] != val) {
+        bytes[i] = val;
+        uint8_t e = i / SPRITE_BYTES;
+        changed[e >> 3] |= 1 << (e & 7);
+        any_changed = true;
+    }
+}
+
+static bool entry_visible(const vga_mode4_sprite_t *s)
+{
+    int16_t size = 1 << s->log_size;
+    return s->y_pos_px > -size && s->y_pos_px < SCREEN_HEIGHT &&
+           s->x_pos_px > -size && s->x_pos_px < SCREEN_WIDTH;
+}
+
+/**
+ * Distance bucket of an on-screen entry (sprite centre to screen centre)
+ */
+static uint8_t centre_distance(const vga_mode4_sprite_t *s)
+{
+    int16_t half = (1 << s->log_size) >> 1;
+    int16_t dx = s->x_pos_px + half - SCREEN_WIDTH / 2;
+    int16_t dy = s->y_pos_px + half - SCREEN_HEIGHT / 2;
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    uint8_t bucket = (dx + dy) >> DIST_SHIFT;
+    return bucket < DIST_BUCKETS ? bucket : DIST_BUCKETS - 1;
+}
+
+/**
+ * More entries picked than slots: drop the lowest priorities, then the
+ * farthest entries of the level that straddles the budget
+ */
+static void trim_picks(const uint8_t *per_prio)
+{
+    uint8_t room = SPRITE_SLOTS;
+    uint8_t cut_prio = 0;
+    while (per_prio[cut_prio] <= room) {
+        room -= per_prio[cut_prio++];
+    }
+
+    uint8_t hist[DIST_BUCKETS];
+    memset(hist, 0, sizeof(hist));
+    for (uint8_t e = 0; e < used; e++) {
+        if (pick[e] && priority[e] == cut_prio) {
+            hist[centre_distance(&entries[e])]++;
+        }
+    }
+    uint8_t cut_dist = 0;
+    while (hist[cut_dist] <= room) {
+        room -= hist[cut_dist++];
+    }
+
+    // The cut bucket fills what's left in list order
+    for (uint8_t e = 0; e < used; e++) {
+        if (!pick[e] || priority[e] < cut_prio) {
+            continue;
+        }
+        if (priority[e] > cut_prio) {
+            pick[e] = false;
+            continue;
+        }
+        uint8_t d = centre_distance(&entries[e]);
+        if (d > cut_dist || (d == cut_dist && room == 0)) {
+            pick[e] = false;
+        } else if (d == cut_dist) {
+            room--;
+        }
+    }
+}
+
+void sprite_mux_flush(void)
+{
+    // The picks only depend on the entries, so nothing changed, nothing to do
+    if (!any_changed) {
+        return;
+    }
+
+    uint8_t per_prio[SPRITE_PRIO_COUNT] = {0};
+    uint8_t shown = 0;
+    for (uint8_t e = 0; e < used; e++) {
+        pick[e] = entry_visible(&entries[e]);
+        if (pick[e]) {
+            per_prio[priority[e]]++;
+            shown++;
+        }
+    }
+    if (shown > SPRITE_SLOTS) {
+        trim_picks(per_prio);
+    }
+
+    unsigned addr = 0;      // XRAM address RIA.addr0 has reached (0: unknown)
+    uint8_t len = 0;
+    RIA.step0 = 1;
+    for (uint8_t e = 0; e < used; e++) {
+        if (!pick[e]) {
+            continue;
+        }
+        if (slot_src[len] != e || (changed[e >> 3] & (1 << (e & 7)))) {
+            slot_src[len] = e;
+            unsigned slot = slots_base + len * SPRITE_BYTES;
+            if (addr != slot) {
+                RIA.addr0 = slot;
+            }
+            const uint8_t *bytes = (const uint8_t *)&entries[e];
+            for (uint8_t b = 0; b < SPRITE_BYTES; b++) {
+                RIA.rw0 = bytes[b];
+            }
+            addr = slot + SPRITE_BYTES;
+        }
+        len++;
+    }
+
+    // Slots past the end go stale; forget what they held
+    for (uint8_t k = len; k < slots_len; k++) {
+        slot_src[k] = SLOT_NONE;
+    }
+    if (len == 0) {
+        park_slot0();
+        len = 1;
+    }
+    if (len != slots_len) {
+        slots_len = len;
+        xregn(1, 0, 1, 5, 4, 0, slots_base, slots_len, slots_plane);
+    }
+
+    memset(changed, 0, sizeof(changed));
+    any_changed = false;
+}
@@ -0,0 +1,65 @@
+#ifndef SPRITE_MUX_H
+#define SPRITE_MUX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * sprite_mux.h - Shared hardware slots for the standard sprite list
+ *
+ * Fighters, bullets, asteroids, explosions and the rest each own a group
+ * of logical sprite entries, but the entries live in RAM only: a group's
+ * "config address" (FIGHTER_CONFIG, ...) is a handle into the mux table,
+ * written with sprite_struct_set() like any other config. At the flush
+ * the mux copies the entries that are on screen into the SPRITE_SLOTS
+ * hardware entries of the Mode 4 list, in group order, and gives the
+ * plane a new length only when the count changes.
+ *
+ * A group's size therefore costs RAM, not XRAM. When more entries are on
+ * screen than there are slots, higher-priority groups go first, then the
+ * entries nearest the screen centre; the rest are not drawn that frame
+ * but their objects keep running.
+ */
+
+#define SPRITE_SLOTS        64      // Hardware entries in the Mode 4 list
+#define SPRITE_MUX_MAX      128     // Logical entries across all groups
+
+// Handles are offsets into the mux table from here. They share numbers
+// with the bitmap's XRAM but are never written to XRAM.
+#define SPRITE_MUX_HANDLES  0x0000
+
+typedef enum {
+    SPRITE_PRIO_HIGH = 0,       // Bullets and pickups: always worth a slot
+    SPRITE_PRIO_NORMAL,         // Fighters and asteroids
+    SPRITE_PRIO_LOW,            // Explosions
+    SPRITE_PRIO_COUNT
+} SpritePriority;
+
+/**
+ * Forget every group and give the plane a one-entry list of
+ * SPRITE_SLOTS slots at slots_addr; call before sprite_mux_group()
+ */
+void sprite_mux_init(unsigned slots_addr, uint8_t plane);
+
+/**
+ * Add a group of `count` entries; returns the handle of its first entry
+ * (entry i is at handle + i * sizeof(vga_mode4_sprite_t))
+ */
+unsigned sprite_mux_group(uint8_t count, SpritePriority priority);
+
+/**
+ * True if addr is a handle of a registered entry
+ */
+bool sprite_mux_owns(unsigned addr);
+
+/**
+ * Write one byte of an entry (through sprite_struct_set())
+ */
+void sprite_mux_set8(unsigned addr, uint8_t val);
+
+/**
+ * Refill the hardware slots; called by sprite_shadow_flush()
+ */
+void sprite_mux_flush(void);
+
+#endif // SPRITE_MUX_H
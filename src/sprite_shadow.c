@@ -0,0 +1,141 @@
+/*
+ * sprite_shadow.c - Buffered sprite config writes
+ *
+ * Every xram0_struct_set() reloads RIA.addr0, and the game used to
+ * rewrite unchanged positions every frame from half a dozen modules.
+ * Writes now land in a RAM shadow of the sprite config block; a byte is
+ * only marked dirty when its value changes, and the flush streams the
+ * dirty runs through the auto-incrementing portal in one pass, so the
+ * whole sprite list changes together right after vsync.
+ *
+ * Writes to the standard sprite list go to the sprite multiplexer
+ * (sprite_mux.h) instead: its entries have handles, not XRAM addresses,
+ * and it picks which of them fill the list's hardware slots.
+ */
+
+#include <rp6502.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "sprite_shadow.h"
+#include "sprite_mux.h"
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+// Clean bytes bridged inside a run; rewriting them is cheaper than a new addr0
+#define RUN_GAP 2
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static uint8_t shadow[SPRITE_SHADOW_MAX];
+static uint8_t dirty[SPRITE_SHADOW_MAX / 8];
+static unsigned shadow_base = 0;
+static unsigned shadow_size = 0;
+static bool any_dirty = false;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+static bool is_dirty(unsigned i)
+{
+    return dirty[i >> 3] & (1 << (i & 7));
+}
+
+void sprite_shadow_init(unsigned base, unsigned size)
+{
+    if (size > SPRITE_SHADOW_MAX) {
+        printf("ERROR: sprite configs need %u bytes, shadow holds %u\n", size, SPRITE_SHADOW_MAX);
+        size = SPRITE_SHADOW_MAX;
+    }
+    shadow_base = base;
+    shadow_size = size;
+
+    RIA.addr0 = base;
+    RIA.step0 = 1;
+    for (unsigned i = 0; i < size; i++) {
+        shadow[i] = RIA.rw0;
+    }
+    memset(dirty, 0, sizeof(dirty));
+    any_dirty = false;
+}
+
+void sprite_shadow_set8(unsigned addr, uint8_t val)
+{
+    unsigned i = addr - shadow_base;
+    if (i >= shadow_size) {
+        if (sprite_mux_owns(addr)) {
+            sprite_mux_set8(addr, val);
+            return;
+        }
+        // Outside the shadowed block: write straight through
+        RIA.addr0 = addr;
+        RIA.rw0 = val;
+        return;
+    }
+    if (shadow[i] != val) {
+        shadow[i] = val;
+        dirty[i >> 3] |= 1 << (i & 7);
+        any_dirty = true;
+    }
+}
+
+void sprite_shadow_set16(unsigned addr, uint16_t val)
+{
+    sprite_shadow_set8(addr, val & 0xFF);
+    sprite_shadow_set8(addr + 1, val >> 8);
+}
+
+/**
+ * Stream the dirty bytes of shadow[i, end) to the same offsets in XRAM
+ */
+static void flush_runs(unsigned i, unsigned end)
+{
+    while (i < end) {
+        if (dirty[i >> 3] == 0) {
+            i = (i | 7) + 1;    // Skip 8 clean bytes at once
+            continue;
+        }
+        if (!is_dirty(i)) {
+            i++;
+            continue;
+        }
+
+        // Start of a run: one address load, then stream
+        RIA.addr0 = shadow_base + i;
+        while (i < end) {
+            RIA.rw0 = shadow[i++];
+            if (i < end && !is_dirty(i)) {
+                unsigned next = i + 1;
+                while (next < end && next <= i + RUN_GAP && !is_dirty(next)) {
+                    next++;
+                }
+                if (next >= end || next > i + RUN_GAP) {
+                    break;
+                }
+                while (i < next) {
+                    RIA.rw0 = shadow[i++];
+                }
+            }
+        }
+    }
+}
+
+void sprite_shadow_flush(void)
+{
+    sprite_mux_flush();
+    if (!any_dirty) {
+        return;
+    }
+
+    RIA.step0 = 1;
+    flush_runs(0, shadow_size);
+
+    memset(dirty, 0, sizeof(dirty));
+    any_dirty = false;
+}
@@ -0,0 +1,42 @@
+#ifndef SPRITE_SHADOW_H
+#define SPRITE_SHADOW_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// RAM copy of the sprite config block (SPACECRAFT_CONFIG up to the standard
+// sprite list, which belongs to sprite_mux.h). Game code writes sprite
+// fields here with sprite_struct_set(); only bytes that actually change are
+// marked dirty, and sprite_shadow_flush() streams the dirty runs to XRAM
+// once per frame right after vsync.
+#define SPRITE_SHADOW_MAX 128   // Bytes; the block is 68 bytes today
+
+/**
+ * Capture the sprite config block from XRAM (call once init_graphics()
+ * has written every config)
+ */
+void sprite_shadow_init(unsigned base, unsigned size);
+
+/**
+ * Write one byte / one little-endian word of a config at XRAM address addr
+ * (or at a sprite_mux handle)
+ */
+void sprite_shadow_set8(unsigned addr, uint8_t val);
+void sprite_shadow_set16(unsigned addr, uint16_t val);
+
+/**
+ * Copy every changed byte to XRAM, one RIA.addr0 load per contiguous run,
+ * after letting the sprite multiplexer refill its slots
+ */
+void sprite_shadow_flush(void);
+
+// Drop-in for xram0_struct_set() on sprite configs; buffered until the flush
+#define sprite_struct_set(addr, type, member, val)                                     \
+    do {                                                                               \
+        if (sizeof(((type *)0)->member) == 1)                                          \
+            sprite_shadow_set8((unsigned)(addr) + offsetof(type, member), (uint8_t)(val)); \
+        else                                                                           \
+            sprite_shadow_set16((unsigned)(addr) + offsetof(type, member), (uint16_t)(val)); \
+    } while (0)
+
+#endif // SPRITE_SHADOW_H
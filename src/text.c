@@ -2,7 +2,7 @@
 #include <rp6502.h>
 #include <stdint.h>
 
-#include "graphics.h"
+#include "raster.h"
 
 /**
  * Draw a simple character at position (x, y)
@@ -62,14 +62,7 @@ void draw_char(int16_t x, int16_t y, char c, uint8_t color)
     }
     
     if (idx >= 0 && idx < 36) {
-        for (int row = 0; row < 5; row++) {
-            uint8_t pattern = font[idx][row];
-            for (int col = 0; col < 3; col++) {
-                if (pattern & (1 << (2 - col))) {
-                    set(x + col, y + row, color);
-                }
-            }
-        }
+        raster_glyph(x, y, font[idx], 3, 5, color);
     }
 }
 
@@ -95,9 +88,5 @@ void draw_text(int16_t x, int16_t y, const char* text, uint8_t color)
  */
 void clear_rect(int16_t x, int16_t y, int16_t width, int16_t height)
 {
-    for (int16_t dy = 0; dy < height; dy++) {
-        for (int16_t dx = 0; dx < width; dx++) {
-            set(x + dx, y + dy, 0x00);
-        }
-    }
+    raster_fill_rect(x, y, width, height, 0x00);
 }
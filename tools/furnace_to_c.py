@@ -2,8 +2,14 @@
 """
 Furnace Tracker Text Export to C Music Data Converter
 Converts Furnace .txt export to C arrays for RP6502 PSG playback
+
+  furnace_to_c.py <furnace_text_file> [channel_number]
+      One channel as a {frequency, duration, volume} note table
+  furnace_to_c.py --songs <out.h> <name>=<furnace_text_file> ...
+      Whole songs as music.c event streams (see music.h for the format)
 """
 
+import os
 import re
 import sys
 
@@ -154,10 +160,218 @@ def generate_c_code(sequence, var_name="title_music"):
     print()
     print(f"#define {var_name.upper()}_LENGTH {len(sequence)}")
 
+# ============================================================================
+# Event streams for music.c
+# ============================================================================
+
+MUSIC_VOICES = 4            # Tracker channels 0-3 are music voices 0-3
+GATE_LEN_MAX = 255          # Rows; longer notes are cut off
+
+# Stream opcodes (must match music.c)
+OP_NOTE, OP_TRIG, OP_LEN, OP_PATCH, OP_OFF = range(5)
+OP_WAIT = 0x40
+OP_CALL = 0x41
+OP_RET = 0x42
+OP_JUMP = 0x43
+OP_WAIT_SHORT = 0x80
+WAIT_SHORT_MAX = 128
+
+# Tracker instrument -> PSG registers (duty, vol_attack, vol_decay, wave_release)
+INSTRUMENT_PATCHES = {
+    0: (64, 0x01, 0xA2, 0x33),     # Tone: triangle, loud sustain, fast release
+    1: (128, 0x00, 0xF7, 0x30),    # Kick: triangle thump, decays to silence
+    2: (255, 0x40, 0xF2, 0x42),    # Hi-hat: short noise burst
+}
+
+def parse_orders(filename):
+    """Rows of every order: [order][row][voice] = (note, instrument) or None"""
+    with open(filename, 'r') as f:
+        lines = f.readlines()
+
+    orders = []
+    for line in lines:
+        if re.match(r'----- ORDER ', line):
+            orders.append([])
+            continue
+        row_match = re.match(r'([0-9A-F]{2}) \|(.+)', line)
+        if not row_match or not orders:
+            continue
+        row = int(row_match.group(1), 16)
+        cells = [c.strip().split() for c in row_match.group(2).rstrip('|\n').split('|')]
+        voices = []
+        for parts in cells[:MUSIC_VOICES]:
+            note = parts[0] if parts else '...'
+            if note == '...' or note not in NOTE_FREQ:
+                voices.append(None)
+                continue
+            inst = int(parts[1], 16) if len(parts) > 1 and parts[1] != '..' else None
+            voices.append((note, inst))
+        voices += [None] * (MUSIC_VOICES - len(voices))
+        rows = orders[-1]
+        while len(rows) < row:
+            rows.append([None] * MUSIC_VOICES)
+        rows.append(voices)
+    return orders
+
+def varint(n):
+    """LEB128: 7 bits per byte, low bits first"""
+    out = []
+    while True:
+        b = n & 0x7F
+        n >>= 7
+        out.append(b | (0x80 if n else 0))
+        if not n:
+            return out
+
+def wait_bytes(rows):
+    if rows <= WAIT_SHORT_MAX:
+        return [OP_WAIT_SHORT + rows - 1]
+    return [OP_WAIT] + varint(rows)
+
+def gate_lengths(orders):
+    """Rows each note holds its gate: up to the voice's next note or OFF,
+    wrapping past the end of the song (it loops)"""
+    flat = [row for rows in orders for row in rows]
+    total = len(flat)
+    lengths = {}
+    for v in range(MUSIC_VOICES):
+        hits = [r for r in range(total) if flat[r][v]]
+        for k, r in enumerate(hits):
+            nxt = hits[k + 1] if k + 1 < len(hits) else hits[0] + total
+            length = nxt - r
+            if length > GATE_LEN_MAX:
+                print(f"Warning: row {r} voice {v}: {length} row note cut to {GATE_LEN_MAX}",
+                      file=sys.stderr)
+                length = GATE_LEN_MAX
+            lengths[(r, v)] = length
+    return lengths
+
+def compile_song(orders):
+    """Event stream and frequency table of a song. Each order becomes a
+    block; a block whose bytes come up again is kept once and CALLed.
+    Events only carry what changed since the voice's last note, so the
+    bytes of a block depend on the state it starts from; sharing two equal
+    blocks is still exact, since each was encoded against its real state."""
+    lengths = gate_lengths(orders)
+    freqs = []
+    state = [{'freq': None, 'len': None, 'patch': None} for _ in range(MUSIC_VOICES)]
+
+    blocks = []
+    row_base = 0
+    for rows in orders:
+        code = []
+        idle = 0
+        for r, voices in enumerate(rows):
+            events = []
+            for v, cell in enumerate(voices):
+                if not cell:
+                    continue
+                note, inst = cell
+                st = state[v]
+                if note == 'OFF':
+                    events.append((OP_OFF << 2) | v)
+                    st['freq'] = None
+                    continue
+                patch = INSTRUMENT_PATCHES.get(inst if inst is not None else 0)
+                if patch is None:
+                    sys.exit(f"Error: instrument {inst:02X} has no PSG patch")
+                if patch != st['patch']:
+                    events += [(OP_PATCH << 2) | v, *patch]
+                    st['patch'] = patch
+                length = lengths[(row_base + r, v)]
+                if length != st['len']:
+                    events += [(OP_LEN << 2) | v, length]
+                    st['len'] = length
+                word = NOTE_FREQ[note] * 3
+                if word == st['freq']:
+                    events.append((OP_TRIG << 2) | v)
+                else:
+                    if word not in freqs:
+                        freqs.append(word)
+                    events += [(OP_NOTE << 2) | v, freqs.index(word)]
+                    st['freq'] = word
+            if events:
+                if idle:
+                    code += wait_bytes(idle)
+                code += events
+                idle = 0
+            idle += 1
+        code += wait_bytes(idle)
+        blocks.append(code)
+        row_base += len(rows)
+
+    if len(freqs) > 256:
+        sys.exit("Error: more than 256 distinct notes")
+
+    # Main line first, shared blocks after it
+    shared = [b for b in blocks if blocks.count(b) > 1]
+    main_len = sum(3 if b in shared else len(b) for b in blocks) + 3
+    offsets = {}
+    tail = []
+    for b in shared:
+        key = bytes(b)
+        if key not in offsets:
+            offsets[key] = main_len + len(tail)
+            tail += b + [OP_RET]
+    code = []
+    for b in blocks:
+        if b in shared:
+            off = offsets[bytes(b)]
+            code += [OP_CALL, off & 0xFF, off >> 8]
+        else:
+            code += b
+    code += [OP_JUMP, 0, 0]
+    return code + tail, freqs
+
+def generate_songs_header(songs, out_path):
+    """Write songs [(name, source, code, freqs)] as a C header"""
+    lines = ["// Generated by tools/furnace_to_c.py from music/*.txt - do not edit",
+             "#ifndef MUSIC_SONGS_H", "#define MUSIC_SONGS_H", "",
+             "#include <stdint.h>", '#include "music.h"', ""]
+    for name, src, code, freqs in songs:
+        lines.append(f"// {os.path.basename(src)}: {len(code)} bytes of events, {len(freqs)} notes")
+        lines.append(f"static const uint16_t {name}_freqs[] = {{")
+        for i in range(0, len(freqs), 8):
+            lines.append("    " + ", ".join(f"0x{w:04X}" for w in freqs[i:i + 8]) + ",")
+        lines.append("};")
+        lines.append(f"static const uint8_t {name}_events[] = {{")
+        for i in range(0, len(code), 12):
+            lines.append("    " + ", ".join(f"0x{b:02X}" for b in code[i:i + 12]) + ",")
+        lines.append("};")
+        lines.append(f"static const MusicSong SONG_{name.upper()} = {{ {name}_freqs, {name}_events }};")
+        lines.append("")
+    lines.append("#endif // MUSIC_SONGS_H")
+    with open(out_path, 'w') as f:
+        f.write("\n".join(lines) + "\n")
+
+def compile_songs(out_path, specs):
+    songs = []
+    for spec in specs:
+        name, _, src = spec.partition('=')
+        if not src:
+            sys.exit(f"Error: expected name=file, got {spec}")
+        orders = parse_orders(src)
+        if not orders:
+            sys.exit(f"Error: no pattern data in {src}")
+        code, freqs = compile_song(orders)
+        rows = sum(len(o) for o in orders)
+        print(f"{name}: {rows} rows, {len(code)} bytes of events + {2 * len(freqs)} bytes of notes",
+              file=sys.stderr)
+        songs.append((name, src, code, freqs))
+    generate_songs_header(songs, out_path)
+
 if __name__ == '__main__':
+    if len(sys.argv) > 1 and sys.argv[1] == '--songs':
+        if len(sys.argv) < 4:
+            print("Usage: furnace_to_c.py --songs <out.h> <name>=<furnace_text_file> ...")
+            sys.exit(1)
+        compile_songs(sys.argv[2], sys.argv[3:])
+        sys.exit(0)
+
     if len(sys.argv) < 2:
         print("Usage: furnace_to_c.py <furnace_text_file> [channel_number]")
         print("  channel_number: which channel to extract (default: 2)")
+        print("       furnace_to_c.py --songs <out.h> <name>=<furnace_text_file> ...")
         sys.exit(1)
     
     filename = sys.argv[1]
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Direction Quantizer Table Generator
+Reads sin_fix/cos_fix from src/definitions.h and writes src/direction_table.h,
+the octant-folded sector boundaries used by direction_from_vector()
+
+Usage: python3 tools/gen_direction_table.py [definitions.h] [direction_table.h]
+"""
+
+import math
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_IN = os.path.join(ROOT, 'src', 'definitions.h')
+DEFAULT_OUT = os.path.join(ROOT, 'src', 'direction_table.h')
+
+def read_table(text, name):
+    """Extract the integer initializer of `const int16_t name[] = {...};`"""
+    m = re.search(r'const\s+int16_t\s+' + name + r'\s*\[\s*\]\s*=\s*\{([^}]*)\}', text)
+    if not m:
+        sys.exit(f"Error: {name} not found")
+    return [int(v) for v in re.findall(r'-?\d+', m.group(1))]
+
+def main():
+    src = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_IN
+    dst = sys.argv[2] if len(sys.argv) > 2 else DEFAULT_OUT
+
+    with open(src, 'r') as f:
+        text = f.read()
+    sin_fix = read_table(text, 'sin_fix')
+    cos_fix = read_table(text, 'cos_fix')
+
+    steps = len(sin_fix) - 1        # Last entry repeats the first
+    if steps % 8 != 0 or len(cos_fix) != len(sin_fix):
+        sys.exit("Error: need a multiple of 8 rotation steps")
+    per_octant = steps // 8
+
+    # Folding only works if the table has the symmetry of the square
+    q = steps // 4
+    for j in range(steps):
+        if (cos_fix[j] != sin_fix[(q - j) % steps] or
+                cos_fix[j] != cos_fix[(steps - j) % steps] or
+                sin_fix[j] != -sin_fix[(steps - j) % steps]):
+            sys.exit(f"Error: sin_fix/cos_fix not symmetric at step {j}")
+
+    # Boundary k splits octant sectors k and k+1 where the dot products tie:
+    #   u * (cos[k] - cos[k+1]) == w * (sin[k+1] - sin[k])
+    # stored as a reduced ratio w/u = num/den
+    bounds = []
+    for k in range(per_octant):
+        num = cos_fix[k] - cos_fix[k + 1]
+        den = sin_fix[k + 1] - sin_fix[k]
+        if den <= 0 or num <= 0 or num > 255 or den > 255:
+            sys.exit(f"Error: bad boundary {k}")
+        g = math.gcd(num, den)
+        bounds.append((num // g, den // g))
+
+    # Sectors must come in angle order, otherwise argmax is not a simple sweep
+    for a, b in zip(bounds, bounds[1:]):
+        if a[0] * b[1] >= b[0] * a[1]:
+            sys.exit("Error: boundaries not increasing")
+    # ...and the last one must sit below the 45 degree fold
+    if bounds[-1][0] >= bounds[-1][1]:
+        sys.exit("Error: last boundary past the diagonal")
+
+    with open(dst, 'w') as f:
+        f.write("// Generated by tools/gen_direction_table.py from sin_fix/cos_fix - do not edit\n")
+        f.write("#ifndef DIRECTION_TABLE_H\n#define DIRECTION_TABLE_H\n\n")
+        f.write("#include <stdint.h>\n\n")
+        f.write(f"#define DIR_OCTANT_STEPS {per_octant}\n\n")
+        f.write("// Sector boundaries inside the first octant (0 <= w <= u): the vector\n")
+        f.write("// is past boundary k when w * dir_bound_den[k] > u * dir_bound_num[k]\n")
+        nums = ', '.join(str(n) for n, _ in bounds)
+        dens = ', '.join(str(d) for _, d in bounds)
+        f.write(f"static const uint8_t dir_bound_num[DIR_OCTANT_STEPS] = {{ {nums} }};\n")
+        f.write(f"static const uint8_t dir_bound_den[DIR_OCTANT_STEPS] = {{ {dens} }};\n\n")
+        f.write("#endif // DIRECTION_TABLE_H\n")
+
+    print(f"Wrote {dst}: {per_octant} boundaries per octant {bounds}")
+
+if __name__ == '__main__':
+    main()
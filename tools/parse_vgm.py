@@ -1,42 +1,90 @@
 #!/usr/bin/env python3
 """
-VGM to C Array Converter
-Extracts note data from VGM file and converts to PSG-compatible format
+VGM to PSG Register Log Converter
+Turns the YM2612 part of a VGM file into a frame-timed log of RP6502 PSG
+register writes, which music_stream.c plays from storage
+
+Usage: parse_vgm.py <vgm_file> <out.psg> [--wave CH=WAVE ...]
+
+  CH is a YM2612 channel (0-5); WAVE is sine, square, sawtooth, triangle
+  or noise. Each FM channel plays on its own PSG channel with that
+  waveform; key on/off becomes the gate, F-number/block the frequency and
+  the loudest carrier's total level the volume. DAC samples are dropped.
+
+Log format (little-endian):
+
+  "RPSG"  magic
+  u8      version (1)
+  u8      channels used
+  u16     reserved
+  u32     file offset of the loop point (0: no loop)
+  events:
+    0x00-0x3F  (channel << 3) | register, then the value
+    0x40       wait n frames, n a varint (7 bits a byte, low first)
+    0x80-0xFF  wait 1-128 frames
 """
 
 import struct
 import sys
 
+SAMPLES_PER_FRAME = 735     # 44100 Hz / 60 Hz
+FM_CHANNELS = 6
+LOG_VERSION = 1
+
+OP_WAIT = 0x40
+OP_WAIT_SHORT = 0x80
+WAIT_SHORT_MAX = 128
+
+# PSG registers (see psg.h)
+REG_FREQ = 0
+REG_DUTY = 2
+REG_VOL_ATTACK = 3
+REG_VOL_DECAY = 4
+REG_WAVE_RELEASE = 5
+REG_PAN_GATE = 6
+
+WAVES = {'sine': 0, 'square': 1, 'sawtooth': 2, 'triangle': 3, 'noise': 4}
+
+# Title_music.vgm: kick, snare, hi-hat, then three melodic parts
+DEFAULT_WAVES = ['triangle', 'noise', 'noise', 'sawtooth', 'square', 'square']
+
+# Carrier operators of each FM algorithm, as TL register slots (0x40 + 4 * slot)
+# Slot order in the register map is op1, op3, op2, op4
+ALGO_CARRIERS = [
+    [3], [3], [3], [3], [2, 3], [1, 2, 3], [1, 2, 3], [0, 1, 2, 3],
+]
+
 def parse_vgm(filename):
+    """YM2612 register writes as [(sample, port, reg, val)], total samples
+    and the loop point in samples (None without a loop)"""
     with open(filename, 'rb') as f:
         data = f.read()
-    
-    # Parse header
+
+    if data[0:4] != b'Vgm ':
+        sys.exit(f"Error: {filename} is not a VGM file")
+
     version = struct.unpack('<I', data[0x08:0x0C])[0]
     total_samples = struct.unpack('<I', data[0x18:0x1C])[0]
     loop_offset = struct.unpack('<I', data[0x1C:0x20])[0]
-    
+    loop_samples = struct.unpack('<I', data[0x20:0x24])[0]
+
     if version >= 0x150:
         vgm_data_offset = struct.unpack('<I', data[0x34:0x38])[0] + 0x34
     else:
         vgm_data_offset = 0x40
-    
-    print(f"// VGM: {total_samples/44100:.2f} seconds, loop at {loop_offset:#x}")
-    
+
+    print(f"VGM: {total_samples / 44100:.2f} seconds, loop at {loop_offset:#x}", file=sys.stderr)
+
     pos = vgm_data_offset
-    notes = []
+    writes = []
     current_time = 0
-    
-    # Channel state tracking
-    channels = [{'freq': 0, 'vol': 15, 'on': False} for _ in range(8)]
-    
+
     while pos < len(data):
         cmd = data[pos]
-        
+
         # Wait commands
         if cmd == 0x61:  # Wait n samples
-            wait = struct.unpack('<H', data[pos+1:pos+3])[0]
-            current_time += wait
+            current_time += struct.unpack('<H', data[pos+1:pos+3])[0]
             pos += 3
         elif cmd == 0x62:  # Wait 735 samples (1/60 sec)
             current_time += 735
@@ -44,64 +92,224 @@ def parse_vgm(filename):
         elif cmd == 0x63:  # Wait 882 samples (1/50 sec)
             current_time += 882
             pos += 1
-        elif cmd >= 0x70 and cmd <= 0x7F:  # Wait 1-16 samples
+        elif 0x70 <= cmd <= 0x7F:  # Wait 1-16 samples
             current_time += (cmd & 0x0F) + 1
             pos += 1
-        
-        # YM2610 commands
-        elif cmd == 0x52:  # YM2610 port 0
-            reg = data[pos+1]
-            val = data[pos+2]
-            pos += 3
-            
-        elif cmd == 0x53:  # YM2610 port 1
-            reg = data[pos+1]
-            val = data[pos+2]
+        elif 0x80 <= cmd <= 0x8F:  # YM2612 DAC write, then wait 0-15 samples
+            current_time += cmd & 0x0F
+            pos += 1
+
+        # YM2612 commands
+        elif cmd in (0x52, 0x53):
+            writes.append((current_time, cmd - 0x52, data[pos+1], data[pos+2]))
             pos += 3
-            
-        # YM2612 commands  
-        elif cmd == 0x52 or cmd == 0x53:
+
+        # Data blocks and DAC stream control
+        elif cmd == 0x67:
+            pos += 7 + struct.unpack('<I', data[pos+3:pos+7])[0]
+        elif cmd in (0x90, 0x91, 0x95, 0xE0):
+            pos += 5
+        elif cmd == 0x92:
+            pos += 6
+        elif cmd == 0x93:
+            pos += 11
+        elif cmd == 0x94:
+            pos += 2
+
+        # Other chips: skip by command length
+        elif cmd == 0x4F or cmd == 0x50 or 0x30 <= cmd <= 0x3F:
+            pos += 2
+        elif 0x40 <= cmd <= 0x4E or 0x51 <= cmd <= 0x5F or 0xA0 <= cmd <= 0xBF:
             pos += 3
-            
-        # Other chip commands
-        elif cmd in [0x90, 0x91, 0x92, 0x93, 0x94, 0x95]:
+        elif 0xC0 <= cmd <= 0xDF:
+            pos += 4
+        elif 0xE1 <= cmd <= 0xFF:
             pos += 5
-            
+
         # End of data
         elif cmd == 0x66:
             break
-            
         else:
-            pos += 1
-    
-    return notes
-
-def extract_simple_melody(filename):
-    """Extract a simplified melody for PSG playback"""
-    
-    # For now, create a simple example melody
-    # This would need proper VGM command parsing for your specific chip
-    
-    print("// Simple melody extracted (placeholder)")
-    print("// TODO: Parse actual YM2610 commands to extract note data")
-    print()
-    print("typedef struct {")
-    print("    uint16_t frequency;  // Hz")
-    print("    uint8_t duration;    // frames (60 Hz)")
-    print("    uint8_t volume;      // 0-15")
-    print("} music_note_t;")
-    print()
-    print("static const music_note_t title_music[] = {")
-    print("    // Format: {frequency, duration, volume}")
-    print("    {440, 30, 12},  // A4 for 0.5 sec")
-    print("    {494, 30, 12},  // B4")
-    print("    {523, 30, 12},  // C5")
-    print("    {0, 0, 0}       // End marker")
-    print("};")
+            sys.exit(f"Error: unknown VGM command {cmd:#04x} at {pos:#x}")
 
-if __name__ == '__main__':
-    if len(sys.argv) < 2:
-        print("Usage: parse_vgm.py <vgm_file>")
+    loop_at = total_samples - loop_samples if loop_offset else None
+    return writes, current_time, loop_at
+
+class FmChannel:
+    def __init__(self):
+        self.fnum = 0
+        self.block = 0
+        self.algo = 0
+        self.tl = [127] * 4
+        self.key = False
+
+    def hz(self, clock):
+        return self.fnum * clock * (1 << self.block) / (144 * (1 << 21))
+
+    def volume(self):
+        """PSG volume (0 loudest, 15 silent): 3 dB per step, TL is 0.75 dB"""
+        tl = min(self.tl[s] for s in ALGO_CARRIERS[self.algo])
+        return min(15, tl // 4)
+
+def fm_channel(port, reg):
+    """YM2612 channel of a per-channel register, or None"""
+    c = reg & 3
+    if c == 3:
+        return None
+    return c + 3 * port
+
+def render_frames(writes, total_samples, waves, clock):
+    """PSG register writes per frame: [[(channel, reg, val), ...], ...]"""
+    frames = [[] for _ in range(total_samples // SAMPLES_PER_FRAME + 1)]
+    fm = [FmChannel() for _ in range(FM_CHANNELS)]
+    psg = [[None] * 8 for _ in range(FM_CHANNELS)]
+
+    def put(frame, ch, reg, val):
+        if reg == REG_PAN_GATE or psg[ch][reg] != val:
+            psg[ch][reg] = val
+            frames[frame].append((ch, reg, val))
+
+    def sync(frame, ch):
+        """Frequency and volume of an FM channel onto its PSG channel"""
+        f = fm[ch]
+        word = min(0xFFFF, int(round(f.hz(clock) * 3)))
+        put(frame, ch, REG_FREQ, word & 0xFF)
+        put(frame, ch, REG_FREQ + 1, word >> 8)
+        vol = f.volume()
+        put(frame, ch, REG_VOL_ATTACK, vol << 4)        # Instant attack
+        put(frame, ch, REG_VOL_DECAY, vol << 4)         # Sustain at the same level
+
+    # Patches that don't change: duty and waveform/release
+    for ch in range(FM_CHANNELS):
+        wave = waves[ch]
+        release = 1 if wave == WAVES['noise'] else 3
+        put(0, ch, REG_DUTY, 128)
+        put(0, ch, REG_WAVE_RELEASE, (wave << 4) | release)
+
+    for sample, port, reg, val in writes:
+        frame = int(round(sample / SAMPLES_PER_FRAME))
+        frame = min(frame, len(frames) - 1)
+
+        if port == 0 and reg == 0x28:
+            c = val & 7
+            ch = (c & 3) + (3 if c & 4 else 0)
+            if (c & 3) == 3 or ch >= FM_CHANNELS:
+                continue
+            on = (val >> 4) != 0
+            if on:
+                sync(frame, ch)
+            if on != fm[ch].key or on:
+                put(frame, ch, REG_PAN_GATE, 0x01 if on else 0x00)
+            fm[ch].key = on
+            continue
+
+        if reg < 0x30:
+            continue
+        ch = fm_channel(port, reg)
+        if ch is None:
+            continue
+        f = fm[ch]
+        if 0x40 <= reg < 0x50:
+            f.tl[(reg - 0x40) >> 2] = val & 0x7F
+        elif 0xA0 <= reg < 0xA4:
+            f.fnum = (f.fnum & 0x700) | val
+        elif 0xA4 <= reg < 0xA8:
+            f.fnum = (f.fnum & 0xFF) | ((val & 7) << 8)
+            f.block = (val >> 3) & 7
+        elif 0xB0 <= reg < 0xB4:
+            f.algo = val & 7
+        else:
+            continue
+        if f.key:
+            sync(frame, ch)
+
+    # A gate written more than once in a frame keeps its last off -> on edge
+    for events in frames:
+        gates = {}
+        for i, (ch, reg, val) in enumerate(events):
+            if reg == REG_PAN_GATE:
+                gates.setdefault(ch, []).append(i)
+        drop = set()
+        for ch, idx in gates.items():
+            vals = [events[i][2] for i in idx]
+            keep = idx[-1:]
+            if vals[-1] and 0 in vals[:-1]:
+                keep = [idx[vals[:-1].index(0)], idx[-1]]
+            drop.update(i for i in idx if i not in keep)
+        events[:] = [e for i, e in enumerate(events) if i not in drop]
+    return frames
+
+def varint(n):
+    out = []
+    while True:
+        b = n & 0x7F
+        n >>= 7
+        out.append(b | (0x80 if n else 0))
+        if not n:
+            return out
+
+def wait_bytes(frames):
+    if frames <= WAIT_SHORT_MAX:
+        return [OP_WAIT_SHORT + frames - 1]
+    return [OP_WAIT] + varint(frames)
+
+def encode_log(frames, loop_frame):
+    """Header + events; the loop offset points at the first event of the
+    loop frame, so waits are split there"""
+    body = []
+    loop_offset = 0
+    idle = 0
+    for f, events in enumerate(frames):
+        if f == loop_frame:
+            if idle:
+                body += wait_bytes(idle)
+                idle = 0
+            loop_offset = 12 + len(body)
+        if events:
+            if idle:
+                body += wait_bytes(idle)
+            for ch, reg, val in events:
+                body += [(ch << 3) | reg, val]
+            idle = 0
+        idle += 1
+    body += wait_bytes(idle)
+
+    used = max((ch for events in frames for ch, _, _ in events), default=-1) + 1
+    header = b'RPSG' + struct.pack('<BBHI', LOG_VERSION, used, 0, loop_offset)
+    return header + bytes(body)
+
+def main():
+    args = sys.argv[1:]
+    if len(args) < 2:
+        print("Usage: parse_vgm.py <vgm_file> <out.psg> [--wave CH=WAVE ...]")
         sys.exit(1)
-    
-    extract_simple_melody(sys.argv[1])
+
+    waves = [WAVES[w] for w in DEFAULT_WAVES]
+    rest = args[2:]
+    while rest:
+        if rest[0] != '--wave' or len(rest) < 2:
+            sys.exit(f"Error: unexpected argument {rest[0]}")
+        ch, _, name = rest[1].partition('=')
+        if name not in WAVES or not ch.isdigit() or int(ch) >= FM_CHANNELS:
+            sys.exit(f"Error: bad --wave {rest[1]}")
+        waves[int(ch)] = WAVES[name]
+        rest = rest[2:]
+
+    with open(args[0], 'rb') as f:
+        clock = struct.unpack('<I', f.read(0x30)[0x2C:0x30])[0] & 0x3FFFFFFF
+    if not clock:
+        sys.exit("Error: no YM2612 in this VGM")
+
+    writes, total, loop_at = parse_vgm(args[0])
+    frames = render_frames(writes, total, waves, clock)
+    loop_frame = int(round(loop_at / SAMPLES_PER_FRAME)) if loop_at is not None else None
+    log = encode_log(frames, loop_frame)
+
+    with open(args[1], 'wb') as f:
+        f.write(log)
+    count = sum(len(e) for e in frames)
+    print(f"{args[1]}: {len(frames)} frames, {count} register writes, {len(log)} bytes",
+          file=sys.stderr)
+
+if __name__ == '__main__':
+    main()